@@ -9,17 +9,19 @@
 #define CHAR_GRASS '3'
 #define CHAR_STONE '4'
 
-// Modified function to load chunks from an ASCII map file
-char* loadASCIIMap(const char* filename);
+// Map character for each terrain type; anything unrecognised is grass.
+// Maps are streamed chunk by chunk through map_stream.h.
+static inline TerrainType charToTerrain(char c) {
+    switch(c) {
+        case CHAR_WATER: return (TerrainType)TERRAIN_WATER; // e.g. '0' or '~'
+        case CHAR_SAND:  return (TerrainType)TERRAIN_SAND;  // e.g. '.'
+        case CHAR_GRASS: return (TerrainType)TERRAIN_GRASS; // e.g. '3'
+        case CHAR_STONE: return (TerrainType)TERRAIN_STONE; // e.g. '4'
+        default:         return (TerrainType)TERRAIN_GRASS; // fallback
+    }
+}
 
-// New function to load a specific chunk from the map data
-void loadMapChunk(const char* mapData, int chunkX, int chunkY, Chunk* chunk);
-
-// Existing functions remain unchanged
-void generateTerrainFromASCII(const char* asciiMap);
-TerrainType charToTerrain(char c);
 char terrainToChar(TerrainType terrain);
 void saveGridAsASCII(const char* filename);
-extern char* loadedMapData;  // Global pointer to the loaded map data
 
 #endif // ASCII_MAP_H
\ No newline at end of file
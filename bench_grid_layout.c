@@ -0,0 +1,268 @@
+// bench_grid_layout.c
+//
+// Compares cell layouts on the neighbourhood-heavy grid kernels: the wall
+// texture stencil, the enclosure flood fill and viewport scans. The world
+// here is much larger than GRID_SIZE so it does not fit in cache, which is
+// the case the chunk layout option is meant for.
+//
+// Each kernel is timed, then replayed through a small cache model (32 KiB,
+// 8-way, 64-byte lines, LRU, like a typical L1d) to count misses, so runs
+// are comparable across machines without hardware counters. All layouts
+// must produce the same results.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "grid.h"
+
+#define BENCH_WORLD 1024               // Tiles per side
+#define BENCH_CHUNKS (BENCH_WORLD / CHUNK_SIZE)
+#define BENCH_REPEATS 5
+#define BENCH_WINDOWS 2000             // Viewport scans per repeat
+#define BENCH_WINDOW_W 64
+#define BENCH_WINDOW_H 40
+#define BENCH_SEED 1337u
+
+#define SIM_LINE_BITS 6
+#define SIM_SETS 64
+#define SIM_WAYS 8
+
+typedef enum {
+    LAYOUT_ROW_MAJOR,     // grid[y][x] over the whole world
+    LAYOUT_CHUNK_ROWS,    // Chunk after chunk, row major inside each
+    LAYOUT_CHUNK_MORTON,  // Chunk after chunk, Z-order inside each (CHUNK_MORTON_LAYOUT)
+    LAYOUT_COUNT
+} Layout;
+
+static const char* layoutName(Layout layout) {
+    switch (layout) {
+        case LAYOUT_ROW_MAJOR:    return "row major";
+        case LAYOUT_CHUNK_ROWS:   return "chunk rows";
+        case LAYOUT_CHUNK_MORTON: return "chunk morton";
+        default:                  return "?";
+    }
+}
+
+typedef struct {
+    uintptr_t tags[SIM_SETS][SIM_WAYS];
+    unsigned long stamp[SIM_SETS][SIM_WAYS];
+    unsigned long clock;
+    unsigned long accesses;
+    unsigned long misses;
+} CacheSim;
+
+static Layout layout;
+static GridCell* cells;
+static CacheSim* sim;  // Non-NULL while replaying through the cache model
+
+static void simAccess(const void* address) {
+    uintptr_t line = (uintptr_t)address >> SIM_LINE_BITS;
+    int set = (int)(line % SIM_SETS);
+    int victim = 0;
+
+    sim->accesses++;
+    sim->clock++;
+    for (int way = 0; way < SIM_WAYS; way++) {
+        if (sim->stamp[set][way] && sim->tags[set][way] == line) {
+            sim->stamp[set][way] = sim->clock;
+            return;
+        }
+        if (sim->stamp[set][way] < sim->stamp[set][victim]) {
+            victim = way;
+        }
+    }
+    sim->misses++;
+    sim->tags[set][victim] = line;
+    sim->stamp[set][victim] = sim->clock;
+}
+
+static inline size_t cellIndex(int x, int y) {
+    size_t chunk = (size_t)(y / CHUNK_SIZE) * BENCH_CHUNKS + (size_t)(x / CHUNK_SIZE);
+    switch (layout) {
+        case LAYOUT_CHUNK_ROWS:
+            return chunk * CHUNK_CELLS + (size_t)((y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE);
+        case LAYOUT_CHUNK_MORTON:
+            return chunk * CHUNK_CELLS + (size_t)chunkMortonIndex(x % CHUNK_SIZE, y % CHUNK_SIZE);
+        default:
+            return (size_t)y * BENCH_WORLD + (size_t)x;
+    }
+}
+
+static inline const GridCell* cellAt(int x, int y) {
+    const GridCell* cell = &cells[cellIndex(x, y)];
+    if (sim) simAccess(cell);
+    return cell;
+}
+
+static inline bool isWall(int x, int y) {
+    if (x < 0 || y < 0 || x >= BENCH_WORLD || y >= BENCH_WORLD) return false;
+    return cellAt(x, y)->structureType != 0;
+}
+
+static uint32_t hash2(uint32_t x, uint32_t y) {
+    uint32_t h = x * 374761393u + y * 668265263u + BENCH_SEED;
+    h = (h ^ (h >> 13)) * 1274126177u;
+    return h ^ (h >> 16);
+}
+
+// Same world in every layout: mostly walkable, scattered wall segments
+static void fillWorld(void) {
+    for (int y = 0; y < BENCH_WORLD; y++) {
+        for (int x = 0; x < BENCH_WORLD; x++) {
+            GridCell cell = {0};
+            uint32_t h = hash2((uint32_t)x, (uint32_t)y);
+            bool wall = (h & 63) < 9 || ((x % 37 == 0) && (h & 3));
+            cell.terrainType = (h >> 8) % 5 == 0 ? TERRAIN_STONE : TERRAIN_GRASS;
+            cell.structureType = wall ? 1 : 0;
+            GRIDCELL_SET_WALKABLE(cell, !wall);
+            cells[cellIndex(x, y)] = cell;
+        }
+    }
+}
+
+// updateWallTextures: every wall looks at its four neighbours
+static unsigned long kernelWallStencil(void) {
+    unsigned long sum = 0;
+    for (int y = 0; y < BENCH_WORLD; y++) {
+        for (int x = 0; x < BENCH_WORLD; x++) {
+            if (!isWall(x, y)) continue;
+            unsigned mask = (unsigned)isWall(x, y - 1) | (unsigned)isWall(x + 1, y) << 1 |
+                            (unsigned)isWall(x, y + 1) << 2 | (unsigned)isWall(x - 1, y) << 3;
+            sum += mask;
+        }
+    }
+    return sum;
+}
+
+// Enclosure detection: 4-way flood fill over walkable cells from the centre
+static unsigned long kernelFloodFill(uint8_t* visited, int* queue) {
+    memset(visited, 0, (size_t)BENCH_WORLD * BENCH_WORLD);
+    int head = 0, tail = 0;
+    int start = (BENCH_WORLD / 2) * BENCH_WORLD + BENCH_WORLD / 2;
+    queue[tail++] = start;
+    visited[start] = 1;
+
+    static const int dx[4] = { 0, 1, 0, -1 };
+    static const int dy[4] = { -1, 0, 1, 0 };
+    while (head < tail) {
+        int x = queue[head] % BENCH_WORLD;
+        int y = queue[head] / BENCH_WORLD;
+        head++;
+        for (int d = 0; d < 4; d++) {
+            int nx = x + dx[d], ny = y + dy[d];
+            if (nx < 0 || ny < 0 || nx >= BENCH_WORLD || ny >= BENCH_WORLD) continue;
+            int n = ny * BENCH_WORLD + nx;
+            if (visited[n] || !GRIDCELL_IS_WALKABLE(*cellAt(nx, ny))) continue;
+            visited[n] = 1;
+            queue[tail++] = n;
+        }
+    }
+    return (unsigned long)tail;
+}
+
+// Culling / rendering: scan rectangular windows at scattered positions
+static unsigned long kernelWindows(void) {
+    unsigned long sum = 0;
+    for (int w = 0; w < BENCH_WINDOWS; w++) {
+        uint32_t h = hash2((uint32_t)w, 99u);
+        int x0 = (int)(h % (BENCH_WORLD - BENCH_WINDOW_W));
+        int y0 = (int)((h >> 12) % (BENCH_WORLD - BENCH_WINDOW_H));
+        for (int y = y0; y < y0 + BENCH_WINDOW_H; y++) {
+            for (int x = x0; x < x0 + BENCH_WINDOW_W; x++) {
+                sum += cellAt(x, y)->terrainType;
+            }
+        }
+    }
+    return sum;
+}
+
+typedef enum {
+    KERNEL_WALLS,
+    KERNEL_FLOOD,
+    KERNEL_WINDOWS,
+    KERNEL_COUNT
+} Kernel;
+
+static const char* kernelName(Kernel kernel) {
+    switch (kernel) {
+        case KERNEL_WALLS: return "wall stencil";
+        case KERNEL_FLOOD: return "flood fill";
+        default:           return "viewport scan";
+    }
+}
+
+static unsigned long runKernel(Kernel kernel, uint8_t* visited, int* queue) {
+    switch (kernel) {
+        case KERNEL_WALLS: return kernelWallStencil();
+        case KERNEL_FLOOD: return kernelFloodFill(visited, queue);
+        default:           return kernelWindows();
+    }
+}
+
+static double secondsSince(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(void) {
+    size_t cellCount = (size_t)BENCH_WORLD * BENCH_WORLD;
+    cells = malloc(sizeof(GridCell) * cellCount);
+    uint8_t* visited = malloc(cellCount);
+    int* queue = malloc(sizeof(int) * cellCount);
+    CacheSim* model = malloc(sizeof(CacheSim));
+    if (!cells || !visited || !queue || !model) {
+        fprintf(stderr, "Failed to allocate benchmark buffers\n");
+        free(cells);
+        free(visited);
+        free(queue);
+        free(model);
+        return 1;
+    }
+
+    printf("Grid layout benchmark: %dx%d tiles, %d-tile chunks, %d repeats\n",
+           BENCH_WORLD, BENCH_WORLD, CHUNK_SIZE, BENCH_REPEATS);
+    printf("%-14s %-13s %10s %14s %12s\n", "kernel", "layout", "ms/run", "L1 misses", "miss/1k");
+
+    unsigned long expected[KERNEL_COUNT];
+    int mismatches = 0;
+    for (int l = 0; l < LAYOUT_COUNT; l++) {
+        layout = (Layout)l;
+        fillWorld();
+
+        for (int k = 0; k < KERNEL_COUNT; k++) {
+            volatile unsigned long result = 0;
+            clock_t start = clock();
+            for (int r = 0; r < BENCH_REPEATS; r++) {
+                result = runKernel((Kernel)k, visited, queue);
+            }
+            double elapsed = secondsSince(start);
+
+            memset(model, 0, sizeof(*model));
+            sim = model;
+            runKernel((Kernel)k, visited, queue);
+            sim = NULL;
+
+            if (l == 0) {
+                expected[k] = result;
+            } else if (result != expected[k]) {
+                mismatches++;
+            }
+
+            printf("%-14s %-13s %10.2f %14lu %12.1f\n",
+                   kernelName((Kernel)k), layoutName(layout),
+                   elapsed * 1000.0 / BENCH_REPEATS, model->misses,
+                   model->accesses ? 1000.0 * model->misses / model->accesses : 0.0);
+        }
+    }
+
+    free(cells);
+    free(visited);
+    free(queue);
+    free(model);
+
+    if (mismatches) {
+        fprintf(stderr, "Layouts disagree on kernel results\n");
+        return 1;
+    }
+    return 0;
+}
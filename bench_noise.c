@@ -0,0 +1,130 @@
+// bench_noise.c
+//
+// Microbenchmark for the noise module: compares the single-sample reference
+// path against the row kernels and checks they agree bit for bit.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "noise.h"
+
+#define BENCH_WIDTH 256
+#define BENCH_HEIGHT 256
+#define BENCH_REPEATS 20
+#define BENCH_SEED 1337u
+#define BENCH_SCALE 0.0625f
+#define BENCH_OCTAVES 4
+#define BENCH_PERSISTENCE 0.5f
+
+typedef enum {
+    KIND_VALUE,
+    KIND_GRADIENT,
+    KIND_FBM
+} NoiseKind;
+
+static const char* kindName(NoiseKind kind) {
+    switch (kind) {
+        case KIND_VALUE:    return "value";
+        case KIND_GRADIENT: return "gradient";
+        case KIND_FBM:      return "fbm x4";
+        default:            return "?";
+    }
+}
+
+static float sampleScalar(NoiseKind kind, float x, float y) {
+    switch (kind) {
+        case KIND_VALUE:    return noiseValue2D(BENCH_SEED, x, y);
+        case KIND_GRADIENT: return noiseGradient2D(BENCH_SEED, x, y);
+        default:            return noiseFbm2D(BENCH_SEED, x, y, BENCH_PERSISTENCE, BENCH_OCTAVES);
+    }
+}
+
+static void sampleRow(NoiseKind kind, float y, float* out) {
+    switch (kind) {
+        case KIND_VALUE:
+            noiseValueRow(BENCH_SEED, 0.0f, y, BENCH_SCALE, BENCH_WIDTH, out);
+            break;
+        case KIND_GRADIENT:
+            noiseGradientRow(BENCH_SEED, 0.0f, y, BENCH_SCALE, BENCH_WIDTH, out);
+            break;
+        default:
+            noiseFbmRow(BENCH_SEED, 0.0f, y, BENCH_SCALE, BENCH_WIDTH,
+                        BENCH_PERSISTENCE, BENCH_OCTAVES, out);
+            break;
+    }
+}
+
+static double secondsSince(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static int runKind(NoiseKind kind, float* scalarOut, float* rowOut) {
+    const double samples = (double)BENCH_WIDTH * BENCH_HEIGHT * BENCH_REPEATS;
+    volatile float sink = 0.0f;
+
+    clock_t start = clock();
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        for (int y = 0; y < BENCH_HEIGHT; y++) {
+            float fy = (float)y * BENCH_SCALE;
+            for (int x = 0; x < BENCH_WIDTH; x++) {
+                scalarOut[y * BENCH_WIDTH + x] = sampleScalar(kind, 0.0f + (float)x * BENCH_SCALE, fy);
+            }
+        }
+        sink += scalarOut[r];
+    }
+    double scalarTime = secondsSince(start);
+
+    start = clock();
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        for (int y = 0; y < BENCH_HEIGHT; y++) {
+            sampleRow(kind, (float)y * BENCH_SCALE, &rowOut[y * BENCH_WIDTH]);
+        }
+        sink += rowOut[r];
+    }
+    double rowTime = secondsSince(start);
+    (void)sink;
+
+    int mismatches = 0;
+    for (int i = 0; i < BENCH_WIDTH * BENCH_HEIGHT; i++) {
+        if (memcmp(&scalarOut[i], &rowOut[i], sizeof(float)) != 0) {
+            mismatches++;
+        }
+    }
+
+    printf("%-9s scalar: %8.2f Msamples/s   row: %8.2f Msamples/s   speedup: %5.2fx   mismatches: %d\n",
+           kindName(kind),
+           scalarTime > 0.0 ? samples / scalarTime / 1e6 : 0.0,
+           rowTime > 0.0 ? samples / rowTime / 1e6 : 0.0,
+           rowTime > 0.0 ? scalarTime / rowTime : 0.0,
+           mismatches);
+    return mismatches;
+}
+
+int main(void) {
+    float* scalarOut = malloc(sizeof(float) * BENCH_WIDTH * BENCH_HEIGHT);
+    float* rowOut = malloc(sizeof(float) * BENCH_WIDTH * BENCH_HEIGHT);
+    if (!scalarOut || !rowOut) {
+        fprintf(stderr, "Failed to allocate benchmark buffers\n");
+        free(scalarOut);
+        free(rowOut);
+        return 1;
+    }
+
+    printf("Noise benchmark: %dx%d samples x %d repeats, kernels: %s\n",
+           BENCH_WIDTH, BENCH_HEIGHT, BENCH_REPEATS, noiseSimdName());
+
+    int mismatches = 0;
+    mismatches += runKind(KIND_VALUE, scalarOut, rowOut);
+    mismatches += runKind(KIND_GRADIENT, scalarOut, rowOut);
+    mismatches += runKind(KIND_FBM, scalarOut, rowOut);
+
+    free(scalarOut);
+    free(rowOut);
+
+    if (mismatches) {
+        fprintf(stderr, "Row kernels disagree with the scalar reference\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+// chunk_catchup.c
+#include "chunk_catchup.h"
+#include "gameloop.h"
+#include "grid_edit.h"
+#include "grid_planes.h"
+#include "structure_types.h"
+#include <math.h>
+#include <stdlib.h>
+
+static uint32_t unloadedAt[NUM_CHUNKS][NUM_CHUNKS];
+
+/*
+ * resetChunkCatchUp
+ *
+ * Starts every chunk's clock at the current tick. Called when a game
+ * starts, so chunks first loaded later catch up from that point.
+ */
+void resetChunkCatchUp(void) {
+    uint32_t now = atomic_load(&game_ticks);
+    for (int cy = 0; cy < NUM_CHUNKS; cy++) {
+        for (int cx = 0; cx < NUM_CHUNKS; cx++) {
+            unloadedAt[cy][cx] = now;
+        }
+    }
+}
+
+// Plant cover relaxes exponentially towards PLANT_COVER; tiles that grow
+// are drawn at random from the bare, unoccupied grass of the chunk
+static void regrowPlants(int chunkX, int chunkY, uint32_t elapsed) {
+    int bare[CHUNK_CELLS];
+    int bareCount = 0;
+    int grassCount = 0;
+    int plantCount = 0;
+
+    for (int y = chunkY * CHUNK_SIZE; y < (chunkY + 1) * CHUNK_SIZE; y++) {
+        for (int x = chunkX * CHUNK_SIZE; x < (chunkX + 1) * CHUNK_SIZE; x++) {
+            const GridCell* cell = &grid[y][x];
+            if (cell->terrainType != TERRAIN_GRASS) continue;
+
+            grassCount++;
+            if (cell->structureType == STRUCTURE_PLANT) {
+                plantCount++;
+            } else if (cell->structureType == STRUCTURE_NONE && isTileFree(x, y)) {
+                bare[bareCount++] = y * GRID_SIZE + x;
+            }
+        }
+    }
+    if (grassCount == 0) return;
+
+    float cover = (float)plantCount / grassCount;
+    if (cover >= PLANT_COVER) return;
+
+    float target = PLANT_COVER - (PLANT_COVER - cover) * expf(-(float)elapsed / PLANT_REGROW_TICKS);
+    int grow = (int)((target - cover) * grassCount + 0.5f);
+    if (grow > bareCount) grow = bareCount;
+
+    gridBeginBatch();
+    for (int i = 0; i < grow; i++) {
+        // Partial Fisher-Yates: bare[i] becomes a random unpicked tile
+        int pick = i + rand() % (bareCount - i);
+        int tile = bare[pick];
+        bare[pick] = bare[i];
+
+        int x = tile % GRID_SIZE;
+        int y = tile / GRID_SIZE;
+        bool tree = (float)rand() / RAND_MAX < PLANT_TREE_SHARE;
+        gridSetStructure(x, y, STRUCTURE_PLANT, tree ? MATERIAL_TREE : MATERIAL_FERN);
+        gridSetWalkable(x, y, false);
+    }
+    gridEndBatch();
+}
+
+/*
+ * chunkCatchUpStreamed
+ *
+ * Chunk stream callback: stamps chunks as they unload, and fast-forwards
+ * them by the ticks they were away as they load. Runs after the chunk's
+ * cells are in the grid and its enemies have resumed.
+ *
+ * @param[in] chunkX Chunk column
+ * @param[in] chunkY Chunk row
+ * @param[in] loaded True if the chunk was loaded, false if unloaded
+ */
+void chunkCatchUpStreamed(int chunkX, int chunkY, bool loaded) {
+    if (chunkX < 0 || chunkX >= NUM_CHUNKS || chunkY < 0 || chunkY >= NUM_CHUNKS) return;
+
+    uint32_t now = atomic_load(&game_ticks);
+    if (!loaded) {
+        unloadedAt[chunkY][chunkX] = now;
+        return;
+    }
+
+    uint32_t elapsed = now - unloadedAt[chunkY][chunkX];
+    if (elapsed > 0) {
+        regrowPlants(chunkX, chunkY, elapsed);
+    }
+}
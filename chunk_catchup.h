@@ -0,0 +1,23 @@
+#ifndef CHUNK_CATCHUP_H
+#define CHUNK_CATCHUP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Chunks outside the load radius are not simulated. Each one remembers the
+// game tick it left the grid at, and when it streams back in the time it
+// missed is applied in one step: vegetation on bare grass regrows towards
+// its natural cover. Suspended enemies catch up the same way when they
+// resume (see enemy_residency).
+//
+// Rates are time constants in game ticks (GAME_LOGIC_INTERVAL_MS each): a
+// chunk away for one time constant closes about 63% of the gap.
+
+#define PLANT_COVER 0.15f         // Share of grass tiles carrying ferns or trees
+#define PLANT_TREE_SHARE 0.33f    // Of those, the share that are trees
+#define PLANT_REGROW_TICKS 200.0f
+
+void resetChunkCatchUp(void);
+void chunkCatchUpStreamed(int chunkX, int chunkY, bool loaded);
+
+#endif // CHUNK_CATCHUP_H
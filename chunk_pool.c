@@ -0,0 +1,164 @@
+// chunk_pool.c
+#include "chunk_pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#define CACHE_LINE_SIZE 64
+
+ChunkPool globalChunkPool;
+
+static void* allocSlab(size_t bytes) {
+#ifdef _WIN32
+    return _aligned_malloc(bytes, CHUNK_POOL_PAGE_SIZE);
+#else
+    return aligned_alloc(CHUNK_POOL_PAGE_SIZE, bytes);
+#endif
+}
+
+static void freeSlab(void* slab) {
+#ifdef _WIN32
+    _aligned_free(slab);
+#else
+    free(slab);
+#endif
+}
+
+// Pushes a new slab's chunks so the lowest address is popped first
+static void linkSlab(ChunkPool* pool, char* slab) {
+    for (int i = pool->chunksPerSlab - 1; i >= 0; i--) {
+        void** node = (void**)(slab + (size_t)i * pool->chunkStride);
+        *node = pool->freeList;
+        pool->freeList = node;
+    }
+    pool->freeCount += pool->chunksPerSlab;
+}
+
+// Adds one slab. The allocation happens outside the lock so other threads
+// can keep recycling chunks meanwhile.
+static bool growPool(ChunkPool* pool) {
+    void* slab = allocSlab(pool->slabBytes);
+    if (!slab) {
+        fprintf(stderr, "Failed to allocate chunk slab (%lu bytes)\n", (unsigned long)pool->slabBytes);
+        return false;
+    }
+    if (pool->prefault) {
+        // Touch every page now instead of faulting during streaming
+        memset(slab, 0, pool->slabBytes);
+    }
+
+    SDL_AtomicLock(&pool->lock);
+    if (pool->slabCount >= CHUNK_POOL_MAX_SLABS) {
+        SDL_AtomicUnlock(&pool->lock);
+        freeSlab(slab);
+        fprintf(stderr, "Chunk pool exhausted (%d slabs)\n", CHUNK_POOL_MAX_SLABS);
+        return false;
+    }
+    pool->slabs[pool->slabCount++] = slab;
+    linkSlab(pool, slab);
+    SDL_AtomicUnlock(&pool->lock);
+    return true;
+}
+
+/*
+ * initChunkPool
+ *
+ * Sets up the pool and reserves enough slabs for reserveChunks chunks.
+ * Later calls are ignored until cleanupChunkPool.
+ *
+ * @param[out] pool Pool to initialize
+ * @param[in] reserveChunks Chunks to have available up front
+ * @param[in] prefault Write every slab page when it is allocated
+ * @return bool False if the reservation could not be made
+ */
+bool initChunkPool(ChunkPool* pool, int reserveChunks, bool prefault) {
+    if (pool->initialized) {
+        return true;
+    }
+
+    memset(pool, 0, sizeof(*pool));
+    pool->chunkStride = (sizeof(Chunk) + CACHE_LINE_SIZE - 1) & ~(size_t)(CACHE_LINE_SIZE - 1);
+    size_t minBytes = pool->chunkStride * CHUNK_POOL_SLAB_CHUNKS;
+    pool->slabBytes = (minBytes + CHUNK_POOL_PAGE_SIZE - 1) & ~(size_t)(CHUNK_POOL_PAGE_SIZE - 1);
+    pool->chunksPerSlab = (int)(pool->slabBytes / pool->chunkStride);
+    pool->prefault = prefault;
+    pool->initialized = true;
+
+    while (pool->freeCount < reserveChunks) {
+        if (!growPool(pool)) {
+            return false;
+        }
+    }
+
+    printf("Chunk pool ready: %d chunks in %d slab(s) of %lu bytes%s\n",
+           pool->freeCount, pool->slabCount, (unsigned long)pool->slabBytes,
+           prefault ? ", prefaulted" : "");
+    return true;
+}
+
+/*
+ * chunkPoolAlloc
+ *
+ * Takes a chunk from the pool, growing it by a slab if none are free.
+ * The contents are not cleared.
+ *
+ * @param[in,out] pool The pool
+ * @return Chunk* The chunk, or NULL if the pool is exhausted
+ */
+Chunk* chunkPoolAlloc(ChunkPool* pool) {
+    if (!pool->initialized) {
+        fprintf(stderr, "Chunk pool used before initChunkPool\n");
+        return NULL;
+    }
+
+    for (;;) {
+        SDL_AtomicLock(&pool->lock);
+        void** node = (void**)pool->freeList;
+        if (node) {
+            pool->freeList = *node;
+            pool->freeCount--;
+            pool->inUse++;
+            SDL_AtomicUnlock(&pool->lock);
+            return (Chunk*)node;
+        }
+        SDL_AtomicUnlock(&pool->lock);
+
+        if (!growPool(pool)) {
+            return NULL;
+        }
+    }
+}
+
+void chunkPoolFree(ChunkPool* pool, Chunk* chunk) {
+    if (!chunk) return;
+
+    void** node = (void**)chunk;
+    SDL_AtomicLock(&pool->lock);
+    *node = pool->freeList;
+    pool->freeList = node;
+    pool->freeCount++;
+    pool->inUse--;
+    SDL_AtomicUnlock(&pool->lock);
+}
+
+/*
+ * cleanupChunkPool
+ *
+ * Releases every slab. Any chunk still in use becomes invalid.
+ *
+ * @param[in,out] pool The pool
+ */
+void cleanupChunkPool(ChunkPool* pool) {
+    if (!pool->initialized) return;
+
+    if (pool->inUse > 0) {
+        fprintf(stderr, "Warning: releasing chunk pool with %d chunks in use\n", pool->inUse);
+    }
+    for (int i = 0; i < pool->slabCount; i++) {
+        freeSlab(pool->slabs[i]);
+    }
+    memset(pool, 0, sizeof(*pool));
+}
@@ -0,0 +1,39 @@
+#ifndef CHUNK_POOL_H
+#define CHUNK_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <SDL2/SDL.h>
+#include "grid.h"
+
+// Fixed-size allocator for Chunk. Memory comes in page-aligned slabs that
+// are never returned to the system until cleanup, so streaming a chunk in
+// and out only pushes and pops a free list. Chunks are handed out in
+// address order from a fresh slab, and a freed chunk is the next one reused.
+
+#define CHUNK_POOL_PAGE_SIZE    4096
+#define CHUNK_POOL_SLAB_CHUNKS  32    // Minimum chunks per slab
+#define CHUNK_POOL_MAX_SLABS    16
+
+typedef struct {
+    void* slabs[CHUNK_POOL_MAX_SLABS];
+    int slabCount;
+    size_t slabBytes;        // Whole pages
+    size_t chunkStride;      // sizeof(Chunk) rounded up to a cache line
+    int chunksPerSlab;
+    void* freeList;          // Intrusive: the first word of a free chunk links to the next
+    int freeCount;
+    int inUse;
+    SDL_SpinLock lock;       // Guards everything above
+    bool prefault;
+    bool initialized;
+} ChunkPool;
+
+extern ChunkPool globalChunkPool;
+
+bool initChunkPool(ChunkPool* pool, int reserveChunks, bool prefault);
+Chunk* chunkPoolAlloc(ChunkPool* pool);
+void chunkPoolFree(ChunkPool* pool, Chunk* chunk);
+void cleanupChunkPool(ChunkPool* pool);
+
+#endif // CHUNK_POOL_H
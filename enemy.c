@@ -8,6 +8,12 @@
  */
 
 #include "enemy.h"
+#include "grid_planes.h"
+#include "spatial_hash.h"
+#include "region_sat.h"
+#include "steering.h"
+#include "entity_pool.h"
+#include "world_timers.h"
 #include "gameloop.h"
 #include <math.h>
 #include <stdio.h>
@@ -22,58 +28,60 @@
  * Initialize an enemy entity with given starting position and speed.
  *
  * @param[out] enemy Pointer to the Enemy structure to initialize
+ * @param[in] id Slot in entityStore; enemy i uses i + 1
  * @param[in] startGridX Starting X position on the grid
  * @param[in] startGridY Starting Y position on the grid
  * @param[in] speed Movement speed of the enemy
  *
  * @pre enemy is a valid pointer to an Enemy structure
  * @pre startGridX and startGridY are within valid grid bounds
- * @pre speed is a positive float value
+ * @pre speed is a positive float value, in tiles per physics tick
  */
-void InitEnemy(Enemy* enemy, int startGridX, int startGridY, float speed) {
+void InitEnemy(Enemy* enemy, int id, int startGridX, int startGridY, float speed) {
     if (enemy == NULL) {
         fprintf(stderr, "Error: enemy pointer is NULL in InitEnemy\n");
         return;
     }
+    if (id <= PLAYER_ENTITY_ID || id >= MAX_ENTITIES) {
+        fprintf(stderr, "Error: invalid entity id %d in InitEnemy\n", id);
+        return;
+    }
+
+    enemy->entity.id = id;
 
     atomic_store(&enemy->entity.gridX, startGridX);
     atomic_store(&enemy->entity.gridY, startGridY);
-    enemy->entity.speed = speed;
-    
-    float tempPosX, tempPosY;
-    WorldToScreenCoords(startGridX, startGridY, 0, 0, 1, &tempPosX, &tempPosY);
-    atomic_store(&enemy->entity.posX, tempPosX);
-    atomic_store(&enemy->entity.posY, tempPosY);
+    entityStore.speed[enemy->entity.id] = worldFromTiles(speed);
+    atomic_store(&entityStore.posX[enemy->entity.id], worldFromTile(startGridX));
+    atomic_store(&entityStore.posY[enemy->entity.id], worldFromTile(startGridY));
 
-    atomic_store(&enemy->entity.targetGridX, startGridX);
-    atomic_store(&enemy->entity.targetGridY, startGridY);
+    atomic_store(&entityStore.targetGridX[enemy->entity.id], startGridX);
+    atomic_store(&entityStore.targetGridY[enemy->entity.id], startGridY);
     atomic_store(&enemy->entity.finalGoalX, startGridX);
     atomic_store(&enemy->entity.finalGoalY, startGridY);
     atomic_store(&enemy->entity.needsPathfinding, false);
     enemy->entity.cachedPath = NULL;
     enemy->entity.cachedPathLength = 0;
     enemy->entity.currentPathIndex = 0;
+    atomic_store(&enemy->entity.pathBounds, PATH_BOUNDS_NONE);
+    atomic_store(&enemy->entity.pathInvalidated, false);
+    enemy->entity.reservedX = -1;
+    enemy->entity.reservedY = -1;
+    enemy->entity.waitTicks = 0;
     enemy->entity.isPlayer = false;
 
-    // Initialize animation structure
-    enemy->animation = malloc(sizeof(EnemyAnimation));
-    if (!enemy->animation) {
-        fprintf(stderr, "Failed to allocate enemy animation\n");
-        return;
-    }
-    enemy->animation->currentFrame = 0;
-    enemy->animation->lastFrameUpdate = 0;
-    enemy->animation->isMoving = false;
-    enemy->animation->facing = ENEMY_DIR_DOWN;
+    // Standing still, facing the camera
+    entityStore.animFrame[enemy->entity.id] = 0;
+    entityStore.lastFrameUpdate[enemy->entity.id] = 0;
+    entityStore.isMoving[enemy->entity.id] = false;
+    entityStore.facing[enemy->entity.id] = ENEMY_DIR_DOWN;
 
     int tempNearestX, tempNearestY;
     int attempts = 0;
     const int MAX_ATTEMPTS = 100;
 
     do {
-        findNearestWalkableTile(atomic_load(&enemy->entity.posX), 
-                               atomic_load(&enemy->entity.posY), 
-                               &tempNearestX, &tempNearestY);
+        findNearestWalkableTile(startGridX, startGridY, &tempNearestX, &tempNearestY);
         attempts++;
         
         if (attempts >= MAX_ATTEMPTS) {
@@ -88,110 +96,233 @@ void InitEnemy(Enemy* enemy, int startGridX, int startGridY, float speed) {
 
     atomic_store(&enemy->entity.gridX, tempNearestX);
     atomic_store(&enemy->entity.gridY, tempNearestY);
+    occupancyEnter(tempNearestX, tempNearestY);
+    spatialHashPlace(id, tempNearestX, tempNearestY);
 
-    WorldToScreenCoords(atomic_load(&enemy->entity.gridX), 
-                       atomic_load(&enemy->entity.gridY), 
-                       0, 0, 1, &tempPosX, &tempPosY);
-    atomic_store(&enemy->entity.posX, tempPosX);
-    atomic_store(&enemy->entity.posY, tempPosY);
+    atomic_store(&entityStore.posX[enemy->entity.id], worldFromTile(tempNearestX));
+    atomic_store(&entityStore.posY[enemy->entity.id], worldFromTile(tempNearestY));
 
     enemy->lastPathfindingTime = 0;
+    enemy->lod = ENEMY_LOD_NEAR;
+    enemy->rest = ENEMY_AWAKE;
+    enemy->wakeTimer = TIMER_HANDLE_NONE;
+}
+// Far enemies pick a goal inside their own chunk and skip the
+// reachability test; a goal they cannot reach is dropped when rerouting
+// fails
+static bool pickCoarseGoal(Enemy* enemy, int* goalX, int* goalY) {
+    ChunkCoord chunk = getChunkFromTile(enemy->entity.gridX, enemy->entity.gridY);
+    return regionPickTile(SAT_WALKABLE, chunk.x * CHUNK_SIZE, chunk.y * CHUNK_SIZE,
+                          (chunk.x + 1) * CHUNK_SIZE - 1, (chunk.y + 1) * CHUNK_SIZE - 1,
+                          (unsigned int)rand(), goalX, goalY);
+}
+
+static bool pickReachableGoal(Enemy* enemy, int* goalX, int* goalY) {
+    const int MAX_ATTEMPTS = 10;
+
+    for (int attempts = 0; attempts < MAX_ATTEMPTS; attempts++) {
+        // Only walkable tiles can be reached, so draw from those
+        if (!regionPickTile(SAT_WALKABLE, 0, 0, GRID_SIZE - 1, GRID_SIZE - 1,
+                            (unsigned int)rand(), goalX, goalY)) {
+            return false;
+        }
+
+        // Check if we can actually path to this location
+        int pathLength;
+        Node* testPath = findPath(enemy->entity.gridX, enemy->entity.gridY,
+                                  *goalX, *goalY, &pathLength);
+        if (testPath != NULL) {
+            free(testPath);
+            return true;
+        }
+    }
+    return false;
 }
+
 /*
  * MovementAI
  *
- * Implement basic movement AI for the enemy.
+ * Implement basic movement AI for the enemy. An enemy that reached its
+ * goal rests until its wake timer fires (restEnemy), then picks a new goal
+ * on its next think. Far enemies (enemy->lod) pick coarse goals.
  *
  * @param[in,out] enemy Pointer to the Enemy structure to update
+ * @param[in] currentTime SDL_GetTicks() of this update
+ * @return bool True if the enemy has nothing to do and should rest
  *
  * @pre enemy is a valid pointer to an Enemy structure
  */
 
-void MovementAI(Enemy* enemy, Uint32 currentTime) {
+bool MovementAI(Enemy* enemy, Uint32 currentTime) {
     if (enemy == NULL) {
         fprintf(stderr, "Error: enemy pointer is NULL in MovementAI\n");
-        return;
+        return false;
     }
 
-    // Only recalculate path periodically
-    if ((enemy->entity.gridX == enemy->entity.targetGridX &&
-         enemy->entity.gridY == enemy->entity.targetGridY) ||
-        enemy->entity.needsPathfinding) {
-        
-        /* Only change path with a 20% chance */
-        if (rand() % 10 < 2) {
-            int newTargetX, newTargetY;
-            int attempts = 0;
-            const int MAX_ATTEMPTS = 10;
-            bool foundValidTarget = false;
+    if (atomic_load(&enemy->entity.needsPathfinding)) {
+        enemy->lastPathfindingTime = currentTime;
+        return false;
+    }
+    if (enemy->entity.gridX != enemy->entity.finalGoalX ||
+        enemy->entity.gridY != enemy->entity.finalGoalY) {
+        return false;  // Still on its way
+    }
+    if (enemy->rest != ENEMY_WOKEN) {
+        return enemy->rest == ENEMY_AWAKE;
+    }
 
-            do {
-                newTargetX = rand() % GRID_SIZE;
-                newTargetY = rand() % GRID_SIZE;
-                attempts++;
+    enemy->rest = ENEMY_AWAKE;
+    int newTargetX, newTargetY;
+    bool found = enemy->lod == ENEMY_LOD_FAR ? pickCoarseGoal(enemy, &newTargetX, &newTargetY)
+                                             : pickReachableGoal(enemy, &newTargetX, &newTargetY);
+    if (!found) {
+        return true;  // Nowhere to go from here; try again after resting
+    }
 
-                // Check if we can actually path to this location
-                int pathLength;
-                Node* testPath = findPath(enemy->entity.gridX, enemy->entity.gridY,
-                                        newTargetX, newTargetY, &pathLength);
-                
-                if (testPath != NULL) {
-                    foundValidTarget = true;
-                    free(testPath);
-                }
-            } while (!foundValidTarget && attempts < MAX_ATTEMPTS);
+    enemy->entity.finalGoalX = newTargetX;
+    enemy->entity.finalGoalY = newTargetY;
+    enemy->entity.needsPathfinding = true;
+    enemy->lastPathfindingTime = currentTime;
+    return false;
+}
+/*
+ * thinkEnemy
+ *
+ * Runs the enemy's AI: picks new goals and checks whether its path went
+ * stale. Only touches this enemy, so enemies in different chunks can think
+ * concurrently.
+ *
+ * @param[in,out] enemy Pointer to the Enemy structure to update
+ * @param[in] currentTime SDL_GetTicks() of this update
+ * @return unsigned int ENEMY_THINK_* flags for what is left to do on the
+ *                      thread owning the GL context and the world timers
+ */
+unsigned int thinkEnemy(Enemy* enemy, Uint32 currentTime) {
+    // Enemies in unloaded chunks are suspended and never get here
+    if (MovementAI(enemy, currentTime)) {
+        return ENEMY_THINK_REST;
+    }
 
-            // Only set new target if we found a valid path
-            if (foundValidTarget) {
-                enemy->entity.finalGoalX = newTargetX;
-                enemy->entity.finalGoalY = newTargetY;
-                enemy->entity.needsPathfinding = true;
-                enemy->lastPathfindingTime = currentTime;
-            }
-        } else if (enemy->entity.needsPathfinding) {
-            enemy->lastPathfindingTime = currentTime;
-        }
+    if (enemy->entity.currentPathIndex >= enemy->entity.cachedPathLength) {
+        enemy->entity.needsPathfinding = true;
+    }
+    if (!enemy->entity.needsPathfinding) {
+        return 0;
     }
 
+    // Check if the current path is still valid before recalculating
+    if (enemy->entity.cachedPath && enemy->entity.cachedPathLength > enemy->entity.currentPathIndex &&
+        !atomic_load(&enemy->entity.pathInvalidated)) {
+        int nextX = enemy->entity.cachedPath[enemy->entity.currentPathIndex].x;
+        int nextY = enemy->entity.cachedPath[enemy->entity.currentPathIndex].y;
+        if (isWalkable(nextX, nextY)) {
+            return 0;
+        }
+    }
+    return ENEMY_THINK_REROUTE;
+}
+/*
+ * animateEnemy
+ *
+ * Updates the enemy's facing and walk cycle from its movement.
+ *
+ * @param[in,out] enemy Pointer to the Enemy structure to update
+ * @param[in] currentTime SDL_GetTicks() of this update
+ */
+void animateEnemy(Enemy* enemy, Uint32 currentTime) {
     // Only update animation if we have a valid path
     if (enemy->entity.cachedPath && enemy->entity.currentPathIndex < enemy->entity.cachedPathLength) {
-        float currentPosX = enemy->entity.posX;
-        float currentPosY = enemy->entity.posY;
-        float targetWorldX, targetWorldY;
-        
-        WorldToScreenCoords(
-            atomic_load(&enemy->entity.targetGridX), 
-            atomic_load(&enemy->entity.targetGridY), 
-            0, 0, 1, 
-            &targetWorldX, &targetWorldY
-        );
+        WorldCoord currentPosX = atomic_load(&entityStore.posX[enemy->entity.id]);
+        WorldCoord currentPosY = atomic_load(&entityStore.posY[enemy->entity.id]);
 
-        float dx = targetWorldX - currentPosX;
-        float dy = targetWorldY - currentPosY;
-        float distanceToTarget = sqrt(dx * dx + dy * dy);
+        float dx = worldToTiles(worldFromTile(atomic_load(&entityStore.targetGridX[enemy->entity.id])) - currentPosX);
+        float dy = worldToTiles(worldFromTile(atomic_load(&entityStore.targetGridY[enemy->entity.id])) - currentPosY);
+        float distanceToTarget = sqrtf(dx * dx + dy * dy);
 
-        #define POSITION_EPSILON 0.001f
-        enemy->animation->isMoving = distanceToTarget > POSITION_EPSILON;
+        #define POSITION_EPSILON 0.02f  // Tiles
+        entityStore.isMoving[enemy->entity.id] = distanceToTarget > POSITION_EPSILON;
         
-        if (enemy->animation->isMoving) {
-            float angle = atan2f(dy, dx);
+        if (entityStore.isMoving[enemy->entity.id]) {
+            // Grid rows grow downwards, so flip y to get the on-screen angle
+            float angle = atan2f(-dy, dx);
             const float PI = 3.14159265358979323846f;
             
             // Only update direction if we're actually moving a significant amount
             if (distanceToTarget > POSITION_EPSILON * 2.0f) {
                 if (angle < -3*PI/4 || angle > 3*PI/4) {
-                    enemy->animation->facing = ENEMY_DIR_LEFT;
+                    entityStore.facing[enemy->entity.id] = ENEMY_DIR_LEFT;
                 } else if (angle < -PI/4) {
-                    enemy->animation->facing = ENEMY_DIR_DOWN;
+                    entityStore.facing[enemy->entity.id] = ENEMY_DIR_DOWN;
                 } else if (angle < PI/4) {
-                    enemy->animation->facing = ENEMY_DIR_RIGHT;
+                    entityStore.facing[enemy->entity.id] = ENEMY_DIR_RIGHT;
                 } else {
-                    enemy->animation->facing = ENEMY_DIR_UP;
+                    entityStore.facing[enemy->entity.id] = ENEMY_DIR_UP;
                 }
             }
         }
     } else {
-        enemy->animation->isMoving = false;
+        entityStore.isMoving[enemy->entity.id] = false;
+    }
+
+    // Animation frame update logic using passed-in currentTime
+    if (entityStore.isMoving[enemy->entity.id]) {
+        if (currentTime - entityStore.lastFrameUpdate[enemy->entity.id] >= 70) {  // Using passed-in currentTime
+            entityStore.animFrame[enemy->entity.id] = (entityStore.animFrame[enemy->entity.id] + 1) % 4;
+            entityStore.lastFrameUpdate[enemy->entity.id] = currentTime;
+        }
+    } else {
+        entityStore.animFrame[enemy->entity.id] = 0;  // Reset to standing frame when not moving
+    }
+}
+/*
+ * rerouteEnemy
+ *
+ * Replaces the enemy's path with one to its final goal from the GPU
+ * pathfinder. Must run on the thread owning the GL context.
+ *
+ * @param[in,out] enemy Pointer to the Enemy structure to update
+ */
+void rerouteEnemy(Enemy* enemy) {
+    int pathLength;
+    Node* newPath = findPathGPU(enemy->entity.gridX, enemy->entity.gridY, 
+                              enemy->entity.finalGoalX, enemy->entity.finalGoalY, 
+                              &pathLength);
+    
+    if (newPath) {
+        setEntityPath(&enemy->entity, newPath, pathLength);
+        enemy->entity.needsPathfinding = false;
+        
+        if (pathLength > 1) {
+            entityStore.targetGridX[enemy->entity.id] = newPath[1].x;
+            entityStore.targetGridY[enemy->entity.id] = newPath[1].y;
+        } else {
+            entityStore.targetGridX[enemy->entity.id] = enemy->entity.gridX;
+            entityStore.targetGridY[enemy->entity.id] = enemy->entity.gridY;
+        }
+    } else {
+        // Give the goal up; the enemy rests and then picks another
+        entityStore.targetGridX[enemy->entity.id] = enemy->entity.gridX;
+        entityStore.targetGridY[enemy->entity.id] = enemy->entity.gridY;
+        enemy->entity.finalGoalX = enemy->entity.gridX;
+        enemy->entity.finalGoalY = enemy->entity.gridY;
+        enemy->entity.needsPathfinding = false;
+    }
+}
+/*
+ * restEnemy
+ *
+ * Puts an enemy that has nothing to do to rest: it stops thinking until
+ * its wake timer fires. Runs where the world timers are advanced (the
+ * physics thread), not in a think job. If no timer is left the enemy stays
+ * awake and asks again on its next think.
+ *
+ * @param[in,out] enemy Pointer to the Enemy structure to update
+ */
+void restEnemy(Enemy* enemy) {
+    uint32_t delay = ENEMY_REST_MIN_MS + (uint32_t)(rand() % ENEMY_REST_SPREAD_MS);
+    enemy->wakeTimer = scheduleEnemyWake(entityPoolHandle(enemy->entity.id), delay);
+    if (enemy->wakeTimer != TIMER_HANDLE_NONE) {
+        enemy->rest = ENEMY_RESTING;
     }
 }
 /*
@@ -213,73 +344,24 @@ void UpdateEnemy(Enemy* enemy, Entity** allEntities, int entityCount, Uint32 cur
         fprintf(stderr, "Error: NULL pointer passed to UpdateEnemy\n");
         return;
     }
+    (void)entityCount;
 
-    // Only process AI and movement if the enemy is in a loaded chunk
-    if (isPositionInLoadedChunk(enemy->entity.posX, enemy->entity.posY)) {
-        MovementAI(enemy, currentTime);
-        
-        if (enemy->entity.needsPathfinding) {
-            // Check if the current path is still valid before recalculating
-            bool pathStillValid = false;
-            if (enemy->entity.cachedPath && enemy->entity.cachedPathLength > enemy->entity.currentPathIndex) {
-                int nextX = enemy->entity.cachedPath[enemy->entity.currentPathIndex].x;
-                int nextY = enemy->entity.cachedPath[enemy->entity.currentPathIndex].y;
-                if (isWalkable(nextX, nextY)) {
-                    pathStillValid = true;
-                }
-            }
+    unsigned int actions = thinkEnemy(enemy, currentTime);
+    if (actions & ENEMY_THINK_REROUTE) {
+        rerouteEnemy(enemy);
+    }
+    if (actions & ENEMY_THINK_REST) {
+        restEnemy(enemy);
+    }
 
-            if (!pathStillValid) {
-                int pathLength;
-                Node* newPath = findPathGPU(enemy->entity.gridX, enemy->entity.gridY, 
-                                          enemy->entity.finalGoalX, enemy->entity.finalGoalY, 
-                                          &pathLength);
-                
-                if (newPath) {
-                    if (enemy->entity.cachedPath) {
-                        free(enemy->entity.cachedPath);
-                    }
-                    
-                    enemy->entity.cachedPath = newPath;
-                    enemy->entity.cachedPathLength = pathLength;
-                    enemy->entity.currentPathIndex = 0;
-                    enemy->entity.needsPathfinding = false;
-                    
-                    if (pathLength > 1) {
-                        enemy->entity.targetGridX = newPath[1].x;
-                        enemy->entity.targetGridY = newPath[1].y;
-                    } else {
-                        enemy->entity.targetGridX = enemy->entity.gridX;
-                        enemy->entity.targetGridY = enemy->entity.gridY;
-                    }
-                } else {
-                    enemy->entity.targetGridX = enemy->entity.gridX;
-                    enemy->entity.targetGridY = enemy->entity.gridY;
-                    enemy->entity.needsPathfinding = false;
-                }
-            }
-        }
-        
-        UpdateEntity(&enemy->entity, allEntities, entityCount);
-        
-        // Animation frame update logic using passed-in currentTime
-        if (enemy->animation->isMoving) {
-            if (currentTime - enemy->animation->lastFrameUpdate >= 70) {  // Using passed-in currentTime
-                enemy->animation->currentFrame = (enemy->animation->currentFrame + 1) % 4;
-                enemy->animation->lastFrameUpdate = currentTime;
-            }
-        } else {
-            enemy->animation->currentFrame = 0;  // Reset to standing frame when not moving
-        }
-        
-        if (enemy->entity.currentPathIndex >= enemy->entity.cachedPathLength) {
-            enemy->entity.needsPathfinding = true;
-        }
-    } else {
-        // For enemies in unloaded chunks, maintain their animation state but don't update position
-        enemy->animation->isMoving = false;
-        enemy->animation->currentFrame = 0;
+    Entity* entity = &enemy->entity;
+    if (atomic_load(&entity->needsPathfinding)) {
+        updateEntityPath(entity);
     }
+    steerEntities(&entity, 1);
+    moveEntities(&entity, 1);
+
+    animateEnemy(enemy, currentTime);
 }
 /*
  * CleanupEnemy
@@ -296,13 +378,5 @@ void CleanupEnemy(Enemy* enemy) {
         return;
     }
 
-    if (enemy->animation) {
-        free(enemy->animation);
-        enemy->animation = NULL;
-    }
-
-    if (enemy->entity.cachedPath) {
-        free(enemy->entity.cachedPath);
-        enemy->entity.cachedPath = NULL;
-    }
+    setEntityPath(&enemy->entity, NULL, 0);
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define ENEMY_H
 
 #include "entity.h"
+#include "timer_wheel.h"
 #include <SDL2/SDL.h>
 
 // Add the direction enum if not already defined elsewhere
@@ -12,22 +13,41 @@ typedef enum {
     ENEMY_DIR_RIGHT
 } EnemyDirection;
 
-// Add animation structure
-typedef struct {
-    uint8_t currentFrame;    
-    Uint32 lastFrameUpdate;  
-    bool isMoving;     
-    EnemyDirection facing;     
-} EnemyAnimation;
+// AI level of detail, by distance to the player; see enemy_sim.h
+typedef enum {
+    ENEMY_LOD_NEAR,  // Thinks every AI round and is animated
+    ENEMY_LOD_MID,   // Thinks every few rounds, staggered by id
+    ENEMY_LOD_FAR,   // Thinks rarely and only picks coarse goals
+    ENEMY_LOD_COUNT
+} EnemyLod;
+
+// Between goals an enemy rests: it stops thinking until its wake timer
+// (world_timers.h) fires, then picks its next goal
+typedef enum {
+    ENEMY_AWAKE,
+    ENEMY_RESTING,
+    ENEMY_WOKEN    // Wake timer fired; picks a goal on its next think
+} EnemyRest;
+
+// What the merge after thinkEnemy has to do for an enemy
+#define ENEMY_THINK_REROUTE 1u  // Path is stale; call rerouteEnemy
+#define ENEMY_THINK_REST 2u     // Has nothing to do; call restEnemy
 
+// Animation state lives in entityStore (animFrame, facing, isMoving)
 typedef struct {
     Entity entity;
     Uint32 lastPathfindingTime;
-    EnemyAnimation* animation;  // Add this line
+    uint8_t lod;                 // EnemyLod
+    uint8_t rest;                // EnemyRest
+    TimerHandle wakeTimer;       // Pending while resting
 } Enemy;
 
-void InitEnemy(Enemy* enemy, int startGridX, int startGridY, float speed);
-void MovementAI(Enemy* enemy, Uint32 currentTime);
+void InitEnemy(Enemy* enemy, int id, int startGridX, int startGridY, float speed);
+bool MovementAI(Enemy* enemy, Uint32 currentTime);
+unsigned int thinkEnemy(Enemy* enemy, Uint32 currentTime);
+void rerouteEnemy(Enemy* enemy);
+void restEnemy(Enemy* enemy);
+void animateEnemy(Enemy* enemy, Uint32 currentTime);
 void UpdateEnemy(Enemy* enemy, Entity** allEntities, int entityCount, Uint32 currentTime);
 void CleanupEnemy(Enemy* enemy);
 
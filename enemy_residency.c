@@ -0,0 +1,260 @@
+// enemy_residency.c
+#include "enemy_residency.h"
+#include "gameloop.h"
+#include "grid_planes.h"
+#include "region_sat.h"
+#include "spatial_hash.h"
+#include "world_timers.h"
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdatomic.h>
+
+extern Enemy enemies[MAX_ENEMIES];
+
+// Active enemy indices, compacted. Changed only by the thread that streams
+// chunks; other threads may read a slightly stale list, which at worst
+// updates or draws a just-suspended enemy once more.
+static atomic_int activeEnemies[MAX_ENEMIES];
+static atomic_int activeCount;
+static int activeSlot[MAX_ENEMIES];  // Index into activeEnemies, or -1 while suspended
+
+// Suspended enemies, as a singly linked list per chunk
+static int residentHead[NUM_CHUNKS][NUM_CHUNKS];
+static int residentNext[MAX_ENEMIES];
+static uint32_t suspendedAt[MAX_ENEMIES];  // game_ticks when suspended
+
+// Resident lists only ever hold a handful of enemies per chunk
+static void unlinkResident(int index) {
+    Entity* entity = &enemies[index].entity;
+    ChunkCoord chunk = getChunkFromTile(atomic_load(&entity->gridX), atomic_load(&entity->gridY));
+    int* link = &residentHead[chunk.y][chunk.x];
+    while (*link >= 0) {
+        if (*link == index) {
+            *link = residentNext[index];
+            return;
+        }
+        link = &residentNext[*link];
+    }
+}
+
+static void activate(int enemy) {
+    int slot = atomic_load(&activeCount);
+    atomic_store(&activeEnemies[slot], enemy);
+    activeSlot[enemy] = slot;
+    atomic_store(&activeCount, slot + 1);
+}
+
+static void deactivate(int enemy) {
+    int slot = activeSlot[enemy];
+    int last = atomic_load(&activeCount) - 1;
+    int moved = atomic_load(&activeEnemies[last]);
+
+    atomic_store(&activeEnemies[slot], moved);
+    activeSlot[moved] = slot;
+    activeSlot[enemy] = -1;
+    atomic_store(&activeCount, last);
+}
+
+static void suspendEnemy(int index, ChunkCoord chunk) {
+    Entity* entity = &enemies[index].entity;
+
+    deactivate(index);
+    allEntities[index + 1] = NULL;
+    occupancyLeave(atomic_load(&entity->gridX), atomic_load(&entity->gridY));
+    spatialHashRemove(entity->id);
+    releaseEntityReservation(entity);
+
+    // Settle on the current tile and drop the path; it is recomputed after
+    // resuming, against whatever the chunk looks like by then
+    setEntityPath(entity, NULL, 0);
+    atomic_store(&entityStore.targetGridX[entity->id], atomic_load(&entity->gridX));
+    atomic_store(&entityStore.targetGridY[entity->id], atomic_load(&entity->gridY));
+    atomic_store(&entityStore.posX[entity->id], worldFromTile(atomic_load(&entity->gridX)));
+    atomic_store(&entityStore.posY[entity->id], worldFromTile(atomic_load(&entity->gridY)));
+    atomic_store(&entity->needsPathfinding, true);
+    entityStore.isMoving[entity->id] = false;
+    entityStore.animFrame[entity->id] = 0;
+
+    residentNext[index] = residentHead[chunk.y][chunk.x];
+    residentHead[chunk.y][chunk.x] = index;
+    suspendedAt[index] = atomic_load(&game_ticks);
+}
+
+// Fast-forwards an enemy's wandering over the ticks it was suspended
+static void relocateEnemy(Entity* entity, int chunkX, int chunkY, uint32_t elapsed) {
+    float wandered = 1.0f - expf(-(float)elapsed / ENEMY_WANDER_TICKS);
+    if ((float)rand() / RAND_MAX >= wandered) return;
+
+    int x, y;
+    if (!regionPickTile(SAT_CLEAR, chunkX * CHUNK_SIZE, chunkY * CHUNK_SIZE,
+                        (chunkX + 1) * CHUNK_SIZE - 1, (chunkY + 1) * CHUNK_SIZE - 1,
+                        (unsigned int)rand(), &x, &y) ||
+        planeTest(occupiedPlane, x, y)) {
+        return;
+    }
+
+    atomic_store(&entity->gridX, x);
+    atomic_store(&entity->gridY, y);
+    atomic_store(&entityStore.targetGridX[entity->id], x);
+    atomic_store(&entityStore.targetGridY[entity->id], y);
+    atomic_store(&entity->finalGoalX, x);
+    atomic_store(&entity->finalGoalY, y);
+    atomic_store(&entityStore.posX[entity->id], worldFromTile(x));
+    atomic_store(&entityStore.posY[entity->id], worldFromTile(y));
+}
+
+static void resumeEnemy(int index, int chunkX, int chunkY) {
+    Entity* entity = &enemies[index].entity;
+
+    relocateEnemy(entity, chunkX, chunkY, atomic_load(&game_ticks) - suspendedAt[index]);
+    activate(index);
+    allEntities[index + 1] = entity;
+    occupancyEnter(atomic_load(&entity->gridX), atomic_load(&entity->gridY));
+    spatialHashPlace(entity->id, atomic_load(&entity->gridX), atomic_load(&entity->gridY));
+}
+
+/*
+ * rebuildEnemyResidency
+ *
+ * Sorts every spawned enemy into active or suspended by whether its chunk
+ * is loaded. Called once enemies are (re)spawned.
+ */
+void rebuildEnemyResidency(void) {
+    for (int cy = 0; cy < NUM_CHUNKS; cy++) {
+        for (int cx = 0; cx < NUM_CHUNKS; cx++) {
+            residentHead[cy][cx] = -1;
+        }
+    }
+    atomic_store(&activeCount, 0);
+    for (int i = 0; i < MAX_ENEMIES; i++) {
+        activeSlot[i] = -1;
+    }
+
+    int suspended = 0;
+    int span = entityPoolSpan();
+    for (int id = PLAYER_ENTITY_ID + 1; id < span; id++) {
+        if (!entityPoolIsLive(id)) continue;
+        int i = id - 1;
+        Entity* entity = &enemies[i].entity;
+        ChunkCoord chunk = getChunkFromTile(atomic_load(&entity->gridX), atomic_load(&entity->gridY));
+
+        // Spawned enemies start out active and occupying their tile
+        activate(i);
+        allEntities[i + 1] = entity;
+        if (!globalChunkManager || !isChunkLoaded(globalChunkManager, chunk.x, chunk.y)) {
+            suspendEnemy(i, chunk);
+            suspended++;
+        }
+    }
+    printf("Enemy residency: %d active, %d suspended\n", atomic_load(&activeCount), suspended);
+}
+
+/*
+ * spawnEnemy
+ *
+ * Spawns an enemy during play, on the nearest walkable tile to the one
+ * given. It starts active, or suspended if its chunk is not loaded.
+ *
+ * @param[in] gridX Spawn tile column
+ * @param[in] gridY Spawn tile row
+ * @param[in] speed Movement speed, in tiles per physics tick
+ * @return EntityHandle Handle of the enemy, or ENTITY_HANDLE_NONE if the
+ *                      entity pool is full
+ */
+EntityHandle spawnEnemy(int gridX, int gridY, float speed) {
+    EntityHandle handle = entityPoolSpawn();
+    if (handle == ENTITY_HANDLE_NONE) return ENTITY_HANDLE_NONE;
+
+    int id = entityPoolResolve(handle);
+    int index = id - 1;
+    Entity* entity = &enemies[index].entity;
+    InitEnemy(&enemies[index], id, gridX, gridY, speed);
+
+    activate(index);
+    allEntities[id] = entity;
+    ChunkCoord chunk = getChunkFromTile(atomic_load(&entity->gridX), atomic_load(&entity->gridY));
+    if (!globalChunkManager || !isChunkLoaded(globalChunkManager, chunk.x, chunk.y)) {
+        suspendEnemy(index, chunk);
+    }
+    return handle;
+}
+
+/*
+ * despawnEnemy
+ *
+ * Removes an enemy from the world and returns its id to the entity pool.
+ * Handles to it stop resolving.
+ *
+ * @param[in] handle Enemy to remove
+ * @return bool False if the handle is stale or not an enemy
+ */
+bool despawnEnemy(EntityHandle handle) {
+    int id = entityPoolResolve(handle);
+    if (id <= PLAYER_ENTITY_ID) return false;
+
+    int index = id - 1;
+    Entity* entity = &enemies[index].entity;
+    if (activeSlot[index] >= 0) {
+        deactivate(index);
+        allEntities[id] = NULL;
+        occupancyLeave(atomic_load(&entity->gridX), atomic_load(&entity->gridY));
+        spatialHashRemove(id);
+        releaseEntityReservation(entity);
+    } else {
+        unlinkResident(index);  // Already off the grid while suspended
+    }
+
+    cancelWorldTimer(enemies[index].wakeTimer);
+    CleanupEnemy(&enemies[index]);
+    entityStore.isMoving[id] = false;
+    return entityPoolDespawn(handle);
+}
+
+/*
+ * enemyChunkStreamed
+ *
+ * Chunk stream callback: suspends the enemies standing in a chunk that was
+ * unloaded, or resumes those parked in a chunk that was loaded, letting
+ * them catch up on the wandering they missed.
+ *
+ * @param[in] chunkX Chunk column
+ * @param[in] chunkY Chunk row
+ * @param[in] loaded True if the chunk was loaded, false if unloaded
+ */
+void enemyChunkStreamed(int chunkX, int chunkY, bool loaded) {
+    if (chunkX < 0 || chunkX >= NUM_CHUNKS || chunkY < 0 || chunkY >= NUM_CHUNKS) return;
+
+    if (loaded) {
+        int index = residentHead[chunkY][chunkX];
+        residentHead[chunkY][chunkX] = -1;
+        while (index >= 0) {
+            int next = residentNext[index];
+            resumeEnemy(index, chunkX, chunkY);
+            index = next;
+        }
+        return;
+    }
+
+    for (int slot = atomic_load(&activeCount) - 1; slot >= 0; slot--) {
+        int index = atomic_load(&activeEnemies[slot]);
+        Entity* entity = &enemies[index].entity;
+        ChunkCoord chunk = getChunkFromTile(atomic_load(&entity->gridX), atomic_load(&entity->gridY));
+        if (chunk.x == chunkX && chunk.y == chunkY) {
+            suspendEnemy(index, chunk);
+        }
+    }
+}
+
+int activeEnemyCount(void) {
+    return atomic_load(&activeCount);
+}
+
+// By enemy index (id - 1), for loops that walk ids in order
+bool isEnemyActive(int index) {
+    return activeSlot[index] >= 0;
+}
+
+Enemy* activeEnemy(int index) {
+    return &enemies[atomic_load(&activeEnemies[index])];
+}
@@ -0,0 +1,37 @@
+#ifndef ENEMY_RESIDENCY_H
+#define ENEMY_RESIDENCY_H
+
+#include <stdbool.h>
+#include "enemy.h"
+#include "entity_pool.h"
+
+// Enemies are resident in the chunk under them. While that chunk is
+// loaded the enemy is active: it is in allEntities and in the active list
+// that the physics, game logic and render loops walk. When the chunk
+// unloads, its enemies are suspended: they drop their path and their
+// occupancy and allEntities slot, and are parked on the chunk's resident
+// list until it streams back in. Enemies keep their slot in enemies[], so
+// suspending one only unlinks it.
+//
+// Suspended enemies are not simulated. When one resumes it has, with a
+// probability growing with the ticks it was away, wandered somewhere else
+// in its chunk, and is placed on a random clear tile there.
+//
+// Enemies spawned and despawned during play go through spawnEnemy and
+// despawnEnemy, which take their id from the entity pool and give it back.
+// Both run on the thread that streams chunks (the physics thread); other
+// threads use queueSpawnEnemy / queueDespawnEnemy.
+
+#define ENEMY_WANDER_TICKS 50.0f  // Time constant of the catch-up relocation
+
+void rebuildEnemyResidency(void);
+void enemyChunkStreamed(int chunkX, int chunkY, bool loaded);
+
+EntityHandle spawnEnemy(int gridX, int gridY, float speed);
+bool despawnEnemy(EntityHandle handle);
+
+int activeEnemyCount(void);
+bool isEnemyActive(int index);
+Enemy* activeEnemy(int index);
+
+#endif // ENEMY_RESIDENCY_H
@@ -0,0 +1,237 @@
+// enemy_sim.c
+#include "enemy_sim.h"
+#include "enemy_residency.h"
+#include "entity_pool.h"
+#include "gameloop.h"
+#include "steering.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_COUNT (NUM_CHUNKS * NUM_CHUNKS)
+#define MOVE_BATCH 256  // Enemies handed to moveEntities at a time
+
+typedef struct {
+    // Active enemies bucketed by chunk: chunk c owns order[start[c]..start[c + 1]),
+    // in ascending id order within each chunk
+    Enemy* order[MAX_ENEMIES];
+    int start[CHUNK_COUNT + 1];
+    Enemy* scanned[MAX_ENEMIES];    // Scratch for the sort: active enemies by id
+    int chunkOfEnemy[MAX_ENEMIES];  // and their chunks
+
+    // Chunks handed out in the current pool run, one per job
+    int chunks[CHUNK_COUNT];
+
+    Uint32 currentTime;
+    unsigned int round;          // thinkEnemies calls so far, for the LOD buckets
+    int focusX, focusY;          // Tile the LOD distances are measured from
+    uint8_t actions[MAX_ENTITIES];  // ENEMY_THINK_* from the job owning the enemy, read in the merge
+    int thinks[WORKER_POOL_MAX_THREADS + 1][ENEMY_LOD_COUNT];  // By workerPoolThreadIndex
+    EnemySimTiming* timing;
+} EnemySimTick;
+
+extern Enemy enemies[MAX_ENEMIES];
+
+static EnemySimTick tick;  // Only the physics thread simulates
+
+static int chunkOf(const Enemy* enemy) {
+    int cx = atomic_load(&enemy->entity.gridX) / CHUNK_SIZE;
+    int cy = atomic_load(&enemy->entity.gridY) / CHUNK_SIZE;
+    if (cx < 0) cx = 0;
+    if (cy < 0) cy = 0;
+    if (cx >= NUM_CHUNKS) cx = NUM_CHUNKS - 1;
+    if (cy >= NUM_CHUNKS) cy = NUM_CHUNKS - 1;
+    return cy * NUM_CHUNKS + cx;
+}
+
+static int colorOf(int chunk) {
+    return (chunk % NUM_CHUNKS & 1) | (chunk / NUM_CHUNKS & 1) << 1;
+}
+
+// Counting sort of the active enemies by chunk. The scan goes by id rather
+// than through the active list, which reorders on every suspend, so
+// enemies keep their relative order from tick to tick.
+static void partitionEnemies(void) {
+    int span = entityPoolSpan();
+    int count = 0;
+
+    memset(tick.start, 0, sizeof(tick.start));
+    for (int id = PLAYER_ENTITY_ID + 1; id < span; id++) {
+        if (!entityPoolIsLive(id) || !isEnemyActive(id - 1)) continue;
+        tick.chunkOfEnemy[count] = chunkOf(&enemies[id - 1]);
+        tick.start[tick.chunkOfEnemy[count] + 1]++;
+        tick.scanned[count++] = &enemies[id - 1];
+    }
+    for (int c = 0; c < CHUNK_COUNT; c++) {
+        tick.start[c + 1] += tick.start[c];
+    }
+
+    int fill[CHUNK_COUNT];
+    memcpy(fill, tick.start, sizeof(fill));
+    for (int i = 0; i < count; i++) {
+        tick.order[fill[tick.chunkOfEnemy[i]]++] = tick.scanned[i];
+    }
+}
+
+// Runs job once per non-empty chunk, one colour at a time or, with
+// colors == 1, all at once
+static void runByChunk(WorkerJobFn job, int colors) {
+    for (int color = 0; color < colors; color++) {
+        int jobs = 0;
+        for (int c = 0; c < CHUNK_COUNT; c++) {
+            if ((colors == 1 || colorOf(c) == color) && tick.start[c + 1] > tick.start[c]) {
+                tick.chunks[jobs++] = c;
+            }
+        }
+        workerPoolRun(&globalWorkerPool, job, &tick, jobs);
+    }
+}
+
+// Each thread only adds to its own slot, and workerPoolRun returning
+// orders these writes before the caller reads them
+static void recordJob(EnemySimTick* t, Uint64 jobStart) {
+    t->timing->busy[workerPoolThreadIndex(&globalWorkerPool)] += SDL_GetPerformanceCounter() - jobStart;
+}
+
+// Paths are refreshed where needed, then the chunk's enemies are steered
+// around each other and take their step, in batches of MOVE_BATCH
+static void moveChunkJob(void* context, int jobIndex) {
+    EnemySimTick* t = (EnemySimTick*)context;
+    Uint64 jobStart = SDL_GetPerformanceCounter();
+
+    int chunk = t->chunks[jobIndex];
+    Enemy** chunkEnemies = &t->order[t->start[chunk]];
+    int count = t->start[chunk + 1] - t->start[chunk];
+
+    Entity* moving[MOVE_BATCH];
+    for (int first = 0; first < count; first += MOVE_BATCH) {
+        int batch = count - first < MOVE_BATCH ? count - first : MOVE_BATCH;
+        for (int i = 0; i < batch; i++) {
+            moving[i] = &chunkEnemies[first + i]->entity;
+            if (atomic_load(&moving[i]->needsPathfinding)) {
+                updateEntityPath(moving[i]);
+            }
+        }
+        steerEntities(moving, batch);
+        moveEntities(moving, batch);
+    }
+
+    recordJob(t, jobStart);
+}
+
+static const unsigned int lodRounds[ENEMY_LOD_COUNT] = {
+    1, ENEMY_LOD_MID_ROUNDS, ENEMY_LOD_FAR_ROUNDS
+};
+
+// Tier rings, with hysteresis so an enemy walking along a ring does not
+// flip tiers every round
+static EnemyLod lodOf(const Enemy* enemy, int focusX, int focusY) {
+    int dx = abs(atomic_load(&enemy->entity.gridX) - focusX);
+    int dy = abs(atomic_load(&enemy->entity.gridY) - focusY);
+    int distance = dx > dy ? dx : dy;
+
+    int nearRing = ENEMY_LOD_NEAR_TILES;
+    int midRing = ENEMY_LOD_MID_TILES;
+    if (enemy->lod == ENEMY_LOD_NEAR) nearRing += ENEMY_LOD_HYSTERESIS;
+    if (enemy->lod != ENEMY_LOD_FAR) midRing += ENEMY_LOD_HYSTERESIS;
+
+    if (distance <= nearRing) return ENEMY_LOD_NEAR;
+    if (distance <= midRing) return ENEMY_LOD_MID;
+    return ENEMY_LOD_FAR;
+}
+
+static void thinkChunkJob(void* context, int jobIndex) {
+    EnemySimTick* t = (EnemySimTick*)context;
+    Uint64 jobStart = SDL_GetPerformanceCounter();
+    int* thinks = t->thinks[workerPoolThreadIndex(&globalWorkerPool)];
+
+    int chunk = t->chunks[jobIndex];
+    for (int i = t->start[chunk]; i < t->start[chunk + 1]; i++) {
+        Enemy* enemy = t->order[i];
+        enemy->lod = (uint8_t)lodOf(enemy, t->focusX, t->focusY);
+
+        // Enemies out of their bucket keep following their current path.
+        // Resting ones sleep until their wake timer, unless a step left
+        // them needing a path.
+        bool asleep = enemy->rest == ENEMY_RESTING && !atomic_load(&enemy->entity.needsPathfinding);
+        bool due = !asleep && ((unsigned int)enemy->entity.id + t->round) % lodRounds[enemy->lod] == 0;
+        t->actions[enemy->entity.id] = due ? (uint8_t)thinkEnemy(enemy, t->currentTime) : 0;
+        thinks[enemy->lod] += due;
+    }
+
+    recordJob(t, jobStart);
+}
+
+/*
+ * resetEnemySimTiming
+ *
+ * Clears the per-thread timings, at the start of a physics tick.
+ *
+ * @param[out] timing Timing to clear
+ */
+void resetEnemySimTiming(EnemySimTiming* timing) {
+    memset(timing, 0, sizeof(*timing));
+    timing->threadCount = workerPoolSize(&globalWorkerPool);
+}
+
+/*
+ * moveEnemies
+ *
+ * Moves every active enemy one physics step, in parallel by chunk colour.
+ *
+ * @param[in,out] timing Per-thread busy time of the jobs, for physics_load
+ */
+void moveEnemies(EnemySimTiming* timing) {
+    Uint64 simStart = SDL_GetPerformanceCounter();
+
+    tick.timing = timing;
+    partitionEnemies();
+    runByChunk(moveChunkJob, ENEMY_SIM_COLORS);
+
+    timing->elapsed += SDL_GetPerformanceCounter() - simStart;
+}
+
+/*
+ * thinkEnemies
+ *
+ * Updates the LOD tier of every active enemy and runs the AI of those
+ * whose bucket is due and who are not resting, in parallel by chunk, then
+ * the GPU reroutes and rests they asked for.
+ *
+ * @param[in] currentTime SDL_GetTicks() shared by all enemies
+ * @param[in] focusX Tile column LOD distances are measured from
+ * @param[in] focusY Tile row LOD distances are measured from
+ * @param[in,out] timing Per-thread busy time of the jobs, for physics_load
+ */
+void thinkEnemies(Uint32 currentTime, int focusX, int focusY, EnemySimTiming* timing) {
+    Uint64 simStart = SDL_GetPerformanceCounter();
+
+    tick.currentTime = currentTime;
+    tick.focusX = focusX;
+    tick.focusY = focusY;
+    tick.timing = timing;
+    memset(tick.thinks, 0, sizeof(tick.thinks));
+    partitionEnemies();
+    runByChunk(thinkChunkJob, 1);
+    tick.round++;
+
+    for (int thread = 0; thread <= WORKER_POOL_MAX_THREADS; thread++) {
+        for (int lod = 0; lod < ENEMY_LOD_COUNT; lod++) {
+            timing->thinks[lod] += tick.thinks[thread][lod];
+        }
+    }
+
+    // Merge: everything a job could not do without touching shared state
+    int count = tick.start[CHUNK_COUNT];
+    for (int i = 0; i < count; i++) {
+        Enemy* enemy = tick.order[i];
+        unsigned int actions = tick.actions[enemy->entity.id];
+        if (actions & ENEMY_THINK_REROUTE) {
+            rerouteEnemy(enemy);
+        }
+        if (actions & ENEMY_THINK_REST) {
+            restEnemy(enemy);
+        }
+    }
+
+    timing->elapsed += SDL_GetPerformanceCounter() - simStart;
+}
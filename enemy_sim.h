@@ -0,0 +1,53 @@
+#ifndef ENEMY_SIM_H
+#define ENEMY_SIM_H
+
+#include <SDL2/SDL.h>
+#include "worker_pool.h"
+#include "enemy.h"
+
+// Enemy systems spread over globalWorkerPool. Active enemies are
+// partitioned by the chunk they stand on, one pool job per non-empty chunk.
+//
+// Movement touches the tiles around an enemy, so the chunks are coloured
+// 2x2 like a checkerboard and the colours run one after another: chunks
+// moved at the same time are never neighbours, and an enemy stepping over
+// its chunk border can only meet enemies of its own job. Thinking only
+// touches the enemy itself and runs all chunks at once. Work that is not
+// local to an enemy - the GPU reroute, which needs the GL context - is
+// deferred to a serial merge phase on the calling thread.
+
+//
+// Thinking is scaled by AI level of detail. Each round, every enemy's tier
+// is set from its tile distance (Chebyshev) to the focus, normally the
+// player, whom the camera follows. Near enemies think every round and are
+// animated; mid enemies think every ENEMY_LOD_MID_ROUNDS rounds and far
+// ones every ENEMY_LOD_FAR_ROUNDS, each in the bucket id % rounds, so the
+// work is spread evenly over the rounds. Far enemies also pick cheaper
+// goals (see MovementAI). All tiers move every tick, along paths they
+// already have, so an enemy changing tier does not jump or stall. The near
+// ring covers the whole view at the widest zoom, so enemies on screen are
+// always at full detail.
+//
+// Enemies resting between goals (EnemyRest) skip thinking altogether until
+// their wake timer fires.
+
+#define ENEMY_SIM_COLORS 4
+
+#define ENEMY_LOD_NEAR_TILES 14
+#define ENEMY_LOD_MID_TILES 24
+#define ENEMY_LOD_HYSTERESIS 2   // Tiles past a ring before dropping to the next tier
+#define ENEMY_LOD_MID_ROUNDS 4
+#define ENEMY_LOD_FAR_ROUNDS 16
+
+typedef struct {
+    Uint64 busy[WORKER_POOL_MAX_THREADS + 1];  // Performance counter ticks spent in jobs, by workerPoolThreadIndex
+    Uint64 elapsed;                            // Wall time spent inside the calls below
+    int threadCount;                           // Entries of busy in use; the last is the calling thread
+    int thinks[ENEMY_LOD_COUNT];               // Enemies that thought this tick, by tier
+} EnemySimTiming;
+
+void resetEnemySimTiming(EnemySimTiming* timing);
+void moveEnemies(EnemySimTiming* timing);
+void thinkEnemies(Uint32 currentTime, int focusX, int focusY, EnemySimTiming* timing);
+
+#endif // ENEMY_SIM_H
@@ -11,12 +11,19 @@
 #include "grid.h"
 #include "gameloop.h"
 #include "pathfinding.h"
+#include "grid_planes.h"
+#include "spatial_hash.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <immintrin.h>
 #include <stdatomic.h>
 
+// Closer than this to the target tile centre snaps onto it (0.02 tiles)
+#define ARRIVAL_EPSILON (WORLD_ONE / 50)
+
+EntityStore entityStore;
+
 /*
  * sgn
  *
@@ -29,6 +36,384 @@ int sgn(float x) {
     return (x > 0) - (x < 0);
 }
 
+// Movement kernel
+// --------------------------------
+// One physics step towards the target tile centre, for MOVE_SIMD_WIDTH
+// entities at a time. Direction, step clamp and the tile conversion run in
+// float/int vector lanes and the walkable bits of crossed tiles are
+// gathered from walkablePlane. The kernel stores the positions of steps
+// that stay inside a tile and returns a mask of the other lanes; anything
+// that touches more state (arrival, a tile change, a blocked step, or an
+// entity outside the grid) is finished per entity by finishMove. moveLane
+// is the scalar reference: every path does the same float operations in
+// the same order, so results are bit-identical.
+
+#if defined(__AVX2__)
+#define MOVE_SIMD_WIDTH 8
+#elif defined(__SSE4_1__)
+#define MOVE_SIMD_WIDTH 4
+#else
+#define MOVE_SIMD_WIDTH 1
+#endif
+
+typedef enum {
+    MOVE_STEPPED,  // Moved within the current tile
+    MOVE_CROSSED,  // Moved onto a walkable neighbouring tile
+    MOVE_ARRIVED,  // Within ARRIVAL_EPSILON of the target: snap onto it
+    MOVE_BLOCKED,  // The step would enter an unwalkable tile
+    MOVE_SLOW      // Outside the grid or stepping over a tile; use moveLane
+} MoveOutcome;
+
+#define ARRIVAL_EPSILON_SQ ((float)ARRIVAL_EPSILON * (float)ARRIVAL_EPSILON)
+#define MOVE_CLAIM_BATCH 64  // Entities whose steps are claimed before moving them
+
+// Walkability of a tile crossing; the step is at most one tile on each axis
+static inline MoveOutcome crossingOutcome(int gridX, int gridY, int newGridX, int newGridY) {
+    if (!planeTest(walkablePlane, newGridX, newGridY)) return MOVE_BLOCKED;
+
+    // Cutting a corner needs at least one of the two sides open
+    if (newGridX != gridX && newGridY != gridY &&
+        !planeTest(walkablePlane, newGridX, gridY) && !planeTest(walkablePlane, gridX, newGridY)) {
+        return MOVE_BLOCKED;
+    }
+    return MOVE_CROSSED;
+}
+
+static MoveOutcome moveLane(int id, WorldCoord* newX, WorldCoord* newY) {
+    WorldCoord posX = atomic_load_explicit(&entityStore.posX[id], memory_order_relaxed);
+    WorldCoord posY = atomic_load_explicit(&entityStore.posY[id], memory_order_relaxed);
+    int targetGridX = atomic_load_explicit(&entityStore.targetGridX[id], memory_order_relaxed);
+    int targetGridY = atomic_load_explicit(&entityStore.targetGridY[id], memory_order_relaxed);
+
+    float dx = (float)(worldFromTile(targetGridX) - posX);
+    float dy = (float)(worldFromTile(targetGridY) - posY);
+    float distanceSq = dx * dx + dy * dy;
+    if (distanceSq < ARRIVAL_EPSILON_SQ) return MOVE_ARRIVED;
+
+    float distance = sqrtf(distanceSq);
+    float speed = (float)entityStore.speed[id];
+    float ratio = (speed < distance ? speed : distance) / distance;
+    *newX = posX + (int32_t)(dx * ratio);
+    *newY = posY + (int32_t)(dy * ratio);
+
+    int gridX = worldToTile(posX), gridY = worldToTile(posY);
+    int newGridX = worldToTile(*newX), newGridY = worldToTile(*newY);
+    if (newGridX == gridX && newGridY == gridY) return MOVE_STEPPED;
+
+    if (!isValid(gridX, gridY) || abs(newGridX - gridX) > 1 || abs(newGridY - gridY) > 1) {
+        return isWalkable(newGridX, newGridY) ? MOVE_CROSSED : MOVE_BLOCKED;
+    }
+    return crossingOutcome(gridX, gridY, newGridX, newGridY);
+}
+
+#if MOVE_SIMD_WIDTH == 8
+// Walkable bit of each lane's tile, gathered from the 32-bit halves of the
+// plane rows; lanes outside `mask` read nothing and yield 0
+static inline __m256i gatherWalkable(__m256i x, __m256i y, __m256i mask) {
+    __m256i bitX = _mm256_add_epi32(x, _mm256_set1_epi32(1));
+    __m256i word = _mm256_add_epi32(_mm256_slli_epi32(_mm256_add_epi32(y, _mm256_set1_epi32(1)), 1),
+                                    _mm256_srli_epi32(bitX, 5));
+    __m256i rows = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int*)walkablePlane,
+                                               word, mask, 4);
+    __m256i bit = _mm256_and_si256(bitX, _mm256_set1_epi32(31));
+    return _mm256_and_si256(_mm256_srlv_epi32(rows, bit), _mm256_set1_epi32(1));
+}
+
+static inline __m256i loadLanes(const void* field, __m256i id, bool contiguous, int first) {
+    if (contiguous) return _mm256_loadu_si256((const __m256i*)((const int*)field + first));
+    return _mm256_i32gather_epi32((const int*)field, id, 4);
+}
+
+static unsigned int moveLanes(const int* ids, WorldCoord* newX, WorldCoord* newY, MoveOutcome* outcome) {
+    // Runs of consecutive ids (the common case) load the store rows directly
+    __m256i id = _mm256_loadu_si256((const __m256i*)ids);
+    __m256i run = _mm256_add_epi32(_mm256_set1_epi32(ids[0]), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    bool contiguous = _mm256_movemask_epi8(_mm256_cmpeq_epi32(id, run)) == -1;
+
+    __m256i posX = loadLanes(entityStore.posX, id, contiguous, ids[0]);
+    __m256i posY = loadLanes(entityStore.posY, id, contiguous, ids[0]);
+    __m256i targetX = loadLanes(entityStore.targetGridX, id, contiguous, ids[0]);
+    __m256i targetY = loadLanes(entityStore.targetGridY, id, contiguous, ids[0]);
+    __m256 speed = _mm256_cvtepi32_ps(loadLanes(entityStore.speed, id, contiguous, ids[0]));
+
+    __m256i half = _mm256_set1_epi32(WORLD_HALF);
+    __m256 dx = _mm256_cvtepi32_ps(_mm256_sub_epi32(
+        _mm256_add_epi32(_mm256_slli_epi32(targetX, WORLD_FRAC_BITS), half), posX));
+    __m256 dy = _mm256_cvtepi32_ps(_mm256_sub_epi32(
+        _mm256_add_epi32(_mm256_slli_epi32(targetY, WORLD_FRAC_BITS), half), posY));
+    __m256 distanceSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+    __m256i arrived = _mm256_castps_si256(
+        _mm256_cmp_ps(distanceSq, _mm256_set1_ps(ARRIVAL_EPSILON_SQ), _CMP_LT_OQ));
+
+    // Arrived lanes may divide by zero here; their result is discarded
+    __m256 distance = _mm256_sqrt_ps(distanceSq);
+    __m256 ratio = _mm256_div_ps(_mm256_min_ps(speed, distance), distance);
+    __m256i nextX = _mm256_add_epi32(posX, _mm256_cvttps_epi32(_mm256_mul_ps(dx, ratio)));
+    __m256i nextY = _mm256_add_epi32(posY, _mm256_cvttps_epi32(_mm256_mul_ps(dy, ratio)));
+
+    __m256i gridX = _mm256_srai_epi32(posX, WORLD_FRAC_BITS);
+    __m256i gridY = _mm256_srai_epi32(posY, WORLD_FRAC_BITS);
+    __m256i nextGridX = _mm256_srai_epi32(nextX, WORLD_FRAC_BITS);
+    __m256i nextGridY = _mm256_srai_epi32(nextY, WORLD_FRAC_BITS);
+    __m256i stepX = _mm256_sub_epi32(nextGridX, gridX);
+    __m256i stepY = _mm256_sub_epi32(nextGridY, gridY);
+
+    __m256i one = _mm256_set1_epi32(1);
+    __m256i minusOne = _mm256_set1_epi32(-1);
+    __m256i gridSize = _mm256_set1_epi32(GRID_SIZE);
+    __m256i inGrid = _mm256_and_si256(
+        _mm256_and_si256(_mm256_cmpgt_epi32(gridX, minusOne), _mm256_cmpgt_epi32(gridSize, gridX)),
+        _mm256_and_si256(_mm256_cmpgt_epi32(gridY, minusOne), _mm256_cmpgt_epi32(gridSize, gridY)));
+    __m256i farStep = _mm256_or_si256(_mm256_cmpgt_epi32(_mm256_abs_epi32(stepX), one),
+                                      _mm256_cmpgt_epi32(_mm256_abs_epi32(stepY), one));
+    __m256i slow = _mm256_andnot_si256(arrived, _mm256_or_si256(farStep, _mm256_andnot_si256(inGrid, minusOne)));
+    __m256i stayed = _mm256_and_si256(_mm256_cmpeq_epi32(stepX, _mm256_setzero_si256()),
+                                      _mm256_cmpeq_epi32(stepY, _mm256_setzero_si256()));
+    __m256i crossing = _mm256_andnot_si256(_mm256_or_si256(stayed, _mm256_or_si256(arrived, slow)), minusOne);
+
+    __m256i result = _mm256_set1_epi32(MOVE_STEPPED);
+
+    // Only crossing lanes are in the grid and one tile away, so only they
+    // gather; most steps stay inside their tile and skip this entirely
+    if (!_mm256_testz_si256(crossing, crossing)) {
+        __m256i open = gatherWalkable(nextGridX, nextGridY, crossing);
+        __m256i diagonal = _mm256_andnot_si256(_mm256_or_si256(_mm256_cmpeq_epi32(stepX, _mm256_setzero_si256()),
+                                                               _mm256_cmpeq_epi32(stepY, _mm256_setzero_si256())),
+                                               crossing);
+        __m256i sideOk = _mm256_andnot_si256(diagonal, minusOne);
+        if (!_mm256_testz_si256(diagonal, diagonal)) {
+            __m256i side = _mm256_or_si256(gatherWalkable(nextGridX, gridY, diagonal),
+                                           gatherWalkable(gridX, nextGridY, diagonal));
+            sideOk = _mm256_or_si256(sideOk, _mm256_cmpeq_epi32(side, one));
+        }
+        __m256i canCross = _mm256_and_si256(_mm256_cmpeq_epi32(open, one), sideOk);
+
+        result = _mm256_blendv_epi8(result, _mm256_set1_epi32(MOVE_BLOCKED), crossing);
+        result = _mm256_blendv_epi8(result, _mm256_set1_epi32(MOVE_CROSSED), _mm256_and_si256(crossing, canCross));
+    }
+    result = _mm256_blendv_epi8(result, _mm256_set1_epi32(MOVE_SLOW), slow);
+    result = _mm256_blendv_epi8(result, _mm256_set1_epi32(MOVE_ARRIVED), arrived);
+
+    // Steps inside a tile are finished here; the rest are left to finishMove
+    __m256i stepped = _mm256_cmpeq_epi32(result, _mm256_set1_epi32(MOVE_STEPPED));
+    if (contiguous) {
+        _mm256_maskstore_epi32((int*)&entityStore.posX[ids[0]], stepped, nextX);
+        _mm256_maskstore_epi32((int*)&entityStore.posY[ids[0]], stepped, nextY);
+    }
+
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*)newX, nextX);
+    _mm256_storeu_si256((__m256i*)newY, nextY);
+    _mm256_storeu_si256((__m256i*)lanes, result);
+    for (int i = 0; i < 8; i++) {
+        outcome[i] = (MoveOutcome)lanes[i];
+    }
+
+    unsigned int steppedMask = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(stepped));
+    if (!contiguous) {
+        for (int i = 0; i < 8; i++) {
+            if (steppedMask & (1u << i)) {
+                atomic_store_explicit(&entityStore.posX[ids[i]], newX[i], memory_order_relaxed);
+                atomic_store_explicit(&entityStore.posY[ids[i]], newY[i], memory_order_relaxed);
+            }
+        }
+    }
+    return ~steppedMask & 0xFFu;
+}
+#elif MOVE_SIMD_WIDTH == 4
+// No gathers before AVX2: the step is vectorised and crossings are
+// classified per lane
+static unsigned int moveLanes(const int* ids, WorldCoord* newX, WorldCoord* newY, MoveOutcome* outcome) {
+    __m128i posX = _mm_set_epi32(entityStore.posX[ids[3]], entityStore.posX[ids[2]],
+                                 entityStore.posX[ids[1]], entityStore.posX[ids[0]]);
+    __m128i posY = _mm_set_epi32(entityStore.posY[ids[3]], entityStore.posY[ids[2]],
+                                 entityStore.posY[ids[1]], entityStore.posY[ids[0]]);
+    __m128i targetX = _mm_set_epi32(entityStore.targetGridX[ids[3]], entityStore.targetGridX[ids[2]],
+                                    entityStore.targetGridX[ids[1]], entityStore.targetGridX[ids[0]]);
+    __m128i targetY = _mm_set_epi32(entityStore.targetGridY[ids[3]], entityStore.targetGridY[ids[2]],
+                                    entityStore.targetGridY[ids[1]], entityStore.targetGridY[ids[0]]);
+    __m128 speed = _mm_cvtepi32_ps(_mm_set_epi32(entityStore.speed[ids[3]], entityStore.speed[ids[2]],
+                                                 entityStore.speed[ids[1]], entityStore.speed[ids[0]]));
+
+    __m128i half = _mm_set1_epi32(WORLD_HALF);
+    __m128 dx = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_add_epi32(_mm_slli_epi32(targetX, WORLD_FRAC_BITS), half), posX));
+    __m128 dy = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_add_epi32(_mm_slli_epi32(targetY, WORLD_FRAC_BITS), half), posY));
+    __m128 distanceSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+    int arrived = _mm_movemask_ps(_mm_cmplt_ps(distanceSq, _mm_set1_ps(ARRIVAL_EPSILON_SQ)));
+
+    __m128 distance = _mm_sqrt_ps(distanceSq);
+    __m128 ratio = _mm_div_ps(_mm_min_ps(speed, distance), distance);
+    _mm_storeu_si128((__m128i*)newX, _mm_add_epi32(posX, _mm_cvttps_epi32(_mm_mul_ps(dx, ratio))));
+    _mm_storeu_si128((__m128i*)newY, _mm_add_epi32(posY, _mm_cvttps_epi32(_mm_mul_ps(dy, ratio))));
+
+    int oldX[4], oldY[4];
+    unsigned int pending = 0;
+    _mm_storeu_si128((__m128i*)oldX, posX);
+    _mm_storeu_si128((__m128i*)oldY, posY);
+    for (int i = 0; i < 4; i++) {
+        int gridX = worldToTile(oldX[i]), gridY = worldToTile(oldY[i]);
+        int newGridX = worldToTile(newX[i]), newGridY = worldToTile(newY[i]);
+
+        if (arrived & (1 << i)) {
+            outcome[i] = MOVE_ARRIVED;
+        } else if (!isValid(gridX, gridY) || abs(newGridX - gridX) > 1 || abs(newGridY - gridY) > 1) {
+            outcome[i] = MOVE_SLOW;
+        } else if (newGridX == gridX && newGridY == gridY) {
+            outcome[i] = MOVE_STEPPED;
+        } else {
+            outcome[i] = crossingOutcome(gridX, gridY, newGridX, newGridY);
+        }
+
+        if (outcome[i] == MOVE_STEPPED) {
+            atomic_store_explicit(&entityStore.posX[ids[i]], newX[i], memory_order_relaxed);
+            atomic_store_explicit(&entityStore.posY[ids[i]], newY[i], memory_order_relaxed);
+        } else {
+            pending |= 1u << i;
+        }
+    }
+    return pending;
+}
+#endif
+
+// Applies a lane's outcome to its entity
+static void finishMove(Entity* entity, MoveOutcome outcome, WorldCoord newX, WorldCoord newY) {
+    int id = entity->id;
+
+    if (outcome == MOVE_SLOW) {
+        outcome = moveLane(id, &newX, &newY);
+    }
+
+    switch (outcome) {
+        case MOVE_ARRIVED: {
+            int targetGridX = atomic_load(&entityStore.targetGridX[id]);
+            int targetGridY = atomic_load(&entityStore.targetGridY[id]);
+            atomic_store(&entityStore.posX[id], worldFromTile(targetGridX));
+            atomic_store(&entityStore.posY[id], worldFromTile(targetGridY));
+            setEntityTile(entity, targetGridX, targetGridY);
+            atomic_store(&entity->needsPathfinding, true);
+            break;
+        }
+        case MOVE_STEPPED:
+            // Positions are only ever read as a snapshot; no ordering needed
+            atomic_store_explicit(&entityStore.posX[id], newX, memory_order_relaxed);
+            atomic_store_explicit(&entityStore.posY[id], newY, memory_order_relaxed);
+            break;
+        case MOVE_CROSSED:
+            atomic_store_explicit(&entityStore.posX[id], newX, memory_order_relaxed);
+            atomic_store_explicit(&entityStore.posY[id], newY, memory_order_relaxed);
+            setEntityTile(entity, worldToTile(newX), worldToTile(newY));
+            break;
+        default:
+            atomic_store(&entity->needsPathfinding, true);
+            break;
+    }
+}
+
+/*
+ * releaseEntityReservation
+ *
+ * Gives up the tile the entity reserved for its next step, if any. Called
+ * when it stops moving for good: suspended, despawned or cleaned up.
+ *
+ * @param[in,out] entity The entity
+ */
+void releaseEntityReservation(Entity* entity) {
+    if (entity->reservedX < 0) return;
+    tileRelease(entity->reservedX, entity->reservedY, entity->id);
+    entity->reservedX = -1;
+    entity->reservedY = -1;
+}
+
+// Reserves the entity's target tile before it steps towards it. A tile
+// that is reserved by someone else, or that an enemy would share with
+// another entity, makes it wait where it is. The player only waits for
+// reservations, so enemies standing still never hold it up. An enemy that
+// waited ENTITY_WAIT_TICKS (two enemies heading onto each other's tiles,
+// say) drops its goal and settles on its tile.
+static bool claimStep(Entity* entity) {
+    int id = entity->id;
+    int gridX = atomic_load(&entity->gridX);
+    int gridY = atomic_load(&entity->gridY);
+    int targetGridX = atomic_load_explicit(&entityStore.targetGridX[id], memory_order_relaxed);
+    int targetGridY = atomic_load_explicit(&entityStore.targetGridY[id], memory_order_relaxed);
+
+    if (targetGridX == entity->reservedX && targetGridY == entity->reservedY) return true;
+    releaseEntityReservation(entity);
+    if (targetGridX == gridX && targetGridY == gridY) return true;  // Centring on its own tile
+
+    // Occupancy is checked after claiming: whoever held the claim before
+    // entered the tile before releasing it, so it is counted by now
+    if (tileReserve(targetGridX, targetGridY, id)) {
+        if (entity->isPlayer || !planeTest(occupiedPlane, targetGridX, targetGridY)) {
+            entity->reservedX = targetGridX;
+            entity->reservedY = targetGridY;
+            entity->waitTicks = 0;
+            return true;
+        }
+        tileRelease(targetGridX, targetGridY, id);
+    }
+
+    if (!entity->isPlayer && ++entity->waitTicks >= ENTITY_WAIT_TICKS) {
+        atomic_store(&entityStore.targetGridX[id], gridX);
+        atomic_store(&entityStore.targetGridY[id], gridY);
+        atomic_store(&entity->finalGoalX, gridX);
+        atomic_store(&entity->finalGoalY, gridY);
+        entity->waitTicks = 0;
+        return true;
+    }
+    return false;
+}
+
+/*
+ * moveEntities
+ *
+ * Advances each entity one physics step towards its target tile, without
+ * touching its path. Entities first reserve the tile they are heading
+ * for; those that cannot wait this step out. The step runs
+ * MOVE_SIMD_WIDTH entities at a time.
+ *
+ * @param[in,out] entities Entities to move
+ * @param[in] count Number of entities
+ */
+void moveEntities(Entity** entities, int count) {
+    Entity* movers[MOVE_CLAIM_BATCH];
+
+    for (int first = 0; first < count; first += MOVE_CLAIM_BATCH) {
+        int batch = count - first < MOVE_CLAIM_BATCH ? count - first : MOVE_CLAIM_BATCH;
+        int moverCount = 0;
+        for (int k = 0; k < batch; k++) {
+            if (claimStep(entities[first + k])) {
+                movers[moverCount++] = entities[first + k];
+            }
+        }
+
+        int i = 0;
+#if MOVE_SIMD_WIDTH > 1
+        for (; i + MOVE_SIMD_WIDTH <= moverCount; i += MOVE_SIMD_WIDTH) {
+            int ids[MOVE_SIMD_WIDTH];
+            WorldCoord newX[MOVE_SIMD_WIDTH], newY[MOVE_SIMD_WIDTH];
+            MoveOutcome outcome[MOVE_SIMD_WIDTH];
+
+            for (int lane = 0; lane < MOVE_SIMD_WIDTH; lane++) {
+                ids[lane] = movers[i + lane]->id;
+            }
+            unsigned int pending = moveLanes(ids, newX, newY, outcome);
+            for (int lane = 0; pending; lane++, pending >>= 1) {
+                if (pending & 1) {
+                    finishMove(movers[i + lane], outcome[lane], newX[lane], newY[lane]);
+                }
+            }
+        }
+#endif
+
+        for (; i < moverCount; i++) {
+            WorldCoord newX = 0, newY = 0;
+            MoveOutcome outcome = moveLane(movers[i]->id, &newX, &newY);
+            finishMove(movers[i], outcome, newX, newY);
+        }
+    }
+}
+
 /*
  * UpdateEntity
  *
@@ -49,60 +434,7 @@ void UpdateEntity(Entity* entity, Entity** allEntities, int entityCount) {
     }
 
     updateEntityPath(entity);
-
-    int currentGridX = atomic_load(&entity->gridX);
-    int currentGridY = atomic_load(&entity->gridY);
-    float currentPosX = entity->posX;  // Direct read for _Atomic float
-    float currentPosY = entity->posY;  // Direct read for _Atomic float
-    int currentTargetGridX = atomic_load(&entity->targetGridX);
-    int currentTargetGridY = atomic_load(&entity->targetGridY);
-
-    float targetScreenX, targetScreenY;
-    WorldToScreenCoords(currentTargetGridX, currentTargetGridY, 0, 0, 1, &targetScreenX, &targetScreenY);
-
-    float dx = targetScreenX - currentPosX;
-    float dy = targetScreenY - currentPosY;
-    float distance = sqrt(dx*dx + dy*dy);
-
-    if (distance < 0.001f) {
-        entity->posX = targetScreenX;  // Direct write for _Atomic float
-        entity->posY = targetScreenY;  // Direct write for _Atomic float
-        atomic_store(&entity->gridX, currentTargetGridX);
-        atomic_store(&entity->gridY, currentTargetGridY);
-        atomic_store(&entity->needsPathfinding, true);
-        return;
-    }
-
-    float moveDistance = fmin(entity->speed, distance);
-    float moveX = (dx / distance) * moveDistance;
-    float moveY = (dy / distance) * moveDistance;
-
-    float newX = currentPosX + moveX;
-    float newY = currentPosY + moveY;
-
-    int newGridX = (int)((newX + 1.0f) * GRID_SIZE / 2);
-    int newGridY = (int)((1.0f - newY) * GRID_SIZE / 2);
-
-    bool canMove = true;
-
-    if (newGridX != currentGridX && newGridY != currentGridY) {
-        if (!isWalkable(newGridX, currentGridY) && !isWalkable(currentGridX, newGridY)) {
-            canMove = false;
-        }
-    }
-
-    if (canMove && !isWalkable(newGridX, newGridY)) {
-        canMove = false;
-    }
-
-    if (canMove) {
-        entity->posX = newX;  // Direct write for _Atomic float
-        entity->posY = newY;  // Direct write for _Atomic float
-        atomic_store(&entity->gridX, newGridX);
-        atomic_store(&entity->gridY, newGridY);
-    } else {
-        atomic_store(&entity->needsPathfinding, true);
-    }
+    moveEntities(&entity, 1);
 }
 
 /*
@@ -126,8 +458,8 @@ void updateEntityPath(Entity* entity) {
     int goalY = atomic_load(&entity->finalGoalY);
 
     if (startX == goalX && startY == goalY) {
-        atomic_store(&entity->targetGridX, startX);
-        atomic_store(&entity->targetGridY, startY);
+        atomic_store(&entityStore.targetGridX[entity->id], startX);
+        atomic_store(&entityStore.targetGridY[entity->id], startY);
         atomic_store(&entity->needsPathfinding, false);
         return;
     }
@@ -135,40 +467,30 @@ void updateEntityPath(Entity* entity) {
     int pathLength;
     Node* path = findPath(startX, startY, goalX, goalY, &pathLength);
     if (path) {
-        // Free the old cached path
-        if (entity->cachedPath) {
-            free(entity->cachedPath);
-        }
-
-        entity->cachedPath = path;
-        entity->cachedPathLength = pathLength;
-        entity->currentPathIndex = 0;
+        setEntityPath(entity, path, pathLength);
 
         if (pathLength > 1) {
-            atomic_store(&entity->targetGridX, entity->cachedPath[1].x);
-            atomic_store(&entity->targetGridY, entity->cachedPath[1].y);
+            atomic_store(&entityStore.targetGridX[entity->id], entity->cachedPath[1].x);
+            atomic_store(&entityStore.targetGridY[entity->id], entity->cachedPath[1].y);
         } else {
-            atomic_store(&entity->targetGridX, entity->cachedPath[0].x);
-            atomic_store(&entity->targetGridY, entity->cachedPath[0].y);
+            atomic_store(&entityStore.targetGridX[entity->id], entity->cachedPath[0].x);
+            atomic_store(&entityStore.targetGridY[entity->id], entity->cachedPath[0].y);
         }
     } else {
-        if (entity->cachedPath) {
-            free(entity->cachedPath);
-            entity->cachedPath = NULL;
-        }
+        setEntityPath(entity, NULL, 0);
         // If no path is found, move towards the goal
         int dx = goalX - startX;
         int dy = goalY - startY;
         if (abs(dx) > abs(dy)) {
-            atomic_store(&entity->targetGridX, startX + (dx > 0 ? 1 : -1));
-            atomic_store(&entity->targetGridY, startY);
+            atomic_store(&entityStore.targetGridX[entity->id], startX + (dx > 0 ? 1 : -1));
+            atomic_store(&entityStore.targetGridY[entity->id], startY);
         } else {
-            atomic_store(&entity->targetGridX, startX);
-            atomic_store(&entity->targetGridY, startY + (dy > 0 ? 1 : -1));
+            atomic_store(&entityStore.targetGridX[entity->id], startX);
+            atomic_store(&entityStore.targetGridY[entity->id], startY + (dy > 0 ? 1 : -1));
         }
-        if (!isWalkable(atomic_load(&entity->targetGridX), atomic_load(&entity->targetGridY))) {
-            atomic_store(&entity->targetGridX, startX);
-            atomic_store(&entity->targetGridY, startY);
+        if (!isWalkable(atomic_load(&entityStore.targetGridX[entity->id]), atomic_load(&entityStore.targetGridY[entity->id]))) {
+            atomic_store(&entityStore.targetGridX[entity->id], startX);
+            atomic_store(&entityStore.targetGridY[entity->id], startY);
         }
     }
 
@@ -177,29 +499,26 @@ void updateEntityPath(Entity* entity) {
 /*
  * findNearestWalkableTile
  *
- * Find the nearest walkable tile to the given position.
+ * Find the nearest walkable tile to the given tile.
  *
- * @param[in] posX X-coordinate of the starting position
- * @param[in] posY Y-coordinate of the starting position
+ * @param[in] tileX X-coordinate of the starting tile
+ * @param[in] tileY Y-coordinate of the starting tile
  * @param[out] nearestX Pointer to store the X-coordinate of the nearest walkable tile
  * @param[out] nearestY Pointer to store the Y-coordinate of the nearest walkable tile
  *
  * @pre nearestX and nearestY are valid pointers
  */
-void findNearestWalkableTile(float posX, float posY, int* nearestX, int* nearestY) {
+void findNearestWalkableTile(int tileX, int tileY, int* nearestX, int* nearestY) {
     if (nearestX == NULL || nearestY == NULL) {
         fprintf(stderr, "Error: NULL pointer passed to findNearestWalkableTile\n");
         return;
     }
 
-    int gridX = (int)((posX + 1.0f) * GRID_SIZE / 2);
-    int gridY = (int)((1.0f - posY) * GRID_SIZE / 2);
-
     for (int radius = 0; radius < GRID_SIZE; radius++) {
         for (int dx = -radius; dx <= radius; dx++) {
             for (int dy = -radius; dy <= radius; dy++) {
-                int nx = gridX + dx;
-                int ny = gridY + dy;
+                int nx = tileX + dx;
+                int ny = tileY + dy;
                 if (isWalkable(nx, ny)) {
                     *nearestX = nx;
                     *nearestY = ny;
@@ -208,4 +527,124 @@ void findNearestWalkableTile(float posX, float posY, int* nearestX, int* nearest
             }
         }
     }
-}
\ No newline at end of file
+}
+
+/*
+ * setEntityTile
+ *
+ * Moves an already placed entity to another tile, keeping the occupancy
+ * plane in step and releasing the tile's reservation once it is on it.
+ *
+ * @param[in,out] entity The entity
+ * @param[in] gridX New tile column
+ * @param[in] gridY New tile row
+ */
+void setEntityTile(Entity* entity, int gridX, int gridY) {
+    int oldX = atomic_load(&entity->gridX);
+    int oldY = atomic_load(&entity->gridY);
+    if (oldX == gridX && oldY == gridY) return;
+
+    atomic_store(&entity->gridX, gridX);
+    atomic_store(&entity->gridY, gridY);
+    occupancyLeave(oldX, oldY);
+    occupancyEnter(gridX, gridY);
+    spatialHashPlace(entity->id, gridX, gridY);
+
+    // Counted by occupiedPlane now, which keeps others off the tile
+    if (gridX == entity->reservedX && gridY == entity->reservedY) {
+        releaseEntityReservation(entity);
+    }
+}
+
+/*
+ * placeEntity
+ *
+ * Puts an entity on a tile after occupancyReset and spatialHashReset,
+ * when nothing counts it anywhere yet. Unlike setEntityTile it always
+ * registers the tile, even the one the entity already stood on, and any
+ * reservation it held is forgotten (the reset cleared the table).
+ *
+ * @param[in,out] entity The entity
+ * @param[in] gridX Tile column
+ * @param[in] gridY Tile row
+ */
+void placeEntity(Entity* entity, int gridX, int gridY) {
+    atomic_store(&entity->gridX, gridX);
+    atomic_store(&entity->gridY, gridY);
+    occupancyEnter(gridX, gridY);
+    spatialHashPlace(entity->id, gridX, gridY);
+
+    entity->reservedX = -1;
+    entity->reservedY = -1;
+    entity->waitTicks = 0;
+}
+
+static inline uint64_t packPathBounds(int minX, int minY, int maxX, int maxY) {
+    return (uint64_t)(uint16_t)minX | ((uint64_t)(uint16_t)minY << 16) |
+           ((uint64_t)(uint16_t)maxX << 32) | ((uint64_t)(uint16_t)maxY << 48);
+}
+
+/*
+ * setEntityPath
+ *
+ * Replaces the entity's cached path, taking ownership of the new one, and
+ * records its bounding box for change-event invalidation.
+ *
+ * @param[in,out] entity The entity
+ * @param[in] path New path (malloc'd), or NULL to clear
+ * @param[in] pathLength Number of nodes in path
+ */
+void setEntityPath(Entity* entity, Node* path, int pathLength) {
+    if (entity->cachedPath && entity->cachedPath != path) {
+        free(entity->cachedPath);
+    }
+
+    entity->cachedPath = path;
+    entity->cachedPathLength = path ? pathLength : 0;
+    entity->currentPathIndex = 0;
+
+    uint64_t bounds = PATH_BOUNDS_NONE;
+    if (path && pathLength > 0) {
+        int minX = path[0].x, maxX = path[0].x;
+        int minY = path[0].y, maxY = path[0].y;
+        for (int i = 1; i < pathLength; i++) {
+            if (path[i].x < minX) minX = path[i].x;
+            if (path[i].x > maxX) maxX = path[i].x;
+            if (path[i].y < minY) minY = path[i].y;
+            if (path[i].y > maxY) maxY = path[i].y;
+        }
+        bounds = packPathBounds(minX, minY, maxX, maxY);
+    }
+    atomic_store(&entity->pathBounds, bounds);
+    atomic_store(&entity->pathInvalidated, false);
+}
+
+/*
+ * invalidateEntityPaths
+ *
+ * Flags every entity whose cached path overlaps a changed region so its
+ * owner re-plans on the next update. Only touches atomics, so it is safe to
+ * call from the thread publishing the grid change.
+ *
+ * @param[in] entities Entity array (NULL entries are skipped)
+ * @param[in] entityCount Number of entries in entities
+ * @param[in] rect Changed region
+ */
+void invalidateEntityPaths(Entity** entities, int entityCount, const GridRect* rect) {
+    for (int i = 0; i < entityCount; i++) {
+        Entity* entity = entities[i];
+        if (!entity) continue;
+
+        uint64_t bounds = atomic_load(&entity->pathBounds);
+        if (bounds == PATH_BOUNDS_NONE) continue;
+
+        GridRect pathRect = {
+            (int)(bounds & 0xFFFF), (int)((bounds >> 16) & 0xFFFF),
+            (int)((bounds >> 32) & 0xFFFF), (int)((bounds >> 48) & 0xFFFF)
+        };
+        if (gridRectsOverlap(&pathRect, rect)) {
+            atomic_store(&entity->pathInvalidated, true);
+            atomic_store(&entity->needsPathfinding, true);
+        }
+    }
+}
@@ -2,32 +2,72 @@
 #define ENTITY_H
 
 #include "grid.h"
+#include "grid_edit.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdatomic.h>
 
+// pathBounds value for an entity without a cached path
+#define PATH_BOUNDS_NONE UINT64_MAX
+
+// Physics ticks an enemy waits for a reserved or occupied tile before it
+// gives up on its goal; longer than one step takes at MOVE_SPEED
+#define ENTITY_WAIT_TICKS 128
+
+// Entity ids are handed out by the entity pool (entity_pool.h). The per-id
+// arrays are sized for the pool's capacity; loops only walk up to
+// entityPoolSpan().
+#define MAX_ENTITIES 32768
+#define MAX_ENEMIES (MAX_ENTITIES - 1)
+#define INITIAL_ENEMIES 80  // Spawned with a new game
+#define PLAYER_ENTITY_ID 0  // Enemy i has id i + 1, as in allEntities
+
 // Forward declaration
 struct Node;
 
+// Per-frame entity state, one array per field and indexed by Entity.id, so
+// the movement, culling and batching loops stream over dense arrays.
+// Pathfinding and bookkeeping state stays in Entity.
+typedef struct {
+    _Atomic WorldCoord posX[MAX_ENTITIES];       // 16.16 tiles, see grid.h
+    _Atomic WorldCoord posY[MAX_ENTITIES];
+    atomic_int targetGridX[MAX_ENTITIES];        // Tile being moved onto
+    atomic_int targetGridY[MAX_ENTITIES];
+    WorldCoord speed[MAX_ENTITIES];              // 16.16 tiles per physics tick
+    uint8_t animFrame[MAX_ENTITIES];
+    uint8_t facing[MAX_ENTITIES];                // EnemyDirection / PlayerDirection
+    bool isMoving[MAX_ENTITIES];
+    uint32_t lastFrameUpdate[MAX_ENTITIES];      // SDL ticks of the last frame change
+} EntityStore;
+
+extern EntityStore entityStore;
+
 typedef struct {
+    int id;                        // Slot in entityStore
     atomic_int gridX;
     atomic_int gridY;
-    _Atomic float posX;
-    _Atomic float posY;
-    float speed;
-    atomic_int targetGridX;
-    atomic_int targetGridY;
     atomic_int finalGoalX;
     atomic_int finalGoalY;
     atomic_bool needsPathfinding;
     struct Node* cachedPath;
     int cachedPathLength;
     int currentPathIndex;
+    _Atomic uint64_t pathBounds;   // Bounding box of cachedPath, 16 bits per edge
+    atomic_bool pathInvalidated;   // Walkability changed somewhere under cachedPath
+    int reservedX, reservedY;      // Tile reserved for the next step, -1 if none
+    int waitTicks;                 // Ticks spent waiting for the next tile
     bool isPlayer;
     
 } Entity;
 
-void findNearestWalkableTile(float posX, float posY, int* nearestX, int* nearestY);
+void findNearestWalkableTile(int tileX, int tileY, int* nearestX, int* nearestY);
 void UpdateEntity(Entity* entity, Entity** allEntities, int entityCount);
+void moveEntities(Entity** entities, int count);
 void updateEntityPath(Entity* entity);
+void setEntityTile(Entity* entity, int gridX, int gridY);
+void placeEntity(Entity* entity, int gridX, int gridY);
+void releaseEntityReservation(Entity* entity);
+void setEntityPath(Entity* entity, struct Node* path, int pathLength);
+void invalidateEntityPaths(Entity** entities, int entityCount, const GridRect* rect);
 
 #endif // ENTITY_H
\ No newline at end of file
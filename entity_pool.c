@@ -0,0 +1,136 @@
+// entity_pool.c
+#include "entity_pool.h"
+#include <stdio.h>
+#include <stdatomic.h>
+#include <SDL2/SDL.h>
+
+// Generations count from 1 and skip 0, so (id 0, generation 0) - the value
+// of ENTITY_HANDLE_NONE - is never a live handle
+static _Atomic uint16_t generation[MAX_ENTITIES];
+static atomic_bool live[MAX_ENTITIES];
+static int nextFree[MAX_ENTITIES];
+static int freeHead = -1;
+static atomic_int liveCount;
+static atomic_int span;
+static SDL_SpinLock poolLock;  // Guards the free list and span growth
+
+static inline EntityHandle makeHandle(int id, uint16_t gen) {
+    return (EntityHandle)gen << ENTITY_INDEX_BITS | (EntityHandle)id;
+}
+
+/*
+ * resetEntityPool
+ *
+ * Frees every id and reserves PLAYER_ENTITY_ID for the player. Handles
+ * taken before the reset no longer resolve. Called before entities are
+ * (re)spawned.
+ */
+void resetEntityPool(void) {
+    SDL_AtomicLock(&poolLock);
+    // Ids go on the free list in descending order, so spawns hand out the
+    // lowest ids first
+    freeHead = -1;
+    for (int id = MAX_ENTITIES - 1; id >= 0; id--) {
+        if (atomic_load(&live[id])) {
+            uint16_t gen = atomic_load(&generation[id]) + 1;
+            atomic_store(&generation[id], gen ? gen : 1);
+            atomic_store(&live[id], false);
+        } else if (atomic_load(&generation[id]) == 0) {
+            atomic_store(&generation[id], 1);
+        }
+        if (id != PLAYER_ENTITY_ID) {
+            nextFree[id] = freeHead;
+            freeHead = id;
+        }
+    }
+    atomic_store(&live[PLAYER_ENTITY_ID], true);
+    atomic_store(&liveCount, 1);
+    atomic_store(&span, PLAYER_ENTITY_ID + 1);
+    SDL_AtomicUnlock(&poolLock);
+}
+
+/*
+ * entityPoolSpawn
+ *
+ * Takes a free id. The caller initializes its entityStore slot.
+ *
+ * @return EntityHandle Handle of the new entity, or ENTITY_HANDLE_NONE if
+ *                      all MAX_ENTITIES ids are in use
+ */
+EntityHandle entityPoolSpawn(void) {
+    SDL_AtomicLock(&poolLock);
+    int id = freeHead;
+    if (id < 0) {
+        SDL_AtomicUnlock(&poolLock);
+        fprintf(stderr, "Entity pool is full (%d entities)\n", MAX_ENTITIES);
+        return ENTITY_HANDLE_NONE;
+    }
+    freeHead = nextFree[id];
+    atomic_store(&live[id], true);
+    atomic_fetch_add(&liveCount, 1);
+    if (id >= atomic_load(&span)) {
+        atomic_store(&span, id + 1);
+    }
+    EntityHandle handle = makeHandle(id, atomic_load(&generation[id]));
+    SDL_AtomicUnlock(&poolLock);
+    return handle;
+}
+
+/*
+ * entityPoolDespawn
+ *
+ * Frees the entity's id and bumps its generation, so every handle to it
+ * goes stale. The span does not shrink; the id is reused by a later spawn.
+ *
+ * @param[in] handle Entity to free
+ * @return bool False if the handle was already stale
+ */
+bool entityPoolDespawn(EntityHandle handle) {
+    int id = (int)(handle & ENTITY_INDEX_MASK);
+    if (id == PLAYER_ENTITY_ID || id >= MAX_ENTITIES) return false;
+
+    SDL_AtomicLock(&poolLock);
+    uint16_t gen = atomic_load(&generation[id]);
+    if (!atomic_load(&live[id]) || makeHandle(id, gen) != handle) {
+        SDL_AtomicUnlock(&poolLock);
+        return false;
+    }
+    gen++;
+    atomic_store(&generation[id], gen ? gen : 1);
+    atomic_store(&live[id], false);
+    atomic_fetch_sub(&liveCount, 1);
+    nextFree[id] = freeHead;
+    freeHead = id;
+    SDL_AtomicUnlock(&poolLock);
+    return true;
+}
+
+/*
+ * entityPoolResolve
+ *
+ * @param[in] handle Handle to look up
+ * @return int The entity's id, or -1 if it was despawned
+ */
+int entityPoolResolve(EntityHandle handle) {
+    int id = (int)(handle & ENTITY_INDEX_MASK);
+    if (id >= MAX_ENTITIES || !atomic_load(&live[id])) return -1;
+    return makeHandle(id, atomic_load(&generation[id])) == handle ? id : -1;
+}
+
+EntityHandle entityPoolHandle(int id) {
+    if (id < 0 || id >= MAX_ENTITIES || !atomic_load(&live[id])) return ENTITY_HANDLE_NONE;
+    return makeHandle(id, atomic_load(&generation[id]));
+}
+
+bool entityPoolIsLive(int id) {
+    return id >= 0 && id < MAX_ENTITIES && atomic_load(&live[id]);
+}
+
+int entityPoolCount(void) {
+    return atomic_load(&liveCount);
+}
+
+// One past the highest id handed out since the last reset
+int entityPoolSpan(void) {
+    return atomic_load(&span);
+}
@@ -0,0 +1,37 @@
+#ifndef ENTITY_POOL_H
+#define ENTITY_POOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "entity.h"
+
+// Allocates entity ids (slots in entityStore and allEntities) at runtime.
+// Freed ids go on a free list and are reused, so the live ids stay packed
+// below entityPoolSpan(); loops over entities walk ids 0 to span - 1 in
+// order, which is also the order of the SoA arrays they read.
+//
+// References that may outlive an entity hold an EntityHandle instead of
+// the id: the id plus the slot's generation, which changes every time the
+// slot is freed. A handle to a despawned entity never resolves, even after
+// its id has been reused.
+//
+// Id PLAYER_ENTITY_ID is reserved for the player on reset.
+
+typedef uint32_t EntityHandle;
+
+#define ENTITY_INDEX_BITS 16
+#define ENTITY_INDEX_MASK ((1u << ENTITY_INDEX_BITS) - 1)
+#define ENTITY_HANDLE_NONE 0u  // Never returned for a live entity
+
+_Static_assert(MAX_ENTITIES <= (1 << ENTITY_INDEX_BITS), "Entity ids must fit the handle index");
+
+void resetEntityPool(void);
+EntityHandle entityPoolSpawn(void);
+bool entityPoolDespawn(EntityHandle handle);
+int entityPoolResolve(EntityHandle handle);
+EntityHandle entityPoolHandle(int id);
+bool entityPoolIsLive(int id);
+int entityPoolCount(void);
+int entityPoolSpan(void);
+
+#endif // ENTITY_POOL_H
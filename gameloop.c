@@ -3,6 +3,7 @@
 #include "gameloop.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <immintrin.h>
 #include <SDL2/SDL.h>
@@ -24,6 +25,22 @@
 #include "texture_coords.h"
 #include "storage.h"
 #include "overlay.h"
+#include "worker_pool.h"
+#include "grid_edit.h"
+#include "world_commands.h"
+#include "chunk_pool.h"
+#include "grid_planes.h"
+#include "map_stream.h"
+#include "grid_summary.h"
+#include "region_sat.h"
+#include "enemy_residency.h"
+#include "enemy_sim.h"
+#include "scheduler.h"
+#include "sim_snapshot.h"
+#include "chunk_catchup.h"
+#include "spatial_hash.h"
+#include "entity_pool.h"
+#include "world_timers.h"
 #define UNWALKABLE_PROBABILITY 0.04f
 GLuint outlineShaderProgram;
 atomic_bool isRunning = true;
@@ -45,9 +62,10 @@ Enemy enemies[MAX_ENEMIES];
 atomic_int physics_load = ATOMIC_VAR_INIT(0);
 Uint32 FRAME_TIME_MS = 24;
 atomic_uint game_ticks = ATOMIC_VAR_INIT(0);  
+bool proceduralWorld = false;  // Generate terrain from worldSeed instead of a map file
+const char* mapPath = "testmap.txt";  // Map streamed into new and loaded games
 // Function declarations
 void setGridSize(int size);
-void generateTerrain();
 void RenderEntities(float cameraOffsetX, float cameraOffsetY, float zoomFactor);
 GLuint loadTexture(const char* filePath);  // New texture loading function
 StructureType currentStructureType = STRUCTURE_WALL;
@@ -84,6 +102,10 @@ void WorldToScreenCoords(int gridX, int gridY, float cameraOffsetX, float camera
     *screenX = (2.0f * gridX / GRID_SIZE - 1.0f + 1.0f / GRID_SIZE - cameraOffsetX) * zoomFactor;
     *screenY = (1.0f - 2.0f * gridY / GRID_SIZE - 1.0f / GRID_SIZE - cameraOffsetY) * zoomFactor;
 }
+// Held by the physics thread for the length of each tick, so the main
+// thread can stop it between ticks to save or reload
+static SDL_mutex* physicsTickLock;
+
 /*
  * GameLoop
  *
@@ -93,18 +115,16 @@ void GameLoop() {
     Initialize();
     printf("Entering main game loop.\n");
 
+    physicsTickLock = SDL_CreateMutex();
+    if (!physicsTickLock) {
+        fprintf(stderr, "Failed to create physics tick lock: %s\n", SDL_GetError());
+    }
     SDL_Thread* physicsThread = SDL_CreateThread(PhysicsLoop, "PhysicsThread", NULL);
-    Uint32 lastLogicTick = SDL_GetTicks();
     Uint32 lastRenderTick = SDL_GetTicks();
 
     while (atomic_load(&isRunning)) {
         Uint32 currentTick = SDL_GetTicks();
 
-        if ((currentTick - lastLogicTick) >= GAME_LOGIC_INTERVAL_MS) {
-            UpdateGameLogic();
-            lastLogicTick = currentTick;
-        }
-
         // Check physics load
         int current_load = atomic_load(&physics_load);
         if (current_load > 80) { // If physics is using more than 80% of its time
@@ -124,9 +144,18 @@ void GameLoop() {
     }
 
     SDL_WaitThread(physicsThread, NULL);
+    SDL_DestroyMutex(physicsTickLock);
+    physicsTickLock = NULL;
     CleanUp();
 }
 
+// Chunk stream callback. Enemies resume before the chunk catches up, so
+// regrowth avoids the tiles they stand on.
+static void onChunkStreamed(int chunkX, int chunkY, bool loaded) {
+    enemyChunkStreamed(chunkX, chunkY, loaded);
+    chunkCatchUpStreamed(chunkX, chunkY, loaded);
+}
+
 /*
  * Initialize
  *
@@ -137,11 +166,35 @@ void Initialize(void) {
     InitializeGameState(true);  // true = new game
 }
 
+// Re-plan cached paths that cross tiles whose walkability changed
+static void onGridWalkabilityChanged(const GridChangeEvent* event, void* userData) {
+    (void)userData;
+    invalidateEntityPaths(allEntities, entityPoolSpan(), &event->rect);
+}
+
 void InitializeGameState(bool isNewGame) {
    printf("Initializing game state...\n");
 
+   initWorldCommands();
+   occupancyReset();
+   spatialHashReset();
+   setChunkStreamCallback(NULL);  // No enemies to suspend until they spawn
+
+   static bool gridListenersRegistered = false;
+   if (!gridListenersRegistered) {
+       gridAddChangeListener(onGridWalkabilityChanged, GRID_CHANGE_WALKABLE, NULL);
+       gridListenersRegistered = true;
+   }
+
    setGridSize(40);
 
+   // Streaming keeps at most MAX_LOADED_CHUNKS alive; reserve and touch
+   // them now so crossing chunk borders never hits the system allocator
+   if (!initChunkPool(&globalChunkPool, MAX_LOADED_CHUNKS, true)) {
+       fprintf(stderr, "Failed to reserve chunk pool\n");
+       exit(1);
+   }
+
    globalChunkManager = (ChunkManager*)malloc(sizeof(ChunkManager));
    if (!globalChunkManager) {
        fprintf(stderr, "Failed to allocate chunk manager\n");
@@ -155,134 +208,89 @@ void InitializeGameState(bool isNewGame) {
 
     initStorageManager(&globalStorageManager);
     printf("Storage manager initialized.\n");
-   if (isNewGame) {
-       // Load and apply ASCII map first
-       char* asciiMap = loadASCIIMap("testmap.txt");
-       if (!asciiMap) {
-           fprintf(stderr, "Failed to load test map!\n");
-           exit(1);
-       }
-       printf("ASCII map loaded successfully.\n");
-
-       // Generate terrain from ASCII map
-       generateTerrainFromASCII(asciiMap);
-       printf("Terrain generated from ASCII map.\n");
-
-       // First initialize base grid properties 
-       for (int y = 0; y < GRID_SIZE; y++) {
-           for (int x = 0; x < GRID_SIZE; x++) {
-               // Don't touch terrainType, it's already set
-               grid[y][x].structureType = 0;
-               grid[y][x].materialType = 0;
-               grid[y][x].biomeType = BIOME_PLAINS;  // This should probably be based on terrain type
-               GRIDCELL_SET_WALKABLE(grid[y][x], grid[y][x].terrainType != TERRAIN_WATER);
-               GRIDCELL_SET_ORIENTATION(grid[y][x], 0);
-               grid[y][x].wallTexX = 0.0f;
-               grid[y][x].wallTexY = 0.0f;
-           }
+    if (!initWorkerPool(&globalWorkerPool, 0)) {
+        fprintf(stderr, "Worker pool unavailable, generating on the calling thread\n");
+    }
+   // Terrain streams in chunk by chunk from the map, unless a procedural
+   // world was requested. Loaded games keep the source for chunks the save
+   // has no data for.
+   closeMapSource(activeMapSource);
+   activeMapSource = NULL;
+   if (!proceduralWorld) {
+       activeMapSource = openMapSource(mapPath);
+       if (!activeMapSource) {
+           fprintf(stderr, "Failed to open %s, falling back to procedural terrain\n", mapPath);
+           proceduralWorld = true;
        }
+   }
 
-       // Initialize entities
-       int playerGridX = GRID_SIZE / 2;
-       int playerGridY = GRID_SIZE / 2;
-       InitPlayer(&player, playerGridX, playerGridY, MOVE_SPEED);
-       printf("Player initialized at (%d, %d).\n", playerGridX, playerGridY);
-
-       // First store all current terrain data
-       for (int cy = 0; cy < NUM_CHUNKS; cy++) {
-           for (int cx = 0; cx < NUM_CHUNKS; cx++) {
-               int startX = cx * CHUNK_SIZE;
-               int startY = cy * CHUNK_SIZE;
-               
-               for (int y = 0; y < CHUNK_SIZE; y++) {
-                   for (int x = 0; x < CHUNK_SIZE; x++) {
-                       int gridX = startX + x;
-                       int gridY = startY + y;
-                       if (gridX >= 0 && gridX < GRID_SIZE && 
-                           gridY >= 0 && gridY < GRID_SIZE) {
-                           globalChunkManager->storedChunkData[cy][cx][y][x] = grid[gridY][gridX];
-                       }
-                   }
-               }
-               globalChunkManager->chunkHasData[cy][cx] = true;
-           }
-       }
+   // Nothing of the previous world survives; a loaded game writes its
+   // structures next, and its terrain streams in around the saved player
+   // position on the first physics tick
+   markGridUnloaded();
 
-       // THEN initialize and load chunks after base grid is set up
-       ChunkCoord playerStartChunk = getChunkFromWorldPos(player.entity.gridX, player.entity.gridY);
-       globalChunkManager->playerChunk = playerStartChunk;
+   if (isNewGame) {
+       // Only the chunks around the spawn point are read now; the rest of
+       // the map stays unloaded until the player gets near it. Generated
+       // chunks clear the spawn area themselves.
+       int playerGridX = WORLD_SPAWN_X;
+       int playerGridY = WORLD_SPAWN_Y;
+       globalChunkManager->playerChunk = getChunkFromTile(playerGridX, playerGridY);
        loadChunksAroundPlayer(globalChunkManager);
        printf("Initial chunks loaded around player.\n");
+
+       // Initialize entities
+       InitPlayer(&player, playerGridX, playerGridY, MOVE_SPEED);
+       printf("Player initialized at (%d, %d).\n", playerGridX, playerGridY);
    }
 
    // Initialize entity array first
+   resetEntityPool();
+   resetWorldTimers();
    allEntities[0] = &player.entity;
    for(int i = 1; i < MAX_ENTITIES; i++) {
        allEntities[i] = NULL;
    }
 
    // Spawn ferns on grass tiles first
-// Spawn ferns and trees on grass tiles
+// Spawn ferns and trees on grass tiles, skipping unloaded and grassless chunks
+bool chunkHasGrass[NUM_CHUNKS][NUM_CHUNKS];
+for (int cy = 0; cy < NUM_CHUNKS; cy++) {
+    for (int cx = 0; cx < NUM_CHUNKS; cx++) {
+        chunkHasGrass[cy][cx] = getChunkSummary(cx, cy).grassCells != 0 &&
+                                isChunkLoaded(globalChunkManager, cx, cy);
+    }
+}
+gridBeginBatch();
 for (int y = 0; y < GRID_SIZE; y++) {
     for (int x = 0; x < GRID_SIZE; x++) {
-        if (isPositionInLoadedChunk(x, y)) {
-            if (grid[y][x].terrainType == (uint8_t)TERRAIN_GRASS) {
-                float random = (float)rand() / RAND_MAX;
-                if (random < 0.1f) {  // 10% chance for fern
-                    grid[y][x].structureType = STRUCTURE_PLANT;
-                    grid[y][x].materialType = MATERIAL_FERN;
-                    GRIDCELL_SET_WALKABLE(grid[y][x], false);
+        if (!chunkHasGrass[y / CHUNK_SIZE][x / CHUNK_SIZE]) {
+            x += CHUNK_SIZE - 1 - x % CHUNK_SIZE;
+            continue;
+        }
+        if (grid[y][x].terrainType == (uint8_t)TERRAIN_GRASS) {
+            float random = (float)rand() / RAND_MAX;
+            if (random < 0.1f) {  // 10% chance for fern
+                gridSetStructure(x, y, STRUCTURE_PLANT, MATERIAL_FERN);
+                gridSetWalkable(x, y, false);
 
-                }
-                else if (random < 0.15f) {  // Additional 5% chance for tree
-                    grid[y][x].structureType = STRUCTURE_PLANT;
-                    grid[y][x].materialType = MATERIAL_TREE;
-                    GRIDCELL_SET_WALKABLE(grid[y][x], false);
-                }
+            }
+            else if (random < 0.15f) {  // Additional 5% chance for tree
+                gridSetStructure(x, y, STRUCTURE_PLANT, MATERIAL_TREE);
+                gridSetWalkable(x, y, false);
             }
         }
     }
 }
+gridEndBatch();
 
-   printf("\n=== Starting Entity Initialization ===\n");
-   printf("MAX_ENEMIES: %d\n", MAX_ENEMIES);
-   printf("MAX_ENTITIES: %d\n", MAX_ENTITIES);
-
-   printf("Player entity pointer stored at allEntities[0]: %p\n", (void*)allEntities[0]);
-
-   // Then initialize enemies
-   for (int i = 0; i < MAX_ENEMIES; i++) {
-       int enemyGridX, enemyGridY;
-       int attempts = 0;
-       const int MAX_ATTEMPTS = 1000;
-       bool validPosition = false;
-       
-       do {
-           enemyGridX = rand() % GRID_SIZE;
-           enemyGridY = rand() % GRID_SIZE;
-           attempts++;
-           
-           if (isPositionInLoadedChunk(enemyGridX, enemyGridY) &&
-               grid[enemyGridY][enemyGridX].structureType != STRUCTURE_WALL &&
-               grid[enemyGridY][enemyGridX].structureType != STRUCTURE_PLANT &&
-               GRIDCELL_IS_WALKABLE(grid[enemyGridY][enemyGridX])) {
-               validPosition = true;
-           }
-           
-           if (attempts >= MAX_ATTEMPTS) {
-               fprintf(stderr, "Warning: Could not find valid spawn location for enemy %d after %d attempts\n", 
-                       i, MAX_ATTEMPTS);
-               enemyGridX = player.entity.gridX + (rand() % 3) - 1;
-               enemyGridY = player.entity.gridY + (rand() % 3) - 1;
-               break;
-           }
-       } while (!validPosition);
-
-       InitEnemy(&enemies[i], enemyGridX, enemyGridY, MOVE_SPEED);
-       allEntities[i + 1] = &enemies[i].entity;
+   // A loaded game spawns its enemies once the saved player position has
+   // streamed in (FinishGameLoad)
+   if (isNewGame) {
+       InitializeEnemies();
    }
 
-   ChunkCoord playerChunk = getChunkFromWorldPos(player.entity.gridX, player.entity.gridY);
+   ChunkCoord playerChunk = getChunkFromTile(player.entity.gridX, player.entity.gridY);
    int radius = globalChunkManager->loadRadius;
    
    printf("\n=== Final Chunk Check ===\n");
@@ -290,6 +298,7 @@ for (int y = 0; y < GRID_SIZE; y++) {
    printf("Load radius: %d\n", radius);
    
    // Final culling of chunks outside radius
+   gridBeginBatch();
    for (int cy = 0; cy < NUM_CHUNKS; cy++) {
        for (int cx = 0; cx < NUM_CHUNKS; cx++) {
            int dx = abs(cx - playerChunk.x);
@@ -305,8 +314,8 @@ for (int y = 0; y < GRID_SIZE; y++) {
                        int gridY = startY + y;
                        if (gridX >= 0 && gridX < GRID_SIZE && 
                            gridY >= 0 && gridY < GRID_SIZE) {
-                           grid[gridY][gridX].terrainType = (uint8_t)TERRAIN_UNLOADED;
-                           GRIDCELL_SET_WALKABLE(grid[gridY][gridX], false);
+                           gridSetTerrain(gridX, gridY, TERRAIN_UNLOADED);
+                           gridSetWalkable(gridX, gridY, false);
                        }
                    }
                }
@@ -314,10 +323,70 @@ for (int y = 0; y < GRID_SIZE; y++) {
        }
    }
    
+   gridEndBatch();
    printf("Initial chunk culling complete.\n");
    printf("Game state initialization complete.\n");
 }
 
+/*
+ * InitializeEnemies
+ *
+ * Spawns the starting enemies on clear tiles of the chunks loaded around
+ * the player, then lets them follow chunk streaming.
+ */
+void InitializeEnemies(void) {
+    printf("\n=== Starting Entity Initialization ===\n");
+    printf("INITIAL_ENEMIES: %d\n", INITIAL_ENEMIES);
+    printf("MAX_ENTITIES: %d\n", MAX_ENTITIES);
+
+    printf("Player entity pointer stored at allEntities[0]: %p\n", (void*)allEntities[0]);
+
+    // Enemies start on clear tiles of the loaded area. Unloaded cells are
+    // never walkable, so the chunk box around the player is enough.
+    ChunkCoord spawnChunk = globalChunkManager->playerChunk;
+    int spawnRadius = globalChunkManager->loadRadius;
+    int spawnMinX = (spawnChunk.x - spawnRadius) * CHUNK_SIZE;
+    int spawnMinY = (spawnChunk.y - spawnRadius) * CHUNK_SIZE;
+    int spawnMaxX = (spawnChunk.x + spawnRadius + 1) * CHUNK_SIZE - 1;
+    int spawnMaxY = (spawnChunk.y + spawnRadius + 1) * CHUNK_SIZE - 1;
+
+    for (int i = 0; i < INITIAL_ENEMIES; i++) {
+        int enemyGridX, enemyGridY;
+
+        if (!regionPickTile(SAT_CLEAR, spawnMinX, spawnMinY, spawnMaxX, spawnMaxY,
+                            (unsigned int)rand(), &enemyGridX, &enemyGridY)) {
+            fprintf(stderr, "Warning: No clear spawn location for enemy %d\n", i);
+            enemyGridX = player.entity.gridX + (rand() % 3) - 1;
+            enemyGridY = player.entity.gridY + (rand() % 3) - 1;
+        }
+
+        int id = entityPoolResolve(entityPoolSpawn());
+        if (id < 0) break;
+        InitEnemy(&enemies[id - 1], id, enemyGridX, enemyGridY, MOVE_SPEED);
+        allEntities[id] = &enemies[id - 1].entity;
+    }
+
+    // From here on enemies follow their chunk in and out of the grid
+    rebuildEnemyResidency();
+    resetChunkCatchUp();
+    resetSimSnapshots();
+    setChunkStreamCallback(onChunkStreamed);
+}
+
+/*
+ * FinishGameLoad
+ *
+ * Completes a load once loadGameState has placed the player: streams in
+ * the chunks around the saved position and spawns the enemies there.
+ */
+void FinishGameLoad(void) {
+    WorldCoord playerX = atomic_load(&entityStore.posX[player.entity.id]);
+    WorldCoord playerY = atomic_load(&entityStore.posY[player.entity.id]);
+    updatePlayerChunk(globalChunkManager, playerX, playerY);
+    loadChunksAroundPlayer(globalChunkManager);
+    InitializeEnemies();
+}
+
 void InitializeEngine(void) {
     printf("Initializing engine systems...\n");
     
@@ -471,15 +540,28 @@ void InitializeEngine(void) {
 }
 
 void CleanupEntities() {
-    for (int i = 0; i < MAX_ENTITIES; i++) {
-        if (allEntities[i]) {
-            if (i == 0) {  // The player is always at index 0
-                CleanupPlayer(&player);
-            } else {  // Enemies are from index 1 to MAX_ENEMIES
-                CleanupEnemy(&enemies[i - 1]);
-            }
-            allEntities[i] = NULL;
-        }
+    if (allEntities[0]) {  // The player is always at index 0
+        CleanupPlayer(&player);
+        allEntities[0] = NULL;
+    }
+    CleanupEnemies();
+}
+
+/*
+ * CleanupEnemies
+ *
+ * Frees every enemy, active or suspended, and leaves the player alone so
+ * a reload keeps its inventory.
+ */
+void CleanupEnemies(void) {
+    setChunkStreamCallback(NULL);
+
+    // Suspended enemies have no allEntities slot, so go by the pool
+    int span = entityPoolSpan();
+    for (int id = PLAYER_ENTITY_ID + 1; id < span; id++) {
+        if (!entityPoolIsLive(id)) continue;
+        CleanupEnemy(&enemies[id - 1]);
+        allEntities[id] = NULL;
     }
 }
 
@@ -487,13 +569,61 @@ bool LoadGame(const char* filename) {
     printf("START LoadGame sequence\n");
     InitializeEngine();
     printf("After InitializeEngine\n");
+    readSaveWorldSource(filename);  // Terrain must come from the saved world
     InitializeGameState(false);  // false = loading save
     printf("After InitializeGameState\n");
     bool result = loadGameState(filename);
+    FinishGameLoad();
+    resetSimSnapshots();  // The player was just moved to the saved spot
     printf("After loadGameState\n");
     return result;
 }
 
+/*
+ * SaveGame
+ *
+ * Saves the running game between two physics ticks, so the file holds one
+ * consistent tick. Main thread only.
+ *
+ * @param[in] filename Save file to write
+ * @return bool True if the game was saved
+ */
+bool SaveGame(const char* filename) {
+    if (!physicsTickLock || SDL_LockMutex(physicsTickLock) != 0) {
+        fprintf(stderr, "Cannot pause physics to save\n");
+        return false;
+    }
+    bool saved = saveGameState(filename);
+    SDL_UnlockMutex(physicsTickLock);
+    return saved;
+}
+
+/*
+ * ReloadGame
+ *
+ * Replaces the running game with a saved one while the physics thread is
+ * stopped between ticks. World commands still queued are dropped first;
+ * the world, enemies and timers are then rebuilt from the save, and the
+ * player is moved to its saved spot. Main thread only.
+ *
+ * @param[in] filename Save file to load
+ * @return bool True if the save was loaded
+ */
+bool ReloadGame(const char* filename) {
+    if (!physicsTickLock || SDL_LockMutex(physicsTickLock) != 0) {
+        fprintf(stderr, "Cannot pause physics to load\n");
+        return false;
+    }
+    int dropped = resetWorldCommands();  // Meant for the world being replaced
+    if (dropped > 0) {
+        printf("Dropped %d queued world commands before loading\n", dropped);
+    }
+    bool loaded = InitializeFromSave(filename);
+    resetSimSnapshots();  // The player was just moved to the saved spot
+    SDL_UnlockMutex(physicsTickLock);
+    return loaded;
+}
+
 void drawTargetTileOutline(int x, int y, float cameraOffsetX, float cameraOffsetY, float zoomFactor) {
     glUseProgram(outlineShaderProgram);
     glBindVertexArray(outlineVAO);
@@ -528,6 +658,7 @@ void CleanUp() {
     CleanupUI();
     cleanupEnclosureManager(&globalEnclosureManager);
     cleanupStorageManager(&globalStorageManager);  // Add this
+    cleanupWorkerPool(&globalWorkerPool);
     
     printf("Game systems cleaned up.\n");
 
@@ -615,6 +746,7 @@ void CleanUp() {
         free(globalChunkManager);
         globalChunkManager = NULL;
     }
+    cleanupChunkPool(&globalChunkPool);
     
     printf("Chunk manager cleaned up.\n");
 
@@ -643,39 +775,34 @@ void CleanUp() {
     printf("Cleanup sequence complete.\n");
 }
 bool westIsCorner(int x, int y) {
+    const GridCell (*cells)[GRID_SIZE] = renderFrame.world->cells;
     if (x <= 0) return false;
-    if (grid[y][x-1].structureType != STRUCTURE_WALL) return false;
+    if (cells[y][x-1].structureType != STRUCTURE_WALL) return false;
 
     
-    float texY = grid[y][x-1].wallTexY;
-    return (texY == 0.0f/4.0f) ||    // Top corners row
-           (texY == 1.0f/4.0f);      // Bottom corners row
+    int texRow = TEXTURE_INDEX_ROW(cells[y][x-1].texIndex);
+    return (texRow == 0) ||                  // Top corners row
+           (texRow == ATLAS_ROWS / 4);       // Bottom corners row
 }
 
 bool eastIsCorner(int x, int y) {
+    const GridCell (*cells)[GRID_SIZE] = renderFrame.world->cells;
     if (x >= GRID_SIZE-1) return false; 
-    if (grid[y][x+1].structureType != STRUCTURE_WALL) return false;
+    if (cells[y][x+1].structureType != STRUCTURE_WALL) return false;
 
-    float texY = grid[y][x+1].wallTexY;
-    return (texY == 0.0f/4.0f) ||    // Top corners row
-           (texY == 1.0f/4.0f);      // Bottom corners row
+    int texRow = TEXTURE_INDEX_ROW(cells[y][x+1].texIndex);
+    return (texRow == 0) ||                  // Top corners row
+           (texRow == ATLAS_ROWS / 4);       // Bottom corners row
 }
 
 /*
  * UpdateGameLogic
  *
- * Updates the game logic including player and enemy states.
+ * Advances the game clock. Runs on the physics thread as the game clock
+ * system, once per GAME_LOGIC_INTERVAL_MS.
  */
 void UpdateGameLogic() {
-    // Increment game tick
     atomic_fetch_add(&game_ticks, 1);
-    
-    // Update entities as before
-    for (int i = 0; i < MAX_ENEMIES; i++) {
-        if (isPositionInLoadedChunk(enemies[i].entity.posX, enemies[i].entity.posY)) {
-            UpdateEnemy(&enemies[i], allEntities, MAX_ENTITIES, SDL_GetTicks());
-        }
-    }
 }
 
 /*
@@ -693,8 +820,13 @@ void Render() {
     glBindTexture(GL_TEXTURE_2D, textureAtlas);
     glUniform1i(textureUniform, 0);
 
-    float cameraOffsetX = player.cameraCurrentX;
-    float cameraOffsetY = player.cameraCurrentY;
+    // Everything below draws this frame's interpolation of the newest
+    // physics snapshot, never the live simulation
+    buildRenderFrame(&renderFrame, SDL_GetPerformanceCounter());
+
+    // The camera lives in world tiles; this is where it meets the screen
+    float cameraOffsetX = tilesToViewX(renderFrame.cameraX);
+    float cameraOffsetY = tilesToViewY(renderFrame.cameraY);
     float zoomFactor = player.zoomFactor;
 
     RenderTiles(cameraOffsetX, cameraOffsetY, zoomFactor);  // Terrain and structures only
@@ -742,23 +874,32 @@ void RenderTreeCanopies(float cameraOffsetX, float cameraOffsetY, float zoomFact
     int dataIndex = 0;
     int renderedTiles = 0;
     const float texMargin = 0.0000001f;
-    float playerWorldX = player.entity.posX;
-    float playerWorldY = player.entity.posY;
+    float playerViewX = tilesToViewX(renderFrame.x[PLAYER_ENTITY_ID]);
+    float playerViewY = tilesToViewY(renderFrame.y[PLAYER_ENTITY_ID]);
+
+    // Chunks without trees are stepped over; rows are still drawn in order
+    // so overlapping canopies layer the same way
+    const GridCell (*cells)[GRID_SIZE] = renderFrame.world->cells;
+    const bool (*chunkHasTrees)[NUM_CHUNKS] = renderFrame.world->hasTrees;
 
     for (int y = 0; y < GRID_SIZE; y++) {
         for (int x = 0; x < GRID_SIZE; x++) {
-        if (grid[y][x].terrainType == TERRAIN_UNLOADED || 
-            y > 0 && grid[y-1][x].terrainType == TERRAIN_UNLOADED) {
+        if (!chunkHasTrees[y / CHUNK_SIZE][x / CHUNK_SIZE]) {
+            x += CHUNK_SIZE - 1 - x % CHUNK_SIZE;  // Jump to the chunk's last column
+            continue;
+        }
+        if (cells[y][x].terrainType == TERRAIN_UNLOADED || 
+            y > 0 && cells[y-1][x].terrainType == TERRAIN_UNLOADED) {
             continue;
         }
 
-            if (grid[y][x].structureType == STRUCTURE_PLANT && 
-                grid[y][x].materialType == MATERIAL_TREE) {
+            if (cells[y][x].structureType == STRUCTURE_PLANT && 
+                cells[y][x].materialType == MATERIAL_TREE) {
                 
                 float worldX, worldY;
                 WorldToScreenCoords(x, y - 1, 0, 0, 1, &worldX, &worldY);
 
-                if (!isPointVisible(worldX, worldY, playerWorldX, playerWorldY, zoomFactor)) {
+                if (!isPointVisible(worldX, worldY, playerViewX, playerViewY, zoomFactor)) {
                     continue;
                 }
                 
@@ -835,8 +976,8 @@ void RenderTiles(float cameraOffsetX, float cameraOffsetY, float zoomFactor) {
     glUseProgram(shaderProgram);
     glBindVertexArray(tilesBatchVAO);
 
-    float playerWorldX = player.entity.posX;
-    float playerWorldY = player.entity.posY;
+    float playerViewX = tilesToViewX(renderFrame.x[PLAYER_ENTITY_ID]);
+    float playerViewY = tilesToViewY(renderFrame.y[PLAYER_ENTITY_ID]);
 
     int renderedTiles = 0;
     int culledTiles = 0;
@@ -844,18 +985,19 @@ void RenderTiles(float cameraOffsetX, float cameraOffsetY, float zoomFactor) {
     int dataIndex = 0;
     float* batchData = tileBatchData.persistentBuffer;
     const float texMargin = 0.0000001f;
+    const GridCell (*cells)[GRID_SIZE] = renderFrame.world->cells;
 
     // Main tile and structure rendering pass
     for (int y = 0; y < GRID_SIZE; y++) {
         for (int x = 0; x < GRID_SIZE; x++) {
-            if (grid[y][x].terrainType == TERRAIN_UNLOADED) {
+            if (cells[y][x].terrainType == TERRAIN_UNLOADED) {
                 continue;
             }
 
             float worldX, worldY;
             WorldToScreenCoords(x, y, 0, 0, 1, &worldX, &worldY);
 
-            if (!isPointVisible(worldX, worldY, playerWorldX, playerWorldY, zoomFactor)) {
+            if (!isPointVisible(worldX, worldY, playerViewX, playerViewY, zoomFactor)) {
                 culledTiles++;
                 continue;
             }
@@ -868,8 +1010,8 @@ void RenderTiles(float cameraOffsetX, float cameraOffsetY, float zoomFactor) {
             const char* terrainId = NULL;
             
             // Handle terrain variations
-            if (grid[y][x].terrainType == TERRAIN_GRASS) {
-                uint16_t flags = grid[y][x].flags;
+            if (cells[y][x].terrainType == TERRAIN_GRASS) {
+                uint16_t flags = cells[y][x].flags;
                 uint16_t variation = (flags & TERRAIN_VARIATION_MASK) >> 8;
                 switch(variation) {
                     case 0: terrainId = "terrain_grass"; break;
@@ -880,8 +1022,8 @@ void RenderTiles(float cameraOffsetX, float cameraOffsetY, float zoomFactor) {
                     default: terrainId = "terrain_grass"; break;
                 }
             } 
-            else if (grid[y][x].terrainType == TERRAIN_STONE) {
-                uint16_t flags = grid[y][x].flags;
+            else if (cells[y][x].terrainType == TERRAIN_STONE) {
+                uint16_t flags = cells[y][x].flags;
                 uint16_t variation = (flags & TERRAIN_VARIATION_MASK) >> 8;
                 switch(variation) {
                     case 0: terrainId = "terrain_stone_2"; break;
@@ -892,7 +1034,7 @@ void RenderTiles(float cameraOffsetX, float cameraOffsetY, float zoomFactor) {
                 }
             }
             else {
-                switch (grid[y][x].terrainType) {
+                switch (cells[y][x].terrainType) {
                     case TERRAIN_SAND:    terrainId = "terrain_sand"; break;
                     case TERRAIN_WATER:   terrainId = "terrain_water"; break;
                     default:              terrainId = "terrain_grass"; break;
@@ -920,7 +1062,7 @@ void RenderTiles(float cameraOffsetX, float cameraOffsetY, float zoomFactor) {
 
             // Apply rotation - rotate vertex indices
             int rotatedIndices[4];
-            uint8_t terrainRotation = GRIDCELL_GET_TERRAIN_ROTATION(grid[y][x]);
+            uint8_t terrainRotation = GRIDCELL_GET_TERRAIN_ROTATION(cells[y][x]);
             switch(terrainRotation & 3) {
                 case 0:  // No rotation
                     rotatedIndices[0] = 0; rotatedIndices[1] = 1;
@@ -975,18 +1117,16 @@ void RenderTiles(float cameraOffsetX, float cameraOffsetY, float zoomFactor) {
             renderedTiles++;
 
             // Render structures
-            if (grid[y][x].structureType != 0) {
+            if (cells[y][x].structureType != 0) {
                 TextureCoords* structureTex = NULL;
                 
-if (grid[y][x].structureType == STRUCTURE_WALL) {
-    // Get the texture coordinates for this wall from stored values
-    float u1 = grid[y][x].wallTexX;
-    float v1 = grid[y][x].wallTexY;
-    
-    // Get the matching texture u2/v2
-    TextureCoords* structureTex = getTextureCoords("wall_vertical"); // Use any wall texture to get correct width/height
-    float u2 = u1 + (structureTex->u2 - structureTex->u1);
-    float v2 = v1 + (structureTex->v2 - structureTex->v1);
+if (cells[y][x].structureType == STRUCTURE_WALL) {
+    // Expand the wall's stored atlas index into UVs
+    TextureCoords wallTex = textureCoordsFromIndex(cells[y][x].texIndex);
+    float u1 = wallTex.u1;
+    float v1 = wallTex.v1;
+    float u2 = wallTex.u2;
+    float v2 = wallTex.v2;
 
     // First triangle
     batchData[dataIndex++] = posX - halfSize;
@@ -1022,9 +1162,9 @@ if (grid[y][x].structureType == STRUCTURE_WALL) {
 
     renderedTiles++;
 }
-                else if (grid[y][x].structureType == STRUCTURE_DOOR) {
-                    bool isOpen = GRIDCELL_IS_WALKABLE(grid[y][x]);
-                    bool isVertical = (GRIDCELL_GET_ORIENTATION(grid[y][x]) == 0);
+                else if (cells[y][x].structureType == STRUCTURE_DOOR) {
+                    bool isOpen = GRIDCELL_IS_WALKABLE(cells[y][x]);
+                    bool isVertical = (GRIDCELL_GET_ORIENTATION(cells[y][x]) == 0);
                     
                     if (isVertical) {
                         structureTex = getTextureCoords(isOpen ? "door_vertical_open" : "door_vertical");
@@ -1032,15 +1172,15 @@ if (grid[y][x].structureType == STRUCTURE_WALL) {
                         structureTex = getTextureCoords(isOpen ? "door_horizontal_open" : "door_horizontal");
                     }
                 }
-                else if (grid[y][x].structureType == STRUCTURE_PLANT) {
-                    if (grid[y][x].materialType == MATERIAL_FERN) {
+                else if (cells[y][x].structureType == STRUCTURE_PLANT) {
+                    if (cells[y][x].materialType == MATERIAL_FERN) {
                         structureTex = getTextureCoords("item_fern");
                     }
-                    else if (grid[y][x].materialType == MATERIAL_TREE) {
+                    else if (cells[y][x].materialType == MATERIAL_TREE) {
                         structureTex = getTextureCoords("tree_trunk");
                     }
                 }
-                    else if (grid[y][x].structureType == STRUCTURE_CRATE) {
+                    else if (cells[y][x].structureType == STRUCTURE_CRATE) {
         structureTex = getTextureCoords("item_plant_crate");
     }
 
@@ -1087,7 +1227,9 @@ if (grid[y][x].structureType == STRUCTURE_WALL) {
     glBufferSubData(GL_ARRAY_BUFFER, 0, dataIndex * sizeof(float), batchData);
     glDrawArrays(GL_TRIANGLES, 0, renderedTiles * 6);
 
-    if (isPointVisible(player.entity.finalGoalX, player.entity.finalGoalY, playerWorldX, playerWorldY, zoomFactor)) {
+    float goalViewX = tilesToViewX(atomic_load(&player.entity.finalGoalX) + 0.5f);
+    float goalViewY = tilesToViewY(atomic_load(&player.entity.finalGoalY) + 0.5f);
+    if (isPointVisible(goalViewX, goalViewY, playerViewX, playerViewY, zoomFactor)) {
         drawTargetTileOutline(player.entity.finalGoalX, player.entity.finalGoalY, cameraOffsetX, cameraOffsetY, zoomFactor);
     }
 }
@@ -1102,50 +1244,61 @@ if (grid[y][x].structureType == STRUCTURE_WALL) {
  * @param[in] zoomFactor The zoom factor applied to the view
  */
 void RenderEntities(float cameraOffsetX, float cameraOffsetY, float zoomFactor) {
-    float playerWorldX = player.entity.posX;
-    float playerWorldY = player.entity.posY;
+    float playerViewX = tilesToViewX(renderFrame.x[PLAYER_ENTITY_ID]);
+    float playerViewY = tilesToViewY(renderFrame.y[PLAYER_ENTITY_ID]);
 
     int visibleEnemyCount = 0;
     int culledEnemyCount = 0;
-    int chunkCulledCount = 0;
 
-    Enemy visibleEnemies[MAX_ENEMIES];
+    // Only enemies on tiles within view can be visible. The spatial hash
+    // holds just the resident ones, so there is no chunk test either.
+    int playerTileX = (int)floorf(renderFrame.x[PLAYER_ENTITY_ID]);
+    int playerTileY = (int)floorf(renderFrame.y[PLAYER_ENTITY_ID]);
+    int viewRadius = (int)ceilf((GRID_SIZE + 1) / (2.0f * zoomFactor)) + 1;
+    static int nearby[MAX_ENTITIES];  // Too large for the stack at full pool capacity
+    int nearbyCount = spatialHashQueryRect(playerTileX - viewRadius, playerTileY - viewRadius,
+                                           playerTileX + viewRadius, playerTileY + viewRadius,
+                                           nearby, MAX_ENTITIES);
+    if (nearbyCount > MAX_ENTITIES) nearbyCount = MAX_ENTITIES;
+
+    static int candidates[MAX_ENEMIES];
+    int candidateCount = 0;
+    for (int k = 0; k < nearbyCount; k++) {
+        // Enemies resumed since the last snapshot are not in it yet
+        if (nearby[k] != PLAYER_ENTITY_ID && renderFrame.present[nearby[k]]) {
+            candidates[candidateCount++] = nearby[k];
+        }
+    }
+
+    static int visibleEnemies[MAX_ENEMIES];  // entityStore ids
 
     __m128 zoomFactorVec = _mm_set1_ps(zoomFactor);
     __m128 marginVec = _mm_set1_ps(TILE_SIZE);
     __m128 minusOne = _mm_set1_ps(-1.0f);
     __m128 one = _mm_set1_ps(1.0f);
+    __m128 tilesToViewScale = _mm_set1_ps(2.0f / GRID_SIZE);
 
     __m128 leftBound = _mm_sub_ps(minusOne, marginVec);
     __m128 rightBound = _mm_add_ps(one, marginVec);
     __m128 bottomBound = _mm_sub_ps(minusOne, marginVec);
     __m128 topBound = _mm_add_ps(one, marginVec);
 
-    // Process enemies in groups of 4 for SIMD
+    // Exact culling of the candidates in groups of 4 for SIMD; only the
+    // position arrays of the render frame are touched
     int i;
-    for (i = 0; i < MAX_ENEMIES - 3; i += 4) {  // Process full groups of 4
-        bool enemyValid[4] = {false, false, false, false};
+    for (i = 0; i < candidateCount - 3; i += 4) {  // Process full groups of 4
+        const int* ids = &candidates[i];
 
-        // Check chunk loading for all 4
-        for (int j = 0; j < 4; j++) {
-            if (isPositionInLoadedChunk(enemies[i+j].entity.posX, enemies[i+j].entity.posY)) {
-                enemyValid[j] = true;
-            } else {
-                chunkCulledCount++;
-            }
-        }
+        // Tile positions to view space, four at a time
+        __m128 enemyPosX = _mm_set_ps(renderFrame.x[ids[3]], renderFrame.x[ids[2]],
+                                      renderFrame.x[ids[1]], renderFrame.x[ids[0]]);
+        __m128 enemyPosY = _mm_set_ps(renderFrame.y[ids[3]], renderFrame.y[ids[2]],
+                                      renderFrame.y[ids[1]], renderFrame.y[ids[0]]);
+        enemyPosX = _mm_sub_ps(_mm_mul_ps(enemyPosX, tilesToViewScale), one);
+        enemyPosY = _mm_sub_ps(one, _mm_mul_ps(enemyPosY, tilesToViewScale));
 
-        __m128 enemyPosX = _mm_set_ps(
-            enemies[i+3].entity.posX, enemies[i+2].entity.posX,
-            enemies[i+1].entity.posX, enemies[i].entity.posX
-        );
-        __m128 enemyPosY = _mm_set_ps(
-            enemies[i+3].entity.posY, enemies[i+2].entity.posY,
-            enemies[i+1].entity.posY, enemies[i].entity.posY
-        );
-
-        __m128 screenX = _mm_mul_ps(_mm_sub_ps(enemyPosX, _mm_set1_ps(playerWorldX)), zoomFactorVec);
-        __m128 screenY = _mm_mul_ps(_mm_sub_ps(enemyPosY, _mm_set1_ps(playerWorldY)), zoomFactorVec);
+        __m128 screenX = _mm_mul_ps(_mm_sub_ps(enemyPosX, _mm_set1_ps(playerViewX)), zoomFactorVec);
+        __m128 screenY = _mm_mul_ps(_mm_sub_ps(enemyPosY, _mm_set1_ps(playerViewY)), zoomFactorVec);
 
         __m128 visibleX = _mm_and_ps(_mm_cmpge_ps(screenX, leftBound), _mm_cmple_ps(screenX, rightBound));
         __m128 visibleY = _mm_and_ps(_mm_cmpge_ps(screenY, bottomBound), _mm_cmple_ps(screenY, topBound));
@@ -1154,36 +1307,33 @@ void RenderEntities(float cameraOffsetX, float cameraOffsetY, float zoomFactor)
         int visibilityMask = _mm_movemask_ps(visible);
 
         for (int j = 0; j < 4; j++) {
-            if (enemyValid[j] && (visibilityMask & (1 << j))) {
-                visibleEnemies[visibleEnemyCount++] = enemies[i + j];
-            } else if (enemyValid[j]) {
+            if (visibilityMask & (1 << j)) {
+                visibleEnemies[visibleEnemyCount++] = ids[j];
+            } else {
                 culledEnemyCount++;
             }
         }
     }
 
     // Handle remaining enemies individually
-    for (; i < MAX_ENEMIES; i++) {
-        if (isPositionInLoadedChunk(enemies[i].entity.posX, enemies[i].entity.posY)) {
-            float screenX = (enemies[i].entity.posX - playerWorldX) * zoomFactor;
-            float screenY = (enemies[i].entity.posY - playerWorldY) * zoomFactor;
-            
-            if (screenX >= -1.0f - TILE_SIZE && screenX <= 1.0f + TILE_SIZE &&
-                screenY >= -1.0f - TILE_SIZE && screenY <= 1.0f + TILE_SIZE) {
-                visibleEnemies[visibleEnemyCount++] = enemies[i];
-            } else {
-                culledEnemyCount++;
-            }
+    for (; i < candidateCount; i++) {
+        int id = candidates[i];
+        float screenX = (tilesToViewX(renderFrame.x[id]) - playerViewX) * zoomFactor;
+        float screenY = (tilesToViewY(renderFrame.y[id]) - playerViewY) * zoomFactor;
+
+        if (screenX >= -1.0f - TILE_SIZE && screenX <= 1.0f + TILE_SIZE &&
+            screenY >= -1.0f - TILE_SIZE && screenY <= 1.0f + TILE_SIZE) {
+            visibleEnemies[visibleEnemyCount++] = id;
         } else {
-            chunkCulledCount++;
+            culledEnemyCount++;
         }
     }
 
-    float smoothCameraOffsetX = player.cameraCurrentX;
-    float smoothCameraOffsetY = player.cameraCurrentY;
+    float smoothCameraOffsetX = tilesToViewX(renderFrame.cameraX);
+    float smoothCameraOffsetY = tilesToViewY(renderFrame.cameraY);
 
     // Update enemy batch VBO and render
-    updateEnemyBatchVBO(visibleEnemies, visibleEnemyCount, smoothCameraOffsetX, smoothCameraOffsetY, zoomFactor);
+    updateEnemyBatchVBO(&renderFrame, visibleEnemies, visibleEnemyCount, smoothCameraOffsetX, smoothCameraOffsetY, zoomFactor);
     glBindVertexArray(enemyBatchVAO);
     glDrawArrays(GL_TRIANGLES, 0, visibleEnemyCount * 6);
 
@@ -1191,16 +1341,16 @@ void RenderEntities(float cameraOffsetX, float cameraOffsetY, float zoomFactor)
     glBindVertexArray(squareVAO);
     glBindBuffer(GL_ARRAY_BUFFER, squareVBO);
 
-    float playerScreenX = (playerWorldX - smoothCameraOffsetX) * zoomFactor;
-    float playerScreenY = (playerWorldY - smoothCameraOffsetY) * zoomFactor;
+    float playerScreenX = (playerViewX - smoothCameraOffsetX) * zoomFactor;
+    float playerScreenY = (playerViewY - smoothCameraOffsetY) * zoomFactor;
 
     // Get player texture based on animation state and direction
     TextureCoords* playerTex;
     char textureName[32];
 
-    if (!player.animation->isMoving) {
+    if (!renderFrame.isMoving[PLAYER_ENTITY_ID]) {
         // Use standing frame based on direction
-        switch(player.animation->facing) {
+        switch(renderFrame.facing[PLAYER_ENTITY_ID]) {
         case DIRECTION_UP:
             playerTex = getTextureCoords("player_run_up_0");
             break;
@@ -1219,7 +1369,7 @@ void RenderEntities(float cameraOffsetX, float cameraOffsetY, float zoomFactor)
     } else {
         // Get running animation frame based on direction
         const char* dirStr;
-        switch(player.animation->facing) {
+        switch(renderFrame.facing[PLAYER_ENTITY_ID]) {
             case DIRECTION_UP:
                 dirStr = "up";
                 break;
@@ -1236,7 +1386,7 @@ void RenderEntities(float cameraOffsetX, float cameraOffsetY, float zoomFactor)
                 dirStr = "down";
         }
         snprintf(textureName, sizeof(textureName), "player_run_%s_%d", 
-                dirStr, player.animation->currentFrame);
+                dirStr, renderFrame.animFrame[PLAYER_ENTITY_ID]);
         playerTex = getTextureCoords(textureName);
     }
 
@@ -1263,51 +1413,140 @@ void RenderEntities(float cameraOffsetX, float cameraOffsetY, float zoomFactor)
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+// Physics systems, in scheduler ticks of PHYSICS_TICK_MS. Movement and the
+// camera run every tick; AI decisions, animation and the chunk streaming
+// check are cheaper at lower rates and are phased apart.
+static Scheduler physicsScheduler;
+static EnemySimTiming physicsTiming;
+static unsigned long enemyThinks[ENEMY_LOD_COUNT];  // Totals of physicsTiming.thinks
+
+static void runWorldCommands(void* context) {
+    (void)context;
+    // All world edits requested since the last tick land here, so the
+    // rest of the tick sees a stable grid
+    applyWorldCommands();
+}
+
+static void runWorldTimers(void* context) {
+    (void)context;
+    advanceWorldTimers();
+}
+
+static void runPlayer(void* context) {
+    (void)context;
+    UpdatePlayer(&player, allEntities, MAX_ENTITIES);
+}
+
+static void runChunkStreaming(void* context) {
+    (void)context;
+    if (globalChunkManager &&
+        updatePlayerChunk(globalChunkManager, entityStore.posX[player.entity.id], entityStore.posY[player.entity.id])) {
+        queueStreamChunks();
+    }
+}
+
+// Enemies in unloaded chunks are suspended and not on the active list
+static void runEnemyAI(void* context) {
+    thinkEnemies(SDL_GetTicks(), atomic_load(&player.entity.gridX), atomic_load(&player.entity.gridY),
+                 (EnemySimTiming*)context);
+}
+
+static void runEnemyMovement(void* context) {
+    moveEnemies((EnemySimTiming*)context);
+}
+
+static void runAnimation(void* context) {
+    (void)context;
+    Uint32 currentTime = SDL_GetTicks();
+    animatePlayer(&player, currentTime);
+    int activeCount = activeEnemyCount();
+    for (int i = 0; i < activeCount; i++) {
+        // Only near enemies can be on screen; the rest keep their last frame
+        Enemy* enemy = activeEnemy(i);
+        if (enemy->lod == ENEMY_LOD_NEAR) {
+            animateEnemy(enemy, currentTime);
+        }
+    }
+}
+
+static void runCamera(void* context) {
+    (void)context;
+    updateCamera(&player);
+}
+
+static void runGameClock(void* context) {
+    (void)context;
+    UpdateGameLogic();
+}
+
+static void runSnapshot(void* context) {
+    (void)context;
+    publishSimSnapshot(PHYSICS_TICK_MS);
+}
+
+static void registerPhysicsSystems(Scheduler* scheduler) {
+    initScheduler(scheduler);
+    schedulerAddSystem(scheduler, "world commands", runWorldCommands, NULL, 1, 0);
+    schedulerAddSystem(scheduler, "timers", runWorldTimers, NULL, 1, 0);  // One wheel tick per physics tick
+    schedulerAddSystem(scheduler, "player", runPlayer, NULL, 1, 0);
+    schedulerAddSystem(scheduler, "chunk streaming", runChunkStreaming, NULL, 4, 1);
+    schedulerAddSystem(scheduler, "enemy ai", runEnemyAI, &physicsTiming, 4, 3);
+    schedulerAddSystem(scheduler, "enemy movement", runEnemyMovement, &physicsTiming, 1, 0);
+    schedulerAddSystem(scheduler, "animation", runAnimation, NULL, 2, 0);
+    schedulerAddSystem(scheduler, "camera", runCamera, NULL, 1, 0);
+    schedulerAddSystem(scheduler, "game clock", runGameClock, NULL,
+                       GAME_LOGIC_INTERVAL_MS / PHYSICS_TICK_MS, 0);
+    schedulerAddSystem(scheduler, "snapshot", runSnapshot, NULL, 1, 0);  // Last: sees the whole tick
+}
+
 /*
  * PhysicsLoop
  *
- * Runs the physics simulation and updates entities at a fixed interval.
+ * Runs the physics systems, one scheduler tick every PHYSICS_TICK_MS.
  *
  * @param[in] arg Argument passed to the thread (unused)
  * @return int Return value (always 0)
  */
 int PhysicsLoop(void* arg) {
     (void)arg;
+    registerPhysicsSystems(&physicsScheduler);
+
     while (atomic_load(&isRunning)) {
         Uint32 startTime = SDL_GetTicks();
+        Uint64 tickStart = SDL_GetPerformanceCounter();
         
         atomic_store(&physics_load, 100);
 
-        // Update player physics
-        UpdateEntity(&player.entity, allEntities, MAX_ENTITIES);
-        UpdatePlayer(&player, allEntities, MAX_ENTITIES);
-        
-        // Check for chunk updates immediately after player moves
-        if (globalChunkManager) {
-            updatePlayerChunk(globalChunkManager, player.entity.posX, player.entity.posY);
-        }
-
-        // Get the current time once for all enemies
-        Uint32 currentTime = SDL_GetTicks();
-
-        // Update other entities - but only if they're in loaded chunks
-        for (int i = 0; i < MAX_ENEMIES; i++) {
-            if (isPositionInLoadedChunk(enemies[i].entity.posX, enemies[i].entity.posY)) {
-                UpdateEntity(&enemies[i].entity, allEntities, MAX_ENTITIES);
-                UpdateEnemy(&enemies[i], allEntities, MAX_ENTITIES, currentTime);
-            }
+        resetEnemySimTiming(&physicsTiming);
+        SDL_LockMutex(physicsTickLock);
+        schedulerRunTick(&physicsScheduler);
+        SDL_UnlockMutex(physicsTickLock);
+        for (int lod = 0; lod < ENEMY_LOD_COUNT; lod++) {
+            enemyThinks[lod] += (unsigned long)physicsTiming.thinks[lod];
         }
 
         Uint32 endTime = SDL_GetTicks();
         Uint32 elapsedTime = endTime - startTime;
         
-        int load = (elapsedTime * 100) / 8;
+        // Load is the busiest thread's share of the tick. This thread is
+        // busy outside the enemy systems and while running their jobs, but
+        // not while it waits there for the workers.
+        Uint64 busiest = SDL_GetPerformanceCounter() - tickStart - physicsTiming.elapsed +
+                         physicsTiming.busy[physicsTiming.threadCount - 1];
+        for (int i = 0; i < physicsTiming.threadCount - 1; i++) {
+            if (physicsTiming.busy[i] > busiest) busiest = physicsTiming.busy[i];
+        }
+        int load = (int)(busiest * 100 * 1000 / (SDL_GetPerformanceFrequency() * PHYSICS_TICK_MS));
         atomic_store(&physics_load, load);
 
-        if (elapsedTime < 8) {
-            SDL_Delay(8 - elapsedTime);
+        if (elapsedTime < PHYSICS_TICK_MS) {
+            SDL_Delay(PHYSICS_TICK_MS - elapsedTime);
         }
     }
+
+    schedulerPrintStats(&physicsScheduler);
+    printf("Enemy thinks by LOD: near %lu, mid %lu, far %lu\n",
+           enemyThinks[ENEMY_LOD_NEAR], enemyThinks[ENEMY_LOD_MID], enemyThinks[ENEMY_LOD_FAR]);
     return 0;
 }
 /*
@@ -1320,11 +1559,20 @@ int PhysicsLoop(void* arg) {
  * @return int Exit status
  */
 int main(int argc, char* argv[]) {
-    (void)argc;
-    (void)argv;
-
     srand((unsigned int)time(NULL));  
 
+    // --procedural [--seed N]: generate the world instead of loading a map
+    // --map FILE: stream terrain from FILE (ASCII or compiled by mapc)
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--procedural") == 0) {
+            proceduralWorld = true;
+        } else if (strcmp(argv[i], "--map") == 0 && i + 1 < argc) {
+            mapPath = argv[++i];
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            setWorldSeed((uint32_t)strtoul(argv[++i], NULL, 0));
+        }
+    }
+
     printf("Starting GameLoop...\n");
     GameLoop();
     printf("GameLoop ended.\n");
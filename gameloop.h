@@ -16,13 +16,11 @@
 #define SIDEBAR_WIDTH 300
 #define WINDOW_WIDTH (GAME_VIEW_WIDTH + SIDEBAR_WIDTH)
 #define WINDOW_HEIGHT 800
-#define MAX_ENEMIES 80
-#define MOVE_SPEED 0.0005f
+#define MOVE_SPEED 0.02f  // Tiles per physics tick
 #define GAME_LOGIC_INTERVAL_MS ((Uint32)600)
 #define CAMERA_ZOOM 2.00f  
 #define TILE_SIZE (1.0f / GRID_SIZE)
-#define MAX_ENTITIES (MAX_ENEMIES + 1)
-#define PHYSICS_INTERVAL_MS 12
+#define PHYSICS_TICK_MS 8  // One physics scheduler tick
 
 
 
@@ -31,18 +29,26 @@ extern GLuint outlineVBO;
 extern GLuint tilesBatchVAO;
 extern GLuint tilesBatchVBO;
 extern Entity* allEntities[MAX_ENTITIES];
+extern atomic_uint game_ticks;  // Advanced once per game logic interval
 extern Uint32 FRAME_TIME_MS;
+extern bool proceduralWorld;
+extern const char* mapPath;
 bool LoadGame(const char* filename);
+bool SaveGame(const char* filename);
+bool ReloadGame(const char* filename);
 
 
 void drawTargetTileOutline(int x, int y, float cameraOffsetX, float cameraOffsetY, float zoomFactor);
 void InitializeEngine(void);
 void InitializeGameState(bool isNewGame);
+void InitializeEnemies(void);
+void FinishGameLoad(void);
 void initializeTilesBatchVAO();
 float lerp(float a, float b, float t);
 void WorldToScreenCoords(int gridX, int gridY, float cameraOffsetX, float cameraOffsetY, float zoomFactor, float* screenX, float* screenY);
 void setGridSize(int size);
 void CleanupEntities(void);
+void CleanupEnemies(void);
 void GameLoop();
 void Initialize();
 void HandleInput();
@@ -53,7 +59,6 @@ int PhysicsLoop(void* arg);
 void CleanUp();
 void RenderTiles(float cameraOffsetX, float cameraOffsetY, float zoomFactor);
 void RenderEntities(float cameraOffsetX, float cameraOffsetY, float zoomFactor);
-void generateTerrain();
 void drawTargetTileOutline(int x, int y, float cameraOffsetX, float cameraOffsetY, float zoomFactor);
 bool westIsCorner(int x, int y);
 bool eastIsCorner(int x, int y);
@@ -3,28 +3,32 @@
 #include "grid.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 #include <time.h>
 
 #include "asciiMap.h" 
+#include "map_stream.h"
+#include "noise.h"
+#include "terrain_gen.h"
+#include "grid_edit.h"
+#include "chunk_pool.h"
+#include "grid_planes.h"
 GridCell grid[GRID_SIZE][GRID_SIZE];
 
 BiomeData biomeData[BIOME_COUNT] = {
-    {{TERRAIN_WATER, TERRAIN_SAND, TERRAIN_STONE}, {0.3f, 0.1f}},    // OCEAN
-    {{TERRAIN_SAND, TERRAIN_SAND, TERRAIN_STONE}, {0.6f, 0.3f}},     // BEACH
-    {{TERRAIN_GRASS, TERRAIN_DIRT, TERRAIN_STONE}, {0.7f, 0.4f}},    // PLAINS
-    {{TERRAIN_GRASS, TERRAIN_DIRT, TERRAIN_STONE}, {0.8f, 0.5f}},    // FOREST
-    {{TERRAIN_SAND, TERRAIN_SAND, TERRAIN_STONE}, {0.6f, 0.3f}},     // DESERT
-    {{TERRAIN_GRASS, TERRAIN_STONE, TERRAIN_STONE}, {0.9f, 0.7f}}    // MOUNTAINS
+    //  terrain types                                  detail         height         moisture
+    {{TERRAIN_WATER, TERRAIN_SAND, TERRAIN_STONE}, {0.97f, 0.86f}, 0.00f, 0.34f, 0.00f, 1.01f},  // OCEAN
+    {{TERRAIN_SAND, TERRAIN_SAND, TERRAIN_STONE},  {0.95f, 0.60f}, 0.34f, 0.40f, 0.00f, 1.01f},  // BEACH
+    {{TERRAIN_GRASS, TERRAIN_DIRT, TERRAIN_STONE}, {0.92f, 0.74f}, 0.40f, 0.72f, 0.36f, 0.62f},  // PLAINS
+    {{TERRAIN_GRASS, TERRAIN_DIRT, TERRAIN_STONE}, {0.95f, 0.80f}, 0.40f, 0.72f, 0.62f, 1.01f},  // FOREST
+    {{TERRAIN_SAND, TERRAIN_SAND, TERRAIN_STONE},  {0.90f, 0.60f}, 0.40f, 0.72f, 0.00f, 0.36f},  // DESERT
+    {{TERRAIN_GRASS, TERRAIN_STONE, TERRAIN_STONE}, {0.70f, 0.42f}, 0.72f, 1.01f, 0.00f, 1.01f}  // MOUNTAINS
 };
 
 #define UNWALKABLE_PROBABILITY 0.04f  // Define the unwalkable probability
 
-// Perlin noise function declarations
-float noise(int x, int y);
-float smoothNoise(int x, int y);
-float interpolatedNoise(float x, float y);
-float perlinNoise(float x, float y, float persistence, int octaves);
+uint32_t worldSeed = 0x2545F491u;
 
 static inline uint8_t getRandomRotation(void) {
     return rand() % 4;  // Returns 0-3 for 90-degree rotations
@@ -51,8 +55,7 @@ void initializeGrid(int size) {
             grid[y][x].biomeType = BIOME_PLAINS;
             grid[y][x].structureType = 0;
             grid[y][x].materialType = 0;
-            grid[y][x].wallTexX = 0.0f;
-            grid[y][x].wallTexY = 0.0f;
+            grid[y][x].texIndex = 0;
             
             GRIDCELL_SET_WALKABLE(grid[y][x], true);
             GRIDCELL_SET_ORIENTATION(grid[y][x], 0);
@@ -61,17 +64,16 @@ void initializeGrid(int size) {
             GRIDCELL_SET_TERRAIN_VARIATION(grid[y][x], 0);
         }
     }
+    gridMarkRegionChanged(0, 0, size - 1, size - 1, GRID_CHANGE_ALL);
 }
 /*
  * cleanupGrid
  *
- * Cleans up resources allocated for the grid. (Currently does nothing)
+ * Cleans up resources allocated for the grid: closes the streamed map.
  */
 void cleanupGrid() {
-    if (loadedMapData) {
-        free(loadedMapData);
-        loadedMapData = NULL;
-    }
+    closeMapSource(activeMapSource);
+    activeMapSource = NULL;
 }
 
 /*
@@ -84,11 +86,11 @@ void cleanupGrid() {
  * @return bool True if the cell is walkable, false otherwise
  */
 bool isWalkable(int x, int y) {
-    if (x < 0 || x >= GRID_SIZE || y < 0 || y >= GRID_SIZE) {
+    // One unsigned compare per axis also admits the zero border of the plane
+    if ((unsigned)(x + 1) >= PLANE_SPAN || (unsigned)(y + 1) >= PLANE_SPAN) {
         return false;
     }
-    return GRIDCELL_IS_WALKABLE(grid[y][x]);
-
+    return planeTest(walkablePlane, x, y);
 }
 
 /*
@@ -156,14 +158,13 @@ void writeChunkToGrid(const Chunk* chunk) {
                 uint8_t oldMaterialType = grid[gridY][gridX].materialType;
                 uint8_t oldOrientation = GRIDCELL_GET_ORIENTATION(grid[gridY][gridX]);
                 bool wasWalkable = GRIDCELL_IS_WALKABLE(grid[gridY][gridX]);
-                float oldTexX = grid[gridY][gridX].wallTexX;
-                float oldTexY = grid[gridY][gridX].wallTexY;
+                uint16_t oldTexIndex = grid[gridY][gridX].texIndex;
                 uint16_t oldFlags = grid[gridY][gridX].flags;
 
                 // Get new terrain data from chunk
-                TerrainType newTerrain = chunk->cells[y][x].terrainType;
-                uint16_t newFlags = chunk->cells[y][x].flags;
-                uint8_t newBiomeType = chunk->cells[y][x].biomeType;
+                TerrainType newTerrain = CHUNK_CELL(chunk, x, y).terrainType;
+                uint16_t newFlags = CHUNK_CELL(chunk, x, y).flags;
+                uint8_t newBiomeType = CHUNK_CELL(chunk, x, y).biomeType;
 
                 if (oldStructureType != 0) {
                     printf("DEBUG: Preserving structure at (%d,%d) - type: %d, material: %d\n",
@@ -176,8 +177,7 @@ void writeChunkToGrid(const Chunk* chunk) {
                     // Preserve all structure data
                     grid[gridY][gridX].structureType = oldStructureType;
                     grid[gridY][gridX].materialType = oldMaterialType;
-                    grid[gridY][gridX].wallTexX = oldTexX;
-                    grid[gridY][gridX].wallTexY = oldTexY;
+                    grid[gridY][gridX].texIndex = oldTexIndex;
                     
                     // Preserve structure flags while updating terrain flags
                     uint16_t preservedFlags = oldFlags & STRUCTURE_PRESERVE_MASK;
@@ -203,37 +203,53 @@ void writeChunkToGrid(const Chunk* chunk) {
                     }
                 } else {
                     // No structure - do a complete cell copy
-                    grid[gridY][gridX] = chunk->cells[y][x];
+                    grid[gridY][gridX] = CHUNK_CELL(chunk, x, y);
                 }
             }
         }
     }
+
+    gridMarkRegionChanged(startX, startY, startX + CHUNK_SIZE - 1, startY + CHUNK_SIZE - 1,
+                          GRID_CHANGE_ALL);
 }
-void generateTerrain() {
-    printf("Generating initial terrain...\n");
-    
-    // Initialize each chunk in the grid
-    for (int chunkY = 0; chunkY < NUM_CHUNKS; chunkY++) {
-        for (int chunkX = 0; chunkX < NUM_CHUNKS; chunkX++) {
-            Chunk tempChunk;
-            initializeChunk(&tempChunk, chunkX, chunkY);
-            writeChunkToGrid(&tempChunk);
+/*
+ * markGridUnloaded
+ *
+ * Resets every cell to TERRAIN_UNLOADED, as before any chunk has streamed
+ * in. A new game starts from here and loads only the chunks around the
+ * player.
+ */
+void markGridUnloaded(void) {
+    for (int y = 0; y < GRID_SIZE; y++) {
+        for (int x = 0; x < GRID_SIZE; x++) {
+            grid[y][x] = (GridCell){0};
+            grid[y][x].terrainType = TERRAIN_UNLOADED;
         }
     }
+    gridMarkRegionChanged(0, 0, GRID_SIZE - 1, GRID_SIZE - 1, GRID_CHANGE_ALL);
+}
 
-    printf("Initial terrain generation complete\n");
-
-    // Ensure the center of the map is walkable for player spawn
-    int centerX = GRID_SIZE / 2;
-    int centerY = GRID_SIZE / 2;
+/*
+ * clearSpawnArea
+ *
+ * Makes the 3x3 block around a tile walkable land so the player never
+ * spawns in water or rock. Unloaded tiles and tiles with a structure are
+ * left alone, so it can be re-applied whenever a chunk there is generated.
+ *
+ * @param[in] centerX Spawn tile column
+ * @param[in] centerY Spawn tile row
+ */
+void clearSpawnArea(int centerX, int centerY) {
     for (int y = centerY - 1; y <= centerY + 1; y++) {
         for (int x = centerX - 1; x <= centerX + 1; x++) {
-            if (x >= 0 && x < GRID_SIZE && y >= 0 && y < GRID_SIZE) {
-                GRIDCELL_SET_WALKABLE(grid[y][x], true);
+            if (x >= 0 && x < GRID_SIZE && y >= 0 && y < GRID_SIZE &&
+                grid[y][x].terrainType != TERRAIN_UNLOADED &&
+                grid[y][x].structureType == 0) {
+                gridSetWalkable(x, y, true);
 
                 if (grid[y][x].terrainType == TERRAIN_WATER || 
                     grid[y][x].terrainType == TERRAIN_UNWALKABLE) {
-                    grid[y][x].terrainType = TERRAIN_GRASS;
+                    gridSetTerrain(x, y, TERRAIN_GRASS);
                 }
             }
         }
@@ -242,91 +258,69 @@ void generateTerrain() {
 // Perlin noise functions
 
 /*
- * noise
+ * setWorldSeed
  *
- * Generates a noise value for a given coordinate.
+ * Sets the seed used by all terrain noise. Terrain is a pure function of
+ * this seed and the tile coordinates.
  *
- * @param[in] x The x-coordinate
- * @param[in] y The y-coordinate
- * @return float The noise value
+ * @param[in] seed The new world seed
  */
-float noise(int x, int y) {
-    int n = x + y * 57;
-    n = (n << 13) ^ n;
-    return (1.0f - ((n * (n * n * 15731 + 789221) + 1376312589 + rand()) & 0x7fffffff) / 1073741824.0f);
+void setWorldSeed(uint32_t seed) {
+    worldSeed = seed;
 }
 
 /*
- * smoothNoise
+ * noise
  *
- * Generates a smoothed noise value for a given coordinate.
+ * Generates a deterministic lattice noise value for a given coordinate.
  *
  * @param[in] x The x-coordinate
  * @param[in] y The y-coordinate
- * @return float The smoothed noise value
+ * @return float The noise value in [-1, 1)
  */
-float smoothNoise(int x, int y) {
-    float corners = (noise(x-1, y-1) + noise(x+1, y-1) + noise(x-1, y+1) + noise(x+1, y+1)) / 16.0f;
-    float sides = (noise(x-1, y) + noise(x+1, y) + noise(x, y-1) + noise(x, y+1)) / 8.0f;
-    float center = noise(x, y) / 4.0f;
-    return corners + sides + center;
+float noise(int x, int y) {
+    return noiseLattice(worldSeed, x, y);
 }
 
 /*
- * interpolatedNoise
+ * perlinNoise
  *
- * Generates an interpolated noise value for a given coordinate.
+ * Generates Perlin noise for a given coordinate using multiple octaves.
  *
  * @param[in] x The x-coordinate
  * @param[in] y The y-coordinate
- * @return float The interpolated noise value
+ * @param[in] persistence The persistence value
+ * @param[in] octaves The number of octaves
+ * @return float The Perlin noise value
  */
-float interpolatedNoise(float x, float y) {
-    int intX = (int)x;
-    float fracX = x - intX;
-    int intY = (int)y;
-    float fracY = y - intY;
-
-    float v1 = smoothNoise(intX, intY);
-    float v2 = smoothNoise(intX + 1, intY);
-    float v3 = smoothNoise(intX, intY + 1);
-    float v4 = smoothNoise(intX + 1, intY + 1);
-
-    float i1 = v1 * (1 - fracX) + v2 * fracX;
-    float i2 = v3 * (1 - fracX) + v4 * fracX;
-
-    return i1 * (1 - fracY) + i2 * fracY;
+float perlinNoise(float x, float y, float persistence, int octaves) {
+    return noiseFbm2D(worldSeed, x, y, persistence, octaves);
 }
 
 /*
- * perlinNoise
+ * perlinNoiseRow
  *
- * Generates Perlin noise for a given coordinate using multiple octaves.
+ * Row version of perlinNoise: out[i] = perlinNoise(x0 + i * step, y, ...).
  *
- * @param[in] x The x-coordinate
- * @param[in] y The y-coordinate
+ * @param[in] x0 The x-coordinate of the first sample
+ * @param[in] y The y-coordinate shared by the row
+ * @param[in] step The distance between samples
+ * @param[in] count The number of samples
  * @param[in] persistence The persistence value
  * @param[in] octaves The number of octaves
- * @return float The Perlin noise value
+ * @param[out] out Receives count noise values
  */
-float perlinNoise(float x, float y, float persistence, int octaves) {
-    float total = 0;
-    float frequency = 1;
-    float amplitude = 1;
-    float maxValue = 0;
-
-    for(int i = 0; i < octaves; i++) {
-        total += interpolatedNoise(x * frequency, y * frequency) * amplitude;
-        maxValue += amplitude;
-        amplitude *= persistence;
-        frequency *= 2;
-    }
-
-    return total / maxValue;
+void perlinNoiseRow(float x0, float y, float step, int count, float persistence, int octaves, float* out) {
+    noiseFbmRow(worldSeed, x0, y, step, count, persistence, octaves, out);
 }
 
 // Global chunk manager
 ChunkManager* globalChunkManager = NULL;
+static ChunkStreamCallback chunkStreamCallback = NULL;
+
+void setChunkStreamCallback(ChunkStreamCallback callback) {
+    chunkStreamCallback = callback;
+}
 
 void initChunkManager(ChunkManager* manager, int loadRadius) {
     manager->loadRadius = loadRadius;
@@ -345,18 +339,18 @@ void initChunkManager(ChunkManager* manager, int loadRadius) {
         for (int cx = 0; cx < NUM_CHUNKS; cx++) {
             manager->chunkHasData[cy][cx] = false;
             // Initialize stored chunk data
-            for (int y = 0; y < CHUNK_SIZE; y++) {
-                for (int x = 0; x < CHUNK_SIZE; x++) {
-                    manager->storedChunkData[cy][cx][y][x].terrainType = TERRAIN_GRASS;
-                    manager->storedChunkData[cy][cx][y][x].biomeType = BIOME_PLAINS;
-                    manager->storedChunkData[cy][cx][y][x].structureType = 0;
-                    
-                    // Initialize flags without clearing rotation bits
-                    manager->storedChunkData[cy][cx][y][x].flags = 0;
-                    GRIDCELL_SET_WALKABLE(manager->storedChunkData[cy][cx][y][x], true);
-                    GRIDCELL_SET_ORIENTATION(manager->storedChunkData[cy][cx][y][x], 0);
-                    // Don't clear rotation bits anymore
-                }
+            for (int i = 0; i < CHUNK_CELLS; i++) {
+                manager->storedChunkData[cy][cx][i].terrainType = TERRAIN_GRASS;
+                manager->storedChunkData[cy][cx][i].biomeType = BIOME_PLAINS;
+                manager->storedChunkData[cy][cx][i].structureType = 0;
+                manager->storedChunkData[cy][cx][i].materialType = 0;
+                manager->storedChunkData[cy][cx][i].texIndex = 0;
+                
+                // Initialize flags without clearing rotation bits
+                manager->storedChunkData[cy][cx][i].flags = 0;
+                GRIDCELL_SET_WALKABLE(manager->storedChunkData[cy][cx][i], true);
+                GRIDCELL_SET_ORIENTATION(manager->storedChunkData[cy][cx][i], 0);
+                // Don't clear rotation bits anymore
             }
         }
     }
@@ -364,38 +358,24 @@ void initChunkManager(ChunkManager* manager, int loadRadius) {
     printf("Chunk manager initialized with radius %d\n", loadRadius);
 }
 
+/*
+ * initializeChunk
+ *
+ * Fills a chunk with the procedural terrain for the current world seed.
+ *
+ * @param[out] chunk The chunk to fill
+ * @param[in] chunkX Chunk column
+ * @param[in] chunkY Chunk row
+ */
 void initializeChunk(Chunk* chunk, int chunkX, int chunkY) {
-    chunk->chunkX = chunkX;
-    chunk->chunkY = chunkY;
-    chunk->isLoaded = true;
-    
-    for (int y = 0; y < CHUNK_SIZE; y++) {
-        for (int x = 0; x < CHUNK_SIZE; x++) {
-            int mapX = chunkX * CHUNK_SIZE + x;
-            int mapY = chunkY * CHUNK_SIZE + y;
-            
-            chunk->cells[y][x].flags = 0;
-            chunk->cells[y][x].terrainType = TERRAIN_GRASS;
-            chunk->cells[y][x].biomeType = BIOME_PLAINS;
-            chunk->cells[y][x].structureType = 0;
-            chunk->cells[y][x].materialType = 0;
-            chunk->cells[y][x].wallTexX = 0.0f;
-            chunk->cells[y][x].wallTexY = 0.0f;
-            
-            GRIDCELL_SET_WALKABLE(chunk->cells[y][x], true);
-            GRIDCELL_SET_ORIENTATION(chunk->cells[y][x], 0);
-            GRIDCELL_SET_TERRAIN_VARIATION(chunk->cells[y][x], (uint16_t)((mapX * 31 + mapY * 17) % 4));
-            GRIDCELL_SET_TERRAIN_ROTATION(chunk->cells[y][x], (uint16_t)(rand() % 4));
-            GRIDCELL_SET_STRUCTURE_ROTATION(chunk->cells[y][x], 0);
-        }
-    }
+    generateChunkTerrain(worldSeed, chunkX, chunkY, chunk);
 }
 void cleanupChunkManager(ChunkManager* manager) {
     if (!manager) return;
 
     for (int i = 0; i < MAX_LOADED_CHUNKS; i++) {
         if (manager->chunks[i]) {
-            free(manager->chunks[i]);
+            chunkPoolFree(&globalChunkPool, manager->chunks[i]);
             manager->chunks[i] = NULL;
         }
     }
@@ -404,24 +384,25 @@ void cleanupChunkManager(ChunkManager* manager) {
     printf("Chunk manager cleaned up\n");
 }
 
-ChunkCoord getChunkFromWorldPos(float worldX, float worldY) {
+ChunkCoord getChunkFromTile(int tileX, int tileY) {
     ChunkCoord coord;
-    
-    // Convert from normalized (-1 to 1) to grid coordinates (0 to GRID_SIZE)
-    float gridX = (worldX + 1.0f) * (GRID_SIZE / 2.0f);
-    float gridY = (-worldY + 1.0f) * (GRID_SIZE / 2.0f);
-    
-    // Convert to chunk coordinates with bounds checking
-    coord.x = (int)floorf(gridX / CHUNK_SIZE);
-    coord.y = (int)floorf(gridY / CHUNK_SIZE);
-    
+
+    coord.x = tileX / CHUNK_SIZE;
+    coord.y = tileY / CHUNK_SIZE;
+
     // Clamp to valid range
-    coord.x = fmax(0, fmin(coord.x, NUM_CHUNKS - 1));
-    coord.y = fmax(0, fmin(coord.y, NUM_CHUNKS - 1));
-    
+    if (coord.x < 0) coord.x = 0;
+    if (coord.y < 0) coord.y = 0;
+    if (coord.x > NUM_CHUNKS - 1) coord.x = NUM_CHUNKS - 1;
+    if (coord.y > NUM_CHUNKS - 1) coord.y = NUM_CHUNKS - 1;
+
     return coord;
 }
 
+ChunkCoord getChunkFromWorldPos(WorldCoord worldX, WorldCoord worldY) {
+    return getChunkFromTile(worldToTile(worldX), worldToTile(worldY));
+}
+
 bool isChunkLoaded(ChunkManager* manager, int chunkX, int chunkY) {
     for (int i = 0; i < manager->numLoadedChunks; i++) {
         if (manager->chunkCoords[i].x == chunkX && 
@@ -442,7 +423,18 @@ Chunk* getChunk(ChunkManager* manager, int chunkX, int chunkY) {
     return NULL;
 }
 
-void updatePlayerChunk(ChunkManager* manager, float playerX, float playerY) {
+/*
+ * updatePlayerChunk
+ *
+ * Tracks which chunk the player is in. Streaming itself is left to the
+ * caller so it can run at the world-edit apply point.
+ *
+ * @param[in,out] manager The chunk manager
+ * @param[in] playerX Player X position (16.16 tiles)
+ * @param[in] playerY Player Y position (16.16 tiles)
+ * @return bool True if the player entered a different chunk
+ */
+bool updatePlayerChunk(ChunkManager* manager, WorldCoord playerX, WorldCoord playerY) {
     ChunkCoord currentChunk = getChunkFromWorldPos(playerX, playerY);
     
     // Only trigger chunk loading if player has moved to a different chunk
@@ -454,17 +446,29 @@ void updatePlayerChunk(ChunkManager* manager, float playerX, float playerY) {
                currentChunk.x, currentChunk.y);
                
         manager->playerChunk = currentChunk;
-        loadChunksAroundPlayer(manager);
+        return true;
     }
+    return false;
 }
 
-bool isPositionInLoadedChunk(float worldX, float worldY) {
-    ChunkCoord coord = getChunkFromWorldPos(worldX, worldY);
+bool isTileInLoadedChunk(int tileX, int tileY) {
+    ChunkCoord coord = getChunkFromTile(tileX, tileY);
     return isChunkLoaded(globalChunkManager, coord.x, coord.y);
 }
 
+bool isPositionInLoadedChunk(WorldCoord worldX, WorldCoord worldY) {
+    return isTileInLoadedChunk(worldToTile(worldX), worldToTile(worldY));
+}
+
 
 
+// Whether a chunk overlaps the 3x3 block clearSpawnArea edits
+static bool chunkTouchesSpawn(ChunkCoord chunk) {
+    int minX = chunk.x * CHUNK_SIZE, minY = chunk.y * CHUNK_SIZE;
+    return WORLD_SPAWN_X + 1 >= minX && WORLD_SPAWN_X - 1 < minX + CHUNK_SIZE &&
+           WORLD_SPAWN_Y + 1 >= minY && WORLD_SPAWN_Y - 1 < minY + CHUNK_SIZE;
+}
+
 void loadChunksAroundPlayer(ChunkManager* manager) {
     if (!manager) return;
 
@@ -495,11 +499,12 @@ void loadChunksAroundPlayer(ChunkManager* manager) {
                         gridY >= 0 && gridY < GRID_SIZE) {
                         
                         // Store complete cell data
-                        manager->storedChunkData[chunkY][chunkX][y][x] = grid[gridY][gridX];
+                        GridCell* stored = &manager->storedChunkData[chunkY][chunkX][chunkCellIndex(x, y)];
+                        *stored = grid[gridY][gridX];
                         
                         // Verify flag preservation during storage
                         uint16_t originalFlags = grid[gridY][gridX].flags;
-                        uint16_t storedFlags = manager->storedChunkData[chunkY][chunkX][y][x].flags;
+                        uint16_t storedFlags = stored->flags;
                         
                         if (storedFlags != originalFlags) {
                             printf("WARNING: Flag storage mismatch at (%d,%d):\n", gridX, gridY);
@@ -515,19 +520,30 @@ void loadChunksAroundPlayer(ChunkManager* manager) {
                 }
             }
             manager->chunkHasData[chunkY][chunkX] = true;
+            gridMarkRegionChanged(chunkX * CHUNK_SIZE, chunkY * CHUNK_SIZE,
+                                  chunkX * CHUNK_SIZE + CHUNK_SIZE - 1, chunkY * CHUNK_SIZE + CHUNK_SIZE - 1,
+                                  GRID_CHANGE_ALL);
             
             // Remove chunk from active list
-            free(manager->chunks[i]);
+            chunkPoolFree(&globalChunkPool, manager->chunks[i]);
             if (i < manager->numLoadedChunks - 1) {
                 manager->chunks[i] = manager->chunks[manager->numLoadedChunks - 1];
                 manager->chunkCoords[i] = manager->chunkCoords[manager->numLoadedChunks - 1];
             }
             manager->chunks[manager->numLoadedChunks - 1] = NULL;
             manager->numLoadedChunks--;
+
+            if (chunkStreamCallback) chunkStreamCallback(chunkX, chunkY, false);
         }
     }
 
-    // Then: Load new chunks within radius
+    // Then: Load new chunks within radius. Chunks without stored data are
+    // read from the map source, or regenerated from the seed in parallel
+    // once the list is known.
+    ChunkCoord generateCoords[MAX_LOADED_CHUNKS];
+    Chunk* generateChunks[MAX_LOADED_CHUNKS];
+    int generateCount = 0;
+
     for (int dy = -effectiveRadius; dy <= effectiveRadius; dy++) {
         for (int dx = -effectiveRadius; dx <= effectiveRadius; dx++) {
             int cx = px + dx;
@@ -549,61 +565,46 @@ void loadChunksAroundPlayer(ChunkManager* manager) {
             if (!alreadyLoaded && manager->numLoadedChunks < MAX_LOADED_CHUNKS) {
                 printf("Loading new chunk at (%d,%d)\n", cx, cy);
                 
-                Chunk* newChunk = (Chunk*)malloc(sizeof(Chunk));
+                Chunk* newChunk = chunkPoolAlloc(&globalChunkPool);
                 if (!newChunk) continue;
 
                 newChunk->chunkX = cx;
                 newChunk->chunkY = cy;
                 newChunk->isLoaded = true;
+
+                manager->chunks[manager->numLoadedChunks] = newChunk;
+                manager->chunkCoords[manager->numLoadedChunks] = (ChunkCoord){cx, cy};
+                manager->numLoadedChunks++;
                 
                 if (manager->chunkHasData[cy][cx]) {
-                    // Restore saved chunk data
+                    // Restore saved chunk data; both sides share the chunk cell layout
                     printf("Restoring data for chunk (%d,%d)\n", cx, cy);
-                    for (int y = 0; y < CHUNK_SIZE; y++) {
-                        for (int x = 0; x < CHUNK_SIZE; x++) {
-                            // Copy complete cell data
-                            newChunk->cells[y][x] = manager->storedChunkData[cy][cx][y][x];
-                            
-                            // Verify flag restoration
-                            uint16_t expectedFlags = manager->storedChunkData[cy][cx][y][x].flags;
-                            uint16_t restoredFlags = newChunk->cells[y][x].flags;
-                            
-                            if (restoredFlags != expectedFlags) {
-                                printf("WARNING: Flag restoration mismatch at (%d,%d):\n", x, y);
-                                printf("  Expected: 0x%04X, Restored: 0x%04X\n", expectedFlags, restoredFlags);
-                            }
-                        }
-                    }
+                    memcpy(newChunk->cells, manager->storedChunkData[cy][cx], sizeof(newChunk->cells));
+                    writeChunkToGrid(newChunk);
+                    if (chunkStreamCallback) chunkStreamCallback(cx, cy, true);
+                } else if (activeMapSource &&
+                           mapSourceReadChunk(activeMapSource, cx, cy, newChunk)) {
+                    // Streamed from the map file
+                    writeChunkToGrid(newChunk);
+                    if (chunkStreamCallback) chunkStreamCallback(cx, cy, true);
                 } else {
-                    // Initialize new chunk with deterministic variations
-                    for (int y = 0; y < CHUNK_SIZE; y++) {
-                        for (int x = 0; x < CHUNK_SIZE; x++) {
-                            int mapX = cx * CHUNK_SIZE + x;
-                            int mapY = cy * CHUNK_SIZE + y;
-                            
-                            newChunk->cells[y][x].terrainType = TERRAIN_GRASS;
-                            newChunk->cells[y][x].biomeType = BIOME_PLAINS;
-                            newChunk->cells[y][x].structureType = 0;
-                            newChunk->cells[y][x].flags = 0;
-                            
-                            GRIDCELL_SET_WALKABLE(newChunk->cells[y][x], true);
-                            GRIDCELL_SET_ORIENTATION(newChunk->cells[y][x], 0);
-                            
-                            uint8_t variation = (uint8_t)((mapX * 31 + mapY * 17) % 4);
-                            GRIDCELL_SET_TERRAIN_VARIATION(newChunk->cells[y][x], variation);
-                            
-                            uint8_t rotation = (uint8_t)(rand() % 4);
-                            GRIDCELL_SET_TERRAIN_ROTATION(newChunk->cells[y][x], rotation);
-                        }
-                    }
+                    // Off the map, or no map at all
+                    generateCoords[generateCount] = (ChunkCoord){cx, cy};
+                    generateChunks[generateCount] = newChunk;
+                    generateCount++;
                 }
+            }
+        }
+    }
 
-                manager->chunks[manager->numLoadedChunks] = newChunk;
-                manager->chunkCoords[manager->numLoadedChunks] = (ChunkCoord){cx, cy};
-                manager->numLoadedChunks++;
-                
-                writeChunkToGrid(newChunk);
+    if (generateCount > 0) {
+        generateChunksParallel(worldSeed, generateCoords, generateChunks, generateCount);
+        for (int i = 0; i < generateCount; i++) {
+            writeChunkToGrid(generateChunks[i]);
+            if (chunkTouchesSpawn(generateCoords[i])) {
+                clearSpawnArea(WORLD_SPAWN_X, WORLD_SPAWN_Y);
             }
+            if (chunkStreamCallback) chunkStreamCallback(generateCoords[i].x, generateCoords[i].y, true);
         }
     }
 }
\ No newline at end of file
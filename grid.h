@@ -17,6 +17,11 @@
 #define NUM_CHUNKS (GRID_SIZE / CHUNK_SIZE)
 #define MAX_LOADED_CHUNKS 25  // 5x5 area around player
 
+// Where a new game puts the player. Generated terrain is cleared around it
+// (clearSpawnArea), so the spawn is part of what a seed produces.
+#define WORLD_SPAWN_X (GRID_SIZE / 2)
+#define WORLD_SPAWN_Y (GRID_SIZE / 2)
+
 // Grid Cell Flag Bit Layout (16-bit)
 // --------------------------------
 #define STRUCTURE_ORIENTATION_MASK 0x000F  // Bits 0-3:   Structure orientation (16 possible orientations)
@@ -61,6 +66,58 @@
 #define GRIDCELL_GET_TERRAIN_VARIATION(cell) \
     ((cell).flags & TERRAIN_VARIATION_MASK) >> 8
 
+// World coordinates
+// --------------------------------
+// Positions are 16.16 fixed point in tile units: the integer part is the
+// tile and the low 16 bits are the offset inside it, so finding the tile
+// under a position is a shift. Tile centres sit at tile + 0.5.
+// View space (-1..1, y up) only appears where rendering and input need it.
+typedef int32_t WorldCoord;
+
+#define WORLD_FRAC_BITS 16
+#define WORLD_ONE  ((WorldCoord)1 << WORLD_FRAC_BITS)
+#define WORLD_HALF (WORLD_ONE >> 1)
+
+static inline WorldCoord worldFromTile(int tile) {
+    return (WorldCoord)(tile * WORLD_ONE) + WORLD_HALF;
+}
+
+static inline int worldToTile(WorldCoord coord) {
+    return coord >> WORLD_FRAC_BITS;
+}
+
+static inline WorldCoord worldFromTiles(float tiles) {
+    return (WorldCoord)(tiles * WORLD_ONE + (tiles < 0.0f ? -0.5f : 0.5f));
+}
+
+static inline float worldToTiles(WorldCoord coord) {
+    return (float)coord / WORLD_ONE;
+}
+
+static inline float tilesToViewX(float tiles) {
+    return 2.0f * tiles / GRID_SIZE - 1.0f;
+}
+
+static inline float tilesToViewY(float tiles) {
+    return 1.0f - 2.0f * tiles / GRID_SIZE;
+}
+
+static inline float worldToViewX(WorldCoord x) {
+    return tilesToViewX(worldToTiles(x));
+}
+
+static inline float worldToViewY(WorldCoord y) {
+    return tilesToViewY(worldToTiles(y));
+}
+
+static inline float viewToTilesX(float viewX) {
+    return (viewX + 1.0f) * (GRID_SIZE / 2.0f);
+}
+
+static inline float viewToTilesY(float viewY) {
+    return (1.0f - viewY) * (GRID_SIZE / 2.0f);
+}
+
 // Type definitions
 typedef enum {
     TERRAIN_WATER,
@@ -84,7 +141,9 @@ typedef enum {
 
 typedef struct {
     TerrainType terrainTypes[3];
-    float heightThresholds[2];
+    float heightThresholds[2];   // Detail cutoffs for terrainTypes[2] and terrainTypes[1]
+    float minHeight, maxHeight;  // Normalized height band the biome occupies
+    float minMoisture, maxMoisture;
 } BiomeData;
 
 typedef struct {
@@ -93,17 +152,57 @@ typedef struct {
     uint8_t structureType;   // StructureType enum
     uint8_t biomeType;       // BiomeType enum
     uint8_t materialType;    // MaterialType enum
-    float wallTexX;          // Texture coordinates
-    float wallTexY;
+    uint16_t texIndex;       // Structure atlas tile (row * ATLAS_COLS + col, see texture_coords.h)
 } GridCell;
 
+// Cells are copied in bulk by chunk streaming and scanned by rendering and
+// pathfinding; keep them at 8 bytes so a cache line holds 8 of them.
+_Static_assert(sizeof(GridCell) == 8, "GridCell must stay 8 bytes");
+
 typedef struct {
     int x;
     int y;
 } ChunkCoord;
 
+// Chunk cell layout
+// --------------------------------
+// Chunk buffers (streamed chunks and stored chunk data) hold their cells in
+// a flat array addressed through CHUNK_CELL. By default the order is row
+// major. Building with -DCHUNK_MORTON_LAYOUT switches to Z-order instead:
+// the bits of x and y are interleaved, so each 2x2, 4x4, ... block is
+// contiguous and vertical neighbours are at most a few cells apart rather
+// than a whole row. bench_grid_layout compares the two on neighbourhood
+// kernels. The live grid[][] stays row major either way; at GRID_SIZE it
+// fits in L1 and the renderer walks it by rows.
+#define CHUNK_CELLS (CHUNK_SIZE * CHUNK_SIZE)
+
+// Spreads the low 3 bits of v to bits 0, 2 and 4
+static inline int mortonSpread3(int v) {
+    v = (v | (v << 2)) & 0x33;
+    return (v | (v << 1)) & 0x15;
+}
+
+// Z-order index of cell (x, y) inside an 8x8 chunk
+static inline int chunkMortonIndex(int x, int y) {
+    return mortonSpread3(x) | (mortonSpread3(y) << 1);
+}
+
+#ifdef CHUNK_MORTON_LAYOUT
+_Static_assert(CHUNK_SIZE == 8, "chunkMortonIndex interleaves 3 bits per axis");
+
+static inline int chunkCellIndex(int x, int y) {
+    return chunkMortonIndex(x, y);
+}
+#else
+static inline int chunkCellIndex(int x, int y) {
+    return y * CHUNK_SIZE + x;
+}
+#endif
+
+#define CHUNK_CELL(chunk, x, y) ((chunk)->cells[chunkCellIndex((x), (y))])
+
 typedef struct {
-    GridCell cells[CHUNK_SIZE][CHUNK_SIZE];
+    GridCell cells[CHUNK_CELLS];  // Indexed by chunkCellIndex; use CHUNK_CELL
     int chunkX;
     int chunkY;
     bool isLoaded;
@@ -115,7 +214,7 @@ typedef struct {
     ChunkCoord playerChunk;
     int loadRadius;
     int numLoadedChunks;
-    GridCell storedChunkData[NUM_CHUNKS][NUM_CHUNKS][CHUNK_SIZE][CHUNK_SIZE];
+    GridCell storedChunkData[NUM_CHUNKS][NUM_CHUNKS][CHUNK_CELLS];  // Same layout as Chunk.cells
     bool chunkHasData[NUM_CHUNKS][NUM_CHUNKS];
 } ChunkManager;
 
@@ -123,6 +222,7 @@ typedef struct {
 extern GridCell grid[GRID_SIZE][GRID_SIZE];
 extern BiomeData biomeData[BIOME_COUNT];
 extern ChunkManager* globalChunkManager;
+extern uint32_t worldSeed;
 
 // Function declarations
 void initializeGrid(int size);
@@ -130,21 +230,34 @@ void cleanupGrid(void);
 bool isWalkable(int x, int y);
 void setGridSize(int size);
 bool isValid(int x, int y);
-void generateTerrain(void);
+void markGridUnloaded(void);
+void clearSpawnArea(int centerX, int centerY);
 void generateTerrainForChunk(Chunk* chunk);
 void initializeChunk(Chunk* chunk, int chunkX, int chunkY);
 void processChunk(Chunk* chunk);
 void writeChunkToGrid(const Chunk* chunk);
 void debugPrintGridSection(int startX, int startY, int width, int height);
 
+// Terrain noise (deterministic for a given world seed)
+void setWorldSeed(uint32_t seed);
+float noise(int x, int y);
+float perlinNoise(float x, float y, float persistence, int octaves);
+void perlinNoiseRow(float x0, float y, float step, int count, float persistence, int octaves, float* out);
+
 // Chunk management functions
 void initChunkManager(ChunkManager* manager, int loadRadius);
 void cleanupChunkManager(ChunkManager* manager);
-ChunkCoord getChunkFromWorldPos(float worldX, float worldY);
-bool isPositionInLoadedChunk(float worldX, float worldY);
+ChunkCoord getChunkFromTile(int tileX, int tileY);
+ChunkCoord getChunkFromWorldPos(WorldCoord worldX, WorldCoord worldY);
+bool isTileInLoadedChunk(int tileX, int tileY);
+bool isPositionInLoadedChunk(WorldCoord worldX, WorldCoord worldY);
 bool isChunkLoaded(ChunkManager* manager, int chunkX, int chunkY);
-void updatePlayerChunk(ChunkManager* manager, float playerX, float playerY);
+bool updatePlayerChunk(ChunkManager* manager, WorldCoord playerX, WorldCoord playerY);
 void loadChunksAroundPlayer(ChunkManager* manager);
+
+// Called by loadChunksAroundPlayer after each chunk leaves or enters the grid
+typedef void (*ChunkStreamCallback)(int chunkX, int chunkY, bool loaded);
+void setChunkStreamCallback(ChunkStreamCallback callback);
 Chunk* getChunk(ChunkManager* manager, int chunkX, int chunkY);
 
 #endif // GRID_H
\ No newline at end of file
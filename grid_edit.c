@@ -0,0 +1,250 @@
+// grid_edit.c
+
+#include "grid_edit.h"
+#include "grid_planes.h"
+#include <stdio.h>
+#include <stdatomic.h>
+
+typedef struct {
+    GridChangeListener listener;
+    uint32_t mask;
+    void* userData;
+} ListenerEntry;
+
+// Listeners are registered during initialization, before the physics
+// thread starts, and are only read afterwards.
+static ListenerEntry listeners[MAX_GRID_LISTENERS];
+static int listenerCount = 0;
+
+static atomic_uint chunkVersions[NUM_CHUNKS][NUM_CHUNKS];
+static atomic_uint globalVersion;
+
+// Batches are per thread: the physics thread and the main thread can both
+// be in the middle of an edit.
+static _Thread_local int batchDepth = 0;
+static _Thread_local GridRect batchRect;
+static _Thread_local uint32_t batchMask = 0;
+
+bool gridAddChangeListener(GridChangeListener listener, uint32_t mask, void* userData) {
+    if (!listener) return false;
+    if (listenerCount >= MAX_GRID_LISTENERS) {
+        fprintf(stderr, "Too many grid change listeners\n");
+        return false;
+    }
+    listeners[listenerCount++] = (ListenerEntry){ listener, mask, userData };
+    return true;
+}
+
+void gridRemoveChangeListener(GridChangeListener listener, void* userData) {
+    for (int i = 0; i < listenerCount; i++) {
+        if (listeners[i].listener == listener && listeners[i].userData == userData) {
+            listeners[i] = listeners[--listenerCount];
+            return;
+        }
+    }
+}
+
+static void dispatch(const GridRect* rect, uint32_t mask) {
+    GridChangeEvent event = { *rect, mask, atomic_load(&globalVersion) };
+    for (int i = 0; i < listenerCount; i++) {
+        if (listeners[i].mask & mask) {
+            listeners[i].listener(&event, listeners[i].userData);
+        }
+    }
+}
+
+static void publish(int minX, int minY, int maxX, int maxY, uint32_t mask) {
+    if (batchDepth > 0) {
+        if (batchMask == 0) {
+            batchRect = (GridRect){ minX, minY, maxX, maxY };
+        } else {
+            if (minX < batchRect.minX) batchRect.minX = minX;
+            if (minY < batchRect.minY) batchRect.minY = minY;
+            if (maxX > batchRect.maxX) batchRect.maxX = maxX;
+            if (maxY > batchRect.maxY) batchRect.maxY = maxY;
+        }
+        batchMask |= mask;
+        return;
+    }
+
+    GridRect rect = { minX, minY, maxX, maxY };
+    dispatch(&rect, mask);
+}
+
+void gridBeginBatch(void) {
+    batchDepth++;
+}
+
+void gridEndBatch(void) {
+    if (batchDepth <= 0) {
+        fprintf(stderr, "gridEndBatch without matching gridBeginBatch\n");
+        return;
+    }
+    if (--batchDepth == 0 && batchMask != 0) {
+        GridRect rect = batchRect;
+        uint32_t mask = batchMask;
+        batchMask = 0;
+        dispatch(&rect, mask);
+    }
+}
+
+static void commitCell(int x, int y, uint32_t mask) {
+    if (mask & GRID_CHANGE_WALKABLE) {
+        gridPlanesSyncCell(x, y);
+    }
+    atomic_fetch_add(&chunkVersions[y / CHUNK_SIZE][x / CHUNK_SIZE], 1);
+    atomic_fetch_add(&globalVersion, 1);
+    publish(x, y, x, y, mask);
+}
+
+/*
+ * gridWriteCell
+ *
+ * Replaces a whole cell, publishing only the kinds of change that differ.
+ *
+ * @param[in] x Tile column
+ * @param[in] y Tile row
+ * @param[in] cell New cell contents
+ * @return bool True if anything changed
+ */
+bool gridWriteCell(int x, int y, GridCell cell) {
+    if (!isValid(x, y)) return false;
+
+    GridCell* old = &grid[y][x];
+    uint32_t mask = 0;
+
+    if (old->terrainType != cell.terrainType || old->biomeType != cell.biomeType ||
+        (old->flags & TERRAIN_MASK) != (cell.flags & TERRAIN_MASK)) {
+        mask |= GRID_CHANGE_TERRAIN;
+    }
+    if (old->structureType != cell.structureType || old->materialType != cell.materialType ||
+        (old->flags & ~(TERRAIN_MASK | WALKABLE_MASK)) != (cell.flags & ~(TERRAIN_MASK | WALKABLE_MASK))) {
+        mask |= GRID_CHANGE_STRUCTURE;
+    }
+    if ((old->flags & WALKABLE_MASK) != (cell.flags & WALKABLE_MASK)) {
+        mask |= GRID_CHANGE_WALKABLE;
+    }
+    if (old->texIndex != cell.texIndex) {
+        mask |= GRID_CHANGE_TEXTURE;
+    }
+    if (!mask) return false;
+
+    *old = cell;
+    commitCell(x, y, mask);
+    return true;
+}
+
+bool gridSetTerrain(int x, int y, TerrainType terrain) {
+    if (!isValid(x, y) || grid[y][x].terrainType == (uint8_t)terrain) return false;
+    grid[y][x].terrainType = (uint8_t)terrain;
+    commitCell(x, y, GRID_CHANGE_TERRAIN);
+    return true;
+}
+
+bool gridSetBiome(int x, int y, BiomeType biome) {
+    if (!isValid(x, y) || grid[y][x].biomeType == (uint8_t)biome) return false;
+    grid[y][x].biomeType = (uint8_t)biome;
+    commitCell(x, y, GRID_CHANGE_TERRAIN);
+    return true;
+}
+
+bool gridSetStructure(int x, int y, uint8_t structureType, uint8_t materialType) {
+    if (!isValid(x, y)) return false;
+    if (grid[y][x].structureType == structureType && grid[y][x].materialType == materialType) {
+        return false;
+    }
+    grid[y][x].structureType = structureType;
+    grid[y][x].materialType = materialType;
+    commitCell(x, y, GRID_CHANGE_STRUCTURE);
+    return true;
+}
+
+/*
+ * gridClearStructure
+ *
+ * Removes whatever structure occupies a tile and makes it walkable again.
+ *
+ * @param[in] x Tile column
+ * @param[in] y Tile row
+ * @return bool True if anything changed
+ */
+bool gridClearStructure(int x, int y) {
+    if (!isValid(x, y)) return false;
+
+    GridCell cell = grid[y][x];
+    cell.structureType = 0;
+    cell.materialType = 0;
+    GRIDCELL_SET_WALKABLE(cell, true);
+    return gridWriteCell(x, y, cell);
+}
+
+bool gridSetMaterial(int x, int y, uint8_t materialType) {
+    if (!isValid(x, y) || grid[y][x].materialType == materialType) return false;
+    grid[y][x].materialType = materialType;
+    commitCell(x, y, GRID_CHANGE_STRUCTURE);
+    return true;
+}
+
+bool gridSetWalkable(int x, int y, bool walkable) {
+    if (!isValid(x, y) || (GRIDCELL_IS_WALKABLE(grid[y][x]) != 0) == walkable) return false;
+    GRIDCELL_SET_WALKABLE(grid[y][x], walkable);
+    commitCell(x, y, GRID_CHANGE_WALKABLE);
+    return true;
+}
+
+bool gridSetOrientation(int x, int y, uint8_t orientation) {
+    if (!isValid(x, y) || GRIDCELL_GET_ORIENTATION(grid[y][x]) == (orientation & 0x0F)) return false;
+    GRIDCELL_SET_ORIENTATION(grid[y][x], orientation);
+    commitCell(x, y, GRID_CHANGE_STRUCTURE);
+    return true;
+}
+
+bool gridSetTexIndex(int x, int y, uint16_t texIndex) {
+    if (!isValid(x, y) || grid[y][x].texIndex == texIndex) return false;
+    grid[y][x].texIndex = texIndex;
+    commitCell(x, y, GRID_CHANGE_TEXTURE);
+    return true;
+}
+
+/*
+ * gridMarkRegionChanged
+ *
+ * Bumps the versions of every chunk overlapping the region and publishes
+ * one event for it. Used by code that rewrites whole areas of grid[][]
+ * directly, such as chunk streaming.
+ *
+ * @param[in] minX Left tile (inclusive)
+ * @param[in] minY Top tile (inclusive)
+ * @param[in] maxX Right tile (inclusive)
+ * @param[in] maxY Bottom tile (inclusive)
+ * @param[in] mask GRID_CHANGE_* bits describing the change
+ */
+void gridMarkRegionChanged(int minX, int minY, int maxX, int maxY, uint32_t mask) {
+    if (minX < 0) minX = 0;
+    if (minY < 0) minY = 0;
+    if (maxX >= GRID_SIZE) maxX = GRID_SIZE - 1;
+    if (maxY >= GRID_SIZE) maxY = GRID_SIZE - 1;
+    if (minX > maxX || minY > maxY) return;
+
+    if (mask & GRID_CHANGE_WALKABLE) {
+        gridPlanesSyncRegion(minX, minY, maxX, maxY);
+    }
+    for (int cy = minY / CHUNK_SIZE; cy <= maxY / CHUNK_SIZE; cy++) {
+        for (int cx = minX / CHUNK_SIZE; cx <= maxX / CHUNK_SIZE; cx++) {
+            atomic_fetch_add(&chunkVersions[cy][cx], 1);
+        }
+    }
+    atomic_fetch_add(&globalVersion, 1);
+    publish(minX, minY, maxX, maxY, mask);
+}
+
+uint32_t gridVersion(void) {
+    return atomic_load(&globalVersion);
+}
+
+uint32_t gridChunkVersion(int chunkX, int chunkY) {
+    if (chunkX < 0 || chunkX >= NUM_CHUNKS || chunkY < 0 || chunkY >= NUM_CHUNKS) {
+        return 0;
+    }
+    return atomic_load(&chunkVersions[chunkY][chunkX]);
+}
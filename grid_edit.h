@@ -0,0 +1,71 @@
+#ifndef GRID_EDIT_H
+#define GRID_EDIT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "grid.h"
+
+// Every write to grid[][] goes through this API. Each change bumps the
+// version counter of the chunk it lands in, updates the walkability
+// bit-plane (grid_planes.h) and is published to the registered listeners
+// together with a dirty rectangle, so caches can invalidate exactly what
+// changed. Reads still use grid[][] directly.
+
+#define MAX_GRID_LISTENERS 16
+
+// What changed; listeners filter on these bits
+#define GRID_CHANGE_TERRAIN     0x01  // terrainType, biomeType, terrain flag bits
+#define GRID_CHANGE_STRUCTURE   0x02  // structureType, materialType, orientation
+#define GRID_CHANGE_WALKABLE    0x04
+#define GRID_CHANGE_TEXTURE     0x08
+#define GRID_CHANGE_STREAMING   0x10  // Chunk loaded or unloaded
+#define GRID_CHANGE_ALL         0x1F
+
+typedef struct {
+    int minX, minY;   // Inclusive tile bounds
+    int maxX, maxY;
+} GridRect;
+
+typedef struct {
+    GridRect rect;
+    uint32_t mask;      // GRID_CHANGE_* bits
+    uint32_t version;   // Grid version after the change
+} GridChangeEvent;
+
+// Called on the thread that made the change
+typedef void (*GridChangeListener)(const GridChangeEvent* event, void* userData);
+
+bool gridAddChangeListener(GridChangeListener listener, uint32_t mask, void* userData);
+void gridRemoveChangeListener(GridChangeListener listener, void* userData);
+
+// Batches coalesce all changes until the outermost gridEndBatch into one event
+void gridBeginBatch(void);
+void gridEndBatch(void);
+
+// Cell mutators; return true if the cell actually changed
+bool gridWriteCell(int x, int y, GridCell cell);
+bool gridSetTerrain(int x, int y, TerrainType terrain);
+bool gridSetBiome(int x, int y, BiomeType biome);
+bool gridSetStructure(int x, int y, uint8_t structureType, uint8_t materialType);
+bool gridClearStructure(int x, int y);
+bool gridSetMaterial(int x, int y, uint8_t materialType);
+bool gridSetWalkable(int x, int y, bool walkable);
+bool gridSetOrientation(int x, int y, uint8_t orientation);
+bool gridSetTexIndex(int x, int y, uint16_t texIndex);
+
+// For bulk writers that fill grid[][] themselves (chunk streaming, map import)
+void gridMarkRegionChanged(int minX, int minY, int maxX, int maxY, uint32_t mask);
+
+uint32_t gridVersion(void);
+uint32_t gridChunkVersion(int chunkX, int chunkY);
+
+static inline bool gridRectContains(const GridRect* rect, int x, int y) {
+    return x >= rect->minX && x <= rect->maxX && y >= rect->minY && y <= rect->maxY;
+}
+
+static inline bool gridRectsOverlap(const GridRect* a, const GridRect* b) {
+    return a->minX <= b->maxX && b->minX <= a->maxX &&
+           a->minY <= b->maxY && b->minY <= a->maxY;
+}
+
+#endif // GRID_EDIT_H
@@ -0,0 +1,174 @@
+// grid_planes.c
+#include "grid_planes.h"
+#include "grid_summary.h"
+#include "entity.h"
+
+_Atomic uint64_t walkablePlane[PLANE_SPAN];
+_Atomic uint64_t occupiedPlane[PLANE_SPAN];
+
+// Entities per tile; a tile's occupied bit is set while its count is
+// non-zero. Wide enough that every entity can stand on the same tile.
+static atomic_ushort occupantCount[GRID_SIZE][GRID_SIZE];
+
+_Static_assert(MAX_ENTITIES <= 0xFFFF, "occupantCount must not wrap");
+
+// Entity id + 1 holding each tile's reservation, 0 while unclaimed
+static atomic_int reservation[GRID_SIZE][GRID_SIZE];
+
+// Replaces the bits under mask in one row
+static void storeRowBits(_Atomic uint64_t* plane, int y, uint64_t mask, uint64_t bits) {
+    _Atomic uint64_t* row = &plane[y + 1];
+    uint64_t old = atomic_load_explicit(row, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(row, &old, (old & ~mask) | (bits & mask),
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+/*
+ * gridPlanesSyncCell
+ *
+ * Copies one cell's walkable flag into walkablePlane.
+ *
+ * @param[in] x Tile column
+ * @param[in] y Tile row
+ */
+void gridPlanesSyncCell(int x, int y) {
+    if (!isValid(x, y)) return;
+
+    uint64_t bit = (uint64_t)1 << (x + 1);
+    if (GRIDCELL_IS_WALKABLE(grid[y][x])) {
+        atomic_fetch_or_explicit(&walkablePlane[y + 1], bit, memory_order_relaxed);
+    } else {
+        atomic_fetch_and_explicit(&walkablePlane[y + 1], ~bit, memory_order_relaxed);
+    }
+}
+
+/*
+ * gridPlanesSyncRegion
+ *
+ * Rebuilds walkablePlane for a rectangle of cells, one word write per row.
+ *
+ * @param[in] minX Left tile (inclusive)
+ * @param[in] minY Top tile (inclusive)
+ * @param[in] maxX Right tile (inclusive)
+ * @param[in] maxY Bottom tile (inclusive)
+ */
+void gridPlanesSyncRegion(int minX, int minY, int maxX, int maxY) {
+    if (minX < 0) minX = 0;
+    if (minY < 0) minY = 0;
+    if (maxX >= GRID_SIZE) maxX = GRID_SIZE - 1;
+    if (maxY >= GRID_SIZE) maxY = GRID_SIZE - 1;
+    if (minX > maxX || minY > maxY) return;
+
+    uint64_t mask = planeSpanMask(minX, maxX);
+    for (int y = minY; y <= maxY; y++) {
+        uint64_t bits = 0;
+        for (int x = minX; x <= maxX; x++) {
+            if (GRIDCELL_IS_WALKABLE(grid[y][x])) {
+                bits |= (uint64_t)1 << (x + 1);
+            }
+        }
+        storeRowBits(walkablePlane, y, mask, bits);
+    }
+}
+
+// Makes the tile's occupied bit match its count. Entering and leaving can
+// race on the same tile, so re-check the count after writing and repeat if
+// it moved; whoever writes last sees the final count.
+static void syncOccupiedBit(int x, int y) {
+    uint64_t bit = (uint64_t)1 << (x + 1);
+    unsigned short count = atomic_load(&occupantCount[y][x]);
+    for (;;) {
+        if (count) {
+            atomic_fetch_or_explicit(&occupiedPlane[y + 1], bit, memory_order_relaxed);
+        } else {
+            atomic_fetch_and_explicit(&occupiedPlane[y + 1], ~bit, memory_order_relaxed);
+        }
+        unsigned short now = atomic_load(&occupantCount[y][x]);
+        if ((now != 0) == (count != 0)) break;
+        count = now;
+    }
+}
+
+void occupancyEnter(int x, int y) {
+    if (!isValid(x, y)) return;
+    chunkSummaryAddEntities(x, y, 1);
+    if (atomic_fetch_add(&occupantCount[y][x], 1) == 0) {
+        syncOccupiedBit(x, y);
+    }
+}
+
+// Tolerates leaving an empty tile, which happens when an entity is moved
+// after occupancyReset
+void occupancyLeave(int x, int y) {
+    if (!isValid(x, y)) return;
+
+    unsigned short count = atomic_load(&occupantCount[y][x]);
+    do {
+        if (count == 0) return;
+    } while (!atomic_compare_exchange_weak(&occupantCount[y][x], &count, count - 1));
+    chunkSummaryAddEntities(x, y, -1);
+
+    if (count == 1) {
+        syncOccupiedBit(x, y);
+    }
+}
+
+/*
+ * occupancyReset
+ *
+ * Forgets all entity positions and tile reservations. Called before
+ * entities are (re)spawned.
+ */
+void occupancyReset(void) {
+    for (int y = 0; y < GRID_SIZE; y++) {
+        for (int x = 0; x < GRID_SIZE; x++) {
+            atomic_store(&occupantCount[y][x], 0);
+        }
+    }
+    for (int y = 0; y < GRID_SIZE; y++) {
+        for (int x = 0; x < GRID_SIZE; x++) {
+            atomic_store(&reservation[y][x], 0);
+        }
+    }
+    for (int i = 0; i < PLANE_SPAN; i++) {
+        atomic_store(&occupiedPlane[i], 0);
+    }
+    chunkSummaryResetEntities();
+}
+
+// Entities standing on a tile; 0 outside the grid
+int tileOccupants(int x, int y) {
+    if (!isValid(x, y)) return 0;
+    return atomic_load_explicit(&occupantCount[y][x], memory_order_relaxed);
+}
+
+/*
+ * tileReserve
+ *
+ * Claims a tile for an entity's next step. Claiming a tile the entity
+ * already holds succeeds.
+ *
+ * @param[in] x Tile column
+ * @param[in] y Tile row
+ * @param[in] id Claiming entity
+ * @return bool False if another entity holds the tile
+ */
+bool tileReserve(int x, int y, int id) {
+    if (!isValid(x, y)) return true;
+
+    int expected = 0;
+    return atomic_compare_exchange_strong(&reservation[y][x], &expected, id + 1) || expected == id + 1;
+}
+
+// Only the holder can release; anything else is ignored
+void tileRelease(int x, int y, int id) {
+    if (!isValid(x, y)) return;
+
+    int expected = id + 1;
+    atomic_compare_exchange_strong(&reservation[y][x], &expected, 0);
+}
+
+bool tileReserved(int x, int y) {
+    return isValid(x, y) && atomic_load_explicit(&reservation[y][x], memory_order_relaxed) != 0;
+}
@@ -0,0 +1,83 @@
+#ifndef GRID_PLANES_H
+#define GRID_PLANES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "grid.h"
+
+// Bit-planes mirroring per-cell booleans of the grid: one bit per cell and
+// one 64-bit word per row. Cell (x, y) is bit x + 1 of row y + 1, so every
+// plane has a one-cell border of zero bits and neighbourhood tests around
+// any in-grid cell need no bounds checks.
+//
+// walkablePlane mirrors the walkable flag and is kept current by the
+// grid_edit mutators. occupiedPlane marks tiles with at least one entity
+// on them and is maintained by entity movement. Both are written with
+// atomic RMW and read relaxed, so any thread may query them.
+//
+// Next to the planes sits the tile reservation table: the entity that has
+// claimed a tile for its next step. Entities claim a tile with a CAS
+// before stepping towards it and release it once they are on it (and
+// counted by occupiedPlane), so no two entities step onto the same tile.
+
+#define PLANE_SPAN (GRID_SIZE + 2)  // Rows per plane, and bits used per row
+
+_Static_assert(GRID_SIZE + 2 <= 64, "bit-plane rows are a single word; widen them if the grid grows");
+
+extern _Atomic uint64_t walkablePlane[PLANE_SPAN];
+extern _Atomic uint64_t occupiedPlane[PLANE_SPAN];
+
+// Plane maintenance
+void gridPlanesSyncCell(int x, int y);
+void gridPlanesSyncRegion(int minX, int minY, int maxX, int maxY);
+void occupancyEnter(int x, int y);
+void occupancyLeave(int x, int y);
+void occupancyReset(void);
+int tileOccupants(int x, int y);
+
+// Tile reservations, lock-free; out-of-grid tiles are never reserved
+bool tileReserve(int x, int y, int id);
+void tileRelease(int x, int y, int id);
+bool tileReserved(int x, int y);
+
+// Row y of a plane, for -1 <= y <= GRID_SIZE
+static inline uint64_t planeRow(_Atomic uint64_t* plane, int y) {
+    return atomic_load_explicit(&plane[y + 1], memory_order_relaxed);
+}
+
+// Single cell, for -1 <= x, y <= GRID_SIZE
+static inline bool planeTest(_Atomic uint64_t* plane, int x, int y) {
+    return (planeRow(plane, y) >> (x + 1)) & 1;
+}
+
+// 3x3 block centred on an in-grid cell as a 9-bit mask: bit (dy + 1) * 3 + (dx + 1)
+// holds the neighbour at (x + dx, y + dy)
+static inline uint32_t planeNeighbourhood(_Atomic uint64_t* plane, int x, int y) {
+    return (uint32_t)((planeRow(plane, y - 1) >> x) & 7) |
+           (uint32_t)((planeRow(plane, y) >> x) & 7) << 3 |
+           (uint32_t)((planeRow(plane, y + 1) >> x) & 7) << 6;
+}
+
+#define NEIGHBOURHOOD_BIT(dx, dy) (1u << (((dy) + 1) * 3 + (dx) + 1))
+
+// Mask selecting cells x0..x1 (inclusive, -1 <= x0 <= x1 <= GRID_SIZE) of a row
+static inline uint64_t planeSpanMask(int x0, int x1) {
+    return ((~(uint64_t)0) >> (63 - (x1 - x0))) << (x0 + 1);
+}
+
+static inline bool planeSpanAll(_Atomic uint64_t* plane, int y, int x0, int x1) {
+    uint64_t mask = planeSpanMask(x0, x1);
+    return (planeRow(plane, y) & mask) == mask;
+}
+
+static inline bool planeSpanAny(_Atomic uint64_t* plane, int y, int x0, int x1) {
+    return (planeRow(plane, y) & planeSpanMask(x0, x1)) != 0;
+}
+
+// Walkable and not occupied by an entity; same range as planeTest
+static inline bool isTileFree(int x, int y) {
+    return ((planeRow(walkablePlane, y) & ~planeRow(occupiedPlane, y)) >> (x + 1)) & 1;
+}
+
+#endif // GRID_PLANES_H
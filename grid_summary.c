@@ -0,0 +1,102 @@
+// grid_summary.c
+#include "grid_summary.h"
+#include "grid_edit.h"
+#include "structure_types.h"
+#include <stdatomic.h>
+#include <SDL2/SDL.h>
+
+static ChunkSummary summaries[NUM_CHUNKS][NUM_CHUNKS];
+static bool summaryBuilt[NUM_CHUNKS][NUM_CHUNKS];
+static SDL_SpinLock summaryLock;  // Guards summaries and summaryBuilt
+
+static atomic_int chunkEntities[NUM_CHUNKS][NUM_CHUNKS];
+static atomic_int chunkOpenCrates[NUM_CHUNKS][NUM_CHUNKS];
+static atomic_int openCrates;
+
+static void buildSummary(ChunkSummary* summary, int chunkX, int chunkY, uint32_t version) {
+    *summary = (ChunkSummary){ .version = version };
+
+    for (int y = chunkY * CHUNK_SIZE; y < (chunkY + 1) * CHUNK_SIZE; y++) {
+        for (int x = chunkX * CHUNK_SIZE; x < (chunkX + 1) * CHUNK_SIZE; x++) {
+            const GridCell* cell = &grid[y][x];
+
+            summary->walkableCells += GRIDCELL_IS_WALKABLE(*cell) != 0;
+            summary->waterCells += cell->terrainType == TERRAIN_WATER;
+            summary->grassCells += cell->terrainType == TERRAIN_GRASS;
+            summary->unloadedCells += cell->terrainType == TERRAIN_UNLOADED;
+            if (cell->structureType != STRUCTURE_NONE) {
+                summary->structureCells++;
+                if (cell->structureType == STRUCTURE_PLANT) {
+                    summary->plantCells++;
+                    summary->treeCells += cell->materialType == MATERIAL_TREE;
+                }
+            }
+        }
+    }
+}
+
+/*
+ * getChunkSummary
+ *
+ * Returns a chunk's summary, rebuilding the cell counts first if the chunk
+ * changed since they were last built. Safe to call from any thread.
+ *
+ * @param[in] chunkX Chunk column
+ * @param[in] chunkY Chunk row
+ * @return ChunkSummary The summary; all zero for chunks outside the grid
+ */
+ChunkSummary getChunkSummary(int chunkX, int chunkY) {
+    if (chunkX < 0 || chunkX >= NUM_CHUNKS || chunkY < 0 || chunkY >= NUM_CHUNKS) {
+        return (ChunkSummary){0};
+    }
+
+    // Read the version before the cells: an edit that lands during the
+    // scan bumps it again and the next call rebuilds
+    uint32_t version = gridChunkVersion(chunkX, chunkY);
+
+    SDL_AtomicLock(&summaryLock);
+    ChunkSummary* summary = &summaries[chunkY][chunkX];
+    if (!summaryBuilt[chunkY][chunkX] || summary->version != version) {
+        buildSummary(summary, chunkX, chunkY, version);
+        summaryBuilt[chunkY][chunkX] = true;
+    }
+    ChunkSummary result = *summary;
+    SDL_AtomicUnlock(&summaryLock);
+
+    result.entityCount = atomic_load(&chunkEntities[chunkY][chunkX]);
+    int crates = atomic_load(&chunkOpenCrates[chunkY][chunkX]);
+    result.openCrates = (uint8_t)(crates > 0 ? crates : 0);
+    return result;
+}
+
+void chunkSummaryAddEntities(int tileX, int tileY, int delta) {
+    if (!isValid(tileX, tileY)) return;
+    atomic_fetch_add(&chunkEntities[tileY / CHUNK_SIZE][tileX / CHUNK_SIZE], delta);
+}
+
+void chunkSummaryAddOpenCrates(int tileX, int tileY, int delta) {
+    if (!isValid(tileX, tileY)) return;
+    atomic_fetch_add(&chunkOpenCrates[tileY / CHUNK_SIZE][tileX / CHUNK_SIZE], delta);
+    atomic_fetch_add(&openCrates, delta);
+}
+
+void chunkSummaryResetEntities(void) {
+    for (int cy = 0; cy < NUM_CHUNKS; cy++) {
+        for (int cx = 0; cx < NUM_CHUNKS; cx++) {
+            atomic_store(&chunkEntities[cy][cx], 0);
+        }
+    }
+}
+
+void chunkSummaryResetOpenCrates(void) {
+    for (int cy = 0; cy < NUM_CHUNKS; cy++) {
+        for (int cx = 0; cx < NUM_CHUNKS; cx++) {
+            atomic_store(&chunkOpenCrates[cy][cx], 0);
+        }
+    }
+    atomic_store(&openCrates, 0);
+}
+
+int openCrateTotal(void) {
+    return atomic_load(&openCrates);
+}
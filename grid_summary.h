@@ -0,0 +1,45 @@
+#ifndef GRID_SUMMARY_H
+#define GRID_SUMMARY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "grid.h"
+
+// Per-chunk summaries of grid contents, so whole-grid passes (canopy
+// rendering, spawning, saving, searches) can skip chunks that have nothing
+// of interest. Cell counts are rebuilt from grid[][] on demand whenever the
+// chunk's gridChunkVersion has moved on since the last build, so edits pay
+// nothing until someone asks. Entity and open crate counts are not grid
+// data; they are kept current by the occupancy plane and setCrateOpen.
+
+typedef struct {
+    uint32_t version;        // gridChunkVersion the cell counts were built from
+    uint8_t walkableCells;   // Cell counts, each out of CHUNK_CELLS
+    uint8_t waterCells;
+    uint8_t grassCells;
+    uint8_t unloadedCells;
+    uint8_t structureCells;  // Any structure, plants included
+    uint8_t plantCells;
+    uint8_t treeCells;
+    uint8_t openCrates;
+    int entityCount;
+} ChunkSummary;
+
+ChunkSummary getChunkSummary(int chunkX, int chunkY);
+
+static inline bool chunkAllWalkable(const ChunkSummary* summary) {
+    return summary->walkableCells == CHUNK_CELLS;
+}
+
+static inline bool chunkHasWater(const ChunkSummary* summary) {
+    return summary->waterCells != 0;
+}
+
+// Non-grid counters
+void chunkSummaryAddEntities(int tileX, int tileY, int delta);
+void chunkSummaryAddOpenCrates(int tileX, int tileY, int delta);
+void chunkSummaryResetEntities(void);
+void chunkSummaryResetOpenCrates(void);
+int openCrateTotal(void);
+
+#endif // GRID_SUMMARY_H
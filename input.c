@@ -6,9 +6,9 @@
 #include <stdatomic.h>
 #include <stdbool.h>
 #include "grid.h"
+#include "world_commands.h"
 #include "player.h"
 #include "structures.h"
-#include "saveload.h"
 #include "gameloop.h"
 #include "ui.h"
 #include "rendering.h"
@@ -20,17 +20,18 @@ extern Player player;
 extern PlacementMode placementMode;
 extern UIState uiState;
 
-// Convert window coordinates to grid coordinates
+// Convert window coordinates to grid coordinates; the camera is in world tiles
 GridCoordinates WindowToGridCoordinates(int mouseX, int mouseY, float cameraX, float cameraY, float zoomFactor) {
     float ndcX = (2.0f * mouseX / GAME_VIEW_WIDTH - 1.0f) / zoomFactor;
     float ndcY = (1.0f - 2.0f * mouseY / WINDOW_HEIGHT) / zoomFactor;
 
-    float worldX = ndcX + cameraX;
-    float worldY = ndcY + cameraY;
+    // Offsets from the camera, scaled from view space to tiles
+    float worldX = cameraX + ndcX * (GRID_SIZE / 2.0f);
+    float worldY = cameraY - ndcY * (GRID_SIZE / 2.0f);
 
     GridCoordinates coords;
-    coords.gridX = (int)((worldX + 1.0f) * GRID_SIZE / 2);
-    coords.gridY = (int)((1.0f - worldY) * GRID_SIZE / 2);
+    coords.gridX = (int)floorf(worldX);
+    coords.gridY = (int)floorf(worldY);
     
     return coords;
 }
@@ -45,14 +46,14 @@ static void HandleSaveLoad(SDL_KeyboardEvent* key) {
     if (key->keysym.mod & KMOD_CTRL) {
         switch (key->keysym.sym) {
             case SDLK_s:
-                if (saveGameState("game_save.sav")) {
+                if (SaveGame("game_save.sav")) {
                     printf("Game saved successfully!\n");
                 } else {
                     printf("Failed to save game!\n");
                 }
                 break;
             case SDLK_l:
-                if (loadGameState("game_save.sav")) {
+                if (ReloadGame("game_save.sav")) {
                     printf("Game loaded successfully!\n");
                 } else {
                     printf("Failed to load game!\n");
@@ -70,8 +71,8 @@ static void HandleCrateInteraction(int gridX, int gridY, uint8_t button) {
         if (nearest.x != -1) {
             player.entity.finalGoalX = nearest.x;
             player.entity.finalGoalY = nearest.y;
-            player.entity.targetGridX = player.entity.gridX;
-            player.entity.targetGridY = player.entity.gridY;
+            entityStore.targetGridX[player.entity.id] = player.entity.gridX;
+            entityStore.targetGridY[player.entity.id] = player.entity.gridY;
             player.entity.needsPathfinding = true;
             
             player.targetHarvestX = gridX;
@@ -166,7 +167,7 @@ static void HandleCrateInteraction(int gridX, int gridY, uint8_t button) {
         printf("Deposited available plants into crate\n");
     }
     else if (button == SDL_BUTTON_RIGHT) {
-        crate->isOpen = !crate->isOpen;
+        setCrateOpen(crate, !crate->isOpen);
         printf("Toggled crate UI: %s\n", crate->isOpen ? "open" : "closed");
     }
 }
@@ -199,27 +200,7 @@ static void HandleHarvesting(int gridX, int gridY) {
     printf("Attempting to harvest fern at (%d, %d)\n", gridX, gridY);
     
     if (IsWithinPlayerRange(gridX, gridY, player.entity.gridX, player.entity.gridY)) {
-        Item* fernItem = CreateItem(ITEM_FERN);
-        if (!fernItem) {
-            printf("Failed to create fern item\n");
-            return;
-        }
-        
-        printf("Created fern item successfully, adding to inventory...\n");
-        
-        bool added = AddItem(player.inventory, fernItem);
-        printf("AddItem result: %d\n", added);
-        
-        if (added) {
-            awardForagingExp(&player, fernItem);
-            grid[gridY][gridX].structureType = STRUCTURE_NONE;
-            grid[gridY][gridX].materialType = MATERIAL_NONE;
-            GRIDCELL_SET_WALKABLE(grid[gridY][gridX], true);
-            printf("Grid cell cleared after successful harvest\n");
-        } else {
-            printf("Failed to add item to inventory - destroying item\n");
-            DestroyItem(fernItem);
-        }
+        queueHarvest(gridX, gridY, &player);
     } else {
         AdjacentTile nearest = findNearestAdjacentTile(gridX, gridY,
                                                      player.entity.gridX,
@@ -228,14 +209,14 @@ static void HandleHarvesting(int gridX, int gridY) {
         if (nearest.x != -1) {
             player.entity.finalGoalX = nearest.x;
             player.entity.finalGoalY = nearest.y;
-            player.entity.targetGridX = player.entity.gridX;
-            player.entity.targetGridY = player.entity.gridY;
+            entityStore.targetGridX[player.entity.id] = player.entity.gridX;
+            entityStore.targetGridY[player.entity.id] = player.entity.gridY;
             player.entity.needsPathfinding = true;
             
             player.targetHarvestX = gridX;
             player.targetHarvestY = gridY;
             player.hasHarvestTarget = true;
-            player.pendingHarvestType = grid[gridY][gridX].materialType;
+            player.pendingHarvestType = renderFrame.world->cells[gridY][gridX].materialType;
             
             printf("Pathfinding to harvest fern at (%d, %d)\n", gridX, gridY);
         }
@@ -250,8 +231,7 @@ static void HandlePlacement(int gridX, int gridY, Uint8 button) {
     if (button == SDL_BUTTON_LEFT) {
         if (IsWithinPlayerRange(gridX, gridY, playerGridX, playerGridY)) {
             printf("Attempting direct placement at (%d, %d)\n", gridX, gridY);
-bool placed = placeStructure(placementMode.currentType, gridX, gridY, &player);
-            printf("Direct placement result: %s\n", placed ? "success" : "failed");
+            queuePlaceStructure(placementMode.currentType, gridX, gridY, &player);
         } else {
             AdjacentTile nearest = findNearestAdjacentTile(gridX, gridY,
                                                          playerGridX, 
@@ -260,8 +240,8 @@ bool placed = placeStructure(placementMode.currentType, gridX, gridY, &player);
             if (nearest.x != -1) {
                 atomic_store(&player.entity.finalGoalX, nearest.x);
                 atomic_store(&player.entity.finalGoalY, nearest.y);
-                atomic_store(&player.entity.targetGridX, playerGridX);
-                atomic_store(&player.entity.targetGridY, playerGridY);
+                atomic_store(&entityStore.targetGridX[player.entity.id], playerGridX);
+                atomic_store(&entityStore.targetGridY[player.entity.id], playerGridY);
                 atomic_store(&player.entity.needsPathfinding, true);
                 
                 player.targetBuildX = gridX;
@@ -273,9 +253,7 @@ bool placed = placeStructure(placementMode.currentType, gridX, gridY, &player);
     } else if (button == SDL_BUTTON_RIGHT) {
         if (IsWithinPlayerRange(gridX, gridY, playerGridX, playerGridY)) {
             // Clear the tile
-            grid[gridY][gridX].structureType = STRUCTURE_NONE;
-            GRIDCELL_SET_WALKABLE(grid[gridY][gridX], true);
-            updateSurroundingStructures(gridX, gridY);
+            queueClearStructure(gridX, gridY);
         }
     }
 }
@@ -286,8 +264,8 @@ static void HandleMovement(int gridX, int gridY) {
     
     player.entity.finalGoalX = gridX;
     player.entity.finalGoalY = gridY;
-    player.entity.targetGridX = player.entity.gridX;
-    player.entity.targetGridY = player.entity.gridY;
+    entityStore.targetGridX[player.entity.id] = player.entity.gridX;
+    entityStore.targetGridY[player.entity.id] = player.entity.gridY;
     player.entity.needsPathfinding = true;
     printf("Player final goal set: gridX = %d, gridY = %d\n", gridX, gridY);
 }
@@ -333,31 +311,33 @@ static void HandleMouseInput(SDL_Event* event) {
                 if (!clickedCrateUI) {
                     // Close all open crates when clicking outside
                     for (size_t i = 0; i < globalStorageManager.count; i++) {
-                        globalStorageManager.crates[i].isOpen = false;
+                        setCrateOpen(&globalStorageManager.crates[i], false);
                     }
 
                     GridCoordinates coords = WindowToGridCoordinates(mouseX, mouseY, 
-                        player.cameraCurrentX, player.cameraCurrentY, player.zoomFactor);
+                        renderFrame.cameraX, renderFrame.cameraY, player.zoomFactor);
                     
                     if (coords.gridX >= 0 && coords.gridX < GRID_SIZE && 
                         coords.gridY >= 0 && coords.gridY < GRID_SIZE) {
                         
+                        // What the player clicked is what was drawn
+                        GridCell clicked = renderFrame.world->cells[coords.gridY][coords.gridX];
                         if (!placementMode.active) {
-                            switch (grid[coords.gridY][coords.gridX].structureType) {
+                            switch (clicked.structureType) {
                                 case STRUCTURE_PLANT:
-                                    if (grid[coords.gridY][coords.gridX].materialType == MATERIAL_FERN) {
+                                    if (clicked.materialType == MATERIAL_FERN) {
                                         HandleHarvesting(coords.gridX, coords.gridY);
                                     }
                                     break;
                                 case STRUCTURE_DOOR:
                                     printf("Door clicked, attempting toggle\n");
-                                    toggleDoor(coords.gridX, coords.gridY, &player);
+                                    queueToggleDoor(coords.gridX, coords.gridY, &player);
                                     break;
                                 case STRUCTURE_CRATE:
                                     HandleCrateInteraction(coords.gridX, coords.gridY, event->button.button);
                                     break;
                                 default:
-                                    if (GRIDCELL_IS_WALKABLE(grid[coords.gridY][coords.gridX])) {
+                                    if (GRIDCELL_IS_WALKABLE(clicked)) {
                                         HandleMovement(coords.gridX, coords.gridY);
                                     }
                                     break;
@@ -375,7 +355,7 @@ static void HandleMouseInput(SDL_Event* event) {
         case SDL_MOUSEMOTION:
             if (placementMode.active && isPointInGameView(mouseX, mouseY)) {
                 GridCoordinates coords = WindowToGridCoordinates(mouseX, mouseY,
-                    player.cameraCurrentX, player.cameraCurrentY, player.zoomFactor);
+                    renderFrame.cameraX, renderFrame.cameraY, player.zoomFactor);
                 
                 if (coords.gridX >= 0 && coords.gridX < GRID_SIZE && 
                     coords.gridY >= 0 && coords.gridY < GRID_SIZE) {
@@ -0,0 +1,380 @@
+// map_stream.c
+#include "map_stream.h"
+#include "asciiMap.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+MapSource* activeMapSource = NULL;
+
+static uint16_t wang_hash(uint32_t seed) {
+    seed = (seed ^ 61) ^ (seed >> 16);
+    seed *= 9;
+    seed = seed ^ (seed >> 4);
+    seed *= 0x27d4eb2d;
+    seed = seed ^ (seed >> 15);
+    return seed % 4;  // Returns 0-3
+}
+
+static uint16_t get_tile_variation(int x, int y) {
+    // Combine coordinates into a single seed
+    uint32_t seed = (uint32_t)x * 374761393u + (uint32_t)y * 668265263u;
+    // Add a large prime for more randomness
+    seed ^= 0x6eed0e9d;
+    return wang_hash(seed);
+}
+
+static uint16_t get_tile_rotation(int x, int y) {
+    // Use different prime multipliers for rotation
+    uint32_t seed = (uint32_t)x * 487198191u + (uint32_t)y * 286265417u;
+    // Different prime than variation
+    seed ^= 0x43e9b4af;
+    return wang_hash(seed);
+}
+
+// Reads one line of any length. Up to cap - 1 characters are kept in buf
+// (NUL terminated) and the rest of the line is skipped. A trailing "\r\n"
+// is treated like "\n". Returns the full line length, or -1 at end of file.
+static long readMapLine(FILE* file, char* buf, long cap) {
+    char piece[256];
+    long length = 0;
+    long kept = 0;
+    char last = '\0';
+    bool any = false;
+
+    while (fgets(piece, sizeof(piece), file)) {
+        any = true;
+        size_t n = strlen(piece);
+        bool endOfLine = n > 0 && piece[n - 1] == '\n';
+        if (endOfLine) n--;
+
+        if (n > 0) {
+            long room = cap - 1 - kept;
+            long copy = (long)n < room ? (long)n : room;
+            if (copy > 0) {
+                memcpy(buf + kept, piece, (size_t)copy);
+                kept += copy;
+            }
+            length += (long)n;
+            last = piece[n - 1];
+        }
+        if (endOfLine) break;
+    }
+    if (!any) return -1;
+
+    if (last == '\r') {
+        length--;
+        if (kept > length) kept = length;
+    }
+    buf[kept] = '\0';
+    return length;
+}
+
+/*
+ * parseTerrainRow
+ *
+ * Converts count map characters to terrain types, 16 at a time where SSE2
+ * is available. Matches charToTerrain, including the grass fallback.
+ *
+ * @param[in] text Map characters (need not be NUL terminated)
+ * @param[out] terrain Receives count TerrainType values
+ * @param[in] count Number of characters to convert
+ */
+void parseTerrainRow(const char* text, uint8_t* terrain, int count) {
+    int i = 0;
+
+#ifdef __SSE2__
+    const __m128i water = _mm_set1_epi8(CHAR_WATER);
+    const __m128i sand = _mm_set1_epi8(CHAR_SAND);
+    const __m128i stone = _mm_set1_epi8(CHAR_STONE);
+    const __m128i waterType = _mm_set1_epi8(TERRAIN_WATER);
+    const __m128i sandType = _mm_set1_epi8(TERRAIN_SAND);
+    const __m128i stoneType = _mm_set1_epi8(TERRAIN_STONE);
+    const __m128i grassType = _mm_set1_epi8(TERRAIN_GRASS);
+
+    for (; i + 16 <= count; i += 16) {
+        __m128i chars = _mm_loadu_si128((const __m128i*)(text + i));
+        __m128i result = grassType;
+        __m128i mask = _mm_cmpeq_epi8(chars, water);
+        result = _mm_or_si128(_mm_andnot_si128(mask, result), _mm_and_si128(mask, waterType));
+        mask = _mm_cmpeq_epi8(chars, sand);
+        result = _mm_or_si128(_mm_andnot_si128(mask, result), _mm_and_si128(mask, sandType));
+        mask = _mm_cmpeq_epi8(chars, stone);
+        result = _mm_or_si128(_mm_andnot_si128(mask, result), _mm_and_si128(mask, stoneType));
+        _mm_storeu_si128((__m128i*)(terrain + i), result);
+    }
+#endif
+
+    for (; i < count; i++) {
+        terrain[i] = (uint8_t)charToTerrain(text[i]);
+    }
+}
+
+/*
+ * buildChunkFromTerrain
+ *
+ * Fills a chunk's cells from a block of terrain types, the way a new game
+ * lays out a map: no structures, plains biome, per-tile variation and
+ * rotation, and everything but water walkable. chunk->chunkX/chunkY must
+ * already be set; they seed the variation.
+ *
+ * @param[in] terrain Top-left terrain value of the chunk
+ * @param[in] stride Distance between terrain rows
+ * @param[out] chunk The chunk to fill
+ */
+void buildChunkFromTerrain(const uint8_t* terrain, int stride, Chunk* chunk) {
+    for (int y = 0; y < CHUNK_SIZE; y++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            int mapX = chunk->chunkX * CHUNK_SIZE + x;
+            int mapY = chunk->chunkY * CHUNK_SIZE + y;
+            uint8_t type = terrain[y * stride + x];
+            GridCell* cell = &CHUNK_CELL(chunk, x, y);
+
+            cell->flags = 0;
+            cell->terrainType = type;
+            cell->structureType = 0;
+            cell->biomeType = BIOME_PLAINS;  // Maps carry no biome data
+            cell->materialType = 0;
+            cell->texIndex = 0;
+
+            if (type == TERRAIN_GRASS || type == TERRAIN_STONE) {
+                GRIDCELL_SET_TERRAIN_VARIATION(*cell, get_tile_variation(mapX, mapY));
+            }
+            GRIDCELL_SET_TERRAIN_ROTATION(*cell, get_tile_rotation(mapX, mapY));
+            GRIDCELL_SET_WALKABLE(*cell, type != TERRAIN_WATER);
+        }
+    }
+}
+
+/*
+ * openMapSource
+ *
+ * Opens a map for chunk streaming. Nothing beyond the header is read yet.
+ *
+ * @param[in] path ASCII or compiled map file
+ * @return MapSource* The source, or NULL on failure
+ */
+MapSource* openMapSource(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        printf("Failed to open map: %s\n", path);
+        return NULL;
+    }
+
+    MapSource* source = (MapSource*)calloc(1, sizeof(MapSource));
+    if (!source) {
+        printf("Failed to allocate map source\n");
+        fclose(file);
+        return NULL;
+    }
+    source->file = file;
+
+    CompiledMapHeader header;
+    if (fread(&header, sizeof(header), 1, file) == 1 &&
+        memcmp(header.magic, COMPILED_MAP_MAGIC, sizeof(header.magic)) == 0) {
+        if (header.version != COMPILED_MAP_VERSION || header.chunkSize != CHUNK_SIZE) {
+            printf("Unsupported compiled map %s (version %u, chunk size %u)\n",
+                   path, header.version, header.chunkSize);
+            closeMapSource(source);
+            return NULL;
+        }
+        source->format = MAP_SOURCE_COMPILED;
+        source->widthChunks = (int)header.widthChunks;
+        source->heightChunks = (int)header.heightChunks;
+        printf("Streaming compiled map %s (%d x %d chunks)\n",
+               path, source->widthChunks, source->heightChunks);
+        return source;
+    }
+
+    rewind(file);
+    source->format = MAP_SOURCE_ASCII;
+    memset(source->terrain, TERRAIN_GRASS, sizeof(source->terrain));
+    printf("Streaming ASCII map %s\n", path);
+    return source;
+}
+
+void closeMapSource(MapSource* source) {
+    if (!source) return;
+    if (source->file) {
+        fclose(source->file);
+    }
+    free(source);
+}
+
+// Reads ASCII rows until rowCount rows are cached or the file ends
+static void readASCIIRows(MapSource* source, int rowCount) {
+    char line[GRID_SIZE + 1];
+
+    while (source->rowsRead < rowCount && !source->endOfFile) {
+        long length = readMapLine(source->file, line, sizeof(line));
+        if (length < 0) {
+            source->endOfFile = true;
+            break;
+        }
+        int kept = length < GRID_SIZE ? (int)length : GRID_SIZE;
+        parseTerrainRow(line, source->terrain[source->rowsRead], kept);
+        source->rowLength[source->rowsRead] = kept;
+        source->rowsRead++;
+    }
+}
+
+/*
+ * mapSourceReadChunk
+ *
+ * Reads one chunk from the map. Not thread-safe; chunk streaming calls it
+ * from one thread at a time.
+ *
+ * @param[in,out] source The map source
+ * @param[in] chunkX Chunk column
+ * @param[in] chunkY Chunk row
+ * @param[out] chunk Receives the chunk's cells and coordinates
+ * @return bool False if the chunk lies outside the map or cannot be read
+ */
+bool mapSourceReadChunk(MapSource* source, int chunkX, int chunkY, Chunk* chunk) {
+    if (!source || chunkX < 0 || chunkY < 0) return false;
+
+    chunk->chunkX = chunkX;
+    chunk->chunkY = chunkY;
+
+    if (source->format == MAP_SOURCE_COMPILED) {
+        if (chunkX >= source->widthChunks || chunkY >= source->heightChunks) {
+            return false;
+        }
+
+        uint8_t terrain[CHUNK_SIZE * CHUNK_SIZE];
+        long record = (long)chunkY * source->widthChunks + chunkX;
+        long offset = (long)sizeof(CompiledMapHeader) + record * (long)sizeof(terrain);
+        if (fseek(source->file, offset, SEEK_SET) != 0 ||
+            fread(terrain, sizeof(terrain), 1, source->file) != 1) {
+            printf("Failed to read chunk (%d,%d) from compiled map\n", chunkX, chunkY);
+            return false;
+        }
+        buildChunkFromTerrain(terrain, CHUNK_SIZE, chunk);
+        return true;
+    }
+
+    if (chunkX >= NUM_CHUNKS || chunkY >= NUM_CHUNKS) {
+        return false;
+    }
+
+    int startX = chunkX * CHUNK_SIZE;
+    int startY = chunkY * CHUNK_SIZE;
+    readASCIIRows(source, startY + CHUNK_SIZE);
+    if (startY >= source->rowsRead) {
+        return false;
+    }
+
+    bool covered = false;
+    for (int y = startY; y < startY + CHUNK_SIZE && y < source->rowsRead; y++) {
+        if (source->rowLength[y] > startX) {
+            covered = true;
+            break;
+        }
+    }
+    if (!covered) {
+        return false;
+    }
+
+    // Cells past the end of short lines stay grass
+    buildChunkFromTerrain(&source->terrain[startY][startX], GRID_SIZE, chunk);
+    return true;
+}
+
+// Writes one band of CHUNK_SIZE terrain rows as widthChunks chunk records
+static bool writeChunkBand(FILE* out, const uint8_t* band, int widthChunks, int bandStride) {
+    uint8_t record[CHUNK_SIZE * CHUNK_SIZE];
+
+    for (int cx = 0; cx < widthChunks; cx++) {
+        for (int y = 0; y < CHUNK_SIZE; y++) {
+            memcpy(&record[y * CHUNK_SIZE], band + (size_t)y * bandStride + (size_t)cx * CHUNK_SIZE, CHUNK_SIZE);
+        }
+        if (fwrite(record, sizeof(record), 1, out) != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * compileASCIIMap
+ *
+ * Converts an ASCII map of any size into the compiled chunk format. The
+ * input is streamed twice, once to measure it and once to convert it, and
+ * only one band of CHUNK_SIZE rows is held in memory. Ragged lines are
+ * padded with grass.
+ *
+ * @param[in] asciiPath ASCII map to read
+ * @param[in] outputPath Compiled map to write
+ * @return bool True on success
+ */
+bool compileASCIIMap(const char* asciiPath, const char* outputPath) {
+    FILE* in = fopen(asciiPath, "rb");
+    if (!in) {
+        printf("Failed to open map: %s\n", asciiPath);
+        return false;
+    }
+
+    // Pass 1: measure
+    char probe[2];
+    long width = 0;
+    long height = 0;
+    long length;
+    while ((length = readMapLine(in, probe, sizeof(probe))) >= 0) {
+        if (length > width) width = length;
+        height++;
+    }
+    if (width == 0 || height == 0) {
+        printf("Map is empty: %s\n", asciiPath);
+        fclose(in);
+        return false;
+    }
+
+    CompiledMapHeader header;
+    memcpy(header.magic, COMPILED_MAP_MAGIC, sizeof(header.magic));
+    header.version = COMPILED_MAP_VERSION;
+    header.chunkSize = CHUNK_SIZE;
+    header.widthChunks = (uint32_t)((width + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    header.heightChunks = (uint32_t)((height + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+    size_t bandStride = (size_t)header.widthChunks * CHUNK_SIZE;
+    char* line = (char*)malloc((size_t)width + 1);
+    uint8_t* band = (uint8_t*)malloc(bandStride * CHUNK_SIZE);
+    FILE* out = fopen(outputPath, "wb");
+    if (!line || !band || !out) {
+        printf("Failed to set up map compilation to %s\n", outputPath);
+        free(line);
+        free(band);
+        if (out) fclose(out);
+        fclose(in);
+        return false;
+    }
+
+    // Pass 2: convert one band at a time
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1;
+    rewind(in);
+    for (uint32_t cy = 0; ok && cy < header.heightChunks; cy++) {
+        memset(band, TERRAIN_GRASS, bandStride * CHUNK_SIZE);
+        for (int y = 0; y < CHUNK_SIZE; y++) {
+            length = readMapLine(in, line, width + 1);
+            if (length < 0) break;
+            parseTerrainRow(line, band + (size_t)y * bandStride, (int)length);
+        }
+        ok = writeChunkBand(out, band, (int)header.widthChunks, (int)bandStride);
+    }
+
+    free(line);
+    free(band);
+    fclose(in);
+    if (fclose(out) != 0) ok = false;
+
+    if (!ok) {
+        printf("Failed to write compiled map: %s\n", outputPath);
+        return false;
+    }
+    printf("Compiled %s (%ld x %ld tiles) to %s (%u x %u chunks)\n",
+           asciiPath, width, height, outputPath, header.widthChunks, header.heightChunks);
+    return true;
+}
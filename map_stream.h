@@ -0,0 +1,63 @@
+#ifndef MAP_STREAM_H
+#define MAP_STREAM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "grid.h"
+
+// Map sources feed chunk streaming. loadChunksAroundPlayer asks the active
+// source for every chunk it has no saved data for, so a new game only
+// reads the chunks inside the load radius. Two formats are understood:
+//
+//  - ASCII maps (testmap.txt style), one character per tile. Lines may be
+//    any length; the file is read one band of CHUNK_SIZE lines at a time,
+//    and only as far down as the requested chunks.
+//  - Compiled maps, produced offline by compileASCIIMap (the mapc tool): a
+//    header followed by one fixed-size terrain record per chunk in
+//    row-major order, so fetching a chunk is one seek and one read.
+//
+// openMapSource tells them apart by the compiled map magic.
+
+#define COMPILED_MAP_MAGIC "CMAP"
+#define COMPILED_MAP_VERSION 1
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t chunkSize;
+    uint32_t widthChunks;
+    uint32_t heightChunks;
+} CompiledMapHeader;
+
+typedef enum {
+    MAP_SOURCE_ASCII,
+    MAP_SOURCE_COMPILED
+} MapSourceFormat;
+
+typedef struct {
+    MapSourceFormat format;
+    FILE* file;
+
+    // Compiled maps: size of the chunk table
+    int widthChunks;
+    int heightChunks;
+
+    // ASCII maps: the rows read so far, clipped to the world width
+    uint8_t terrain[GRID_SIZE][GRID_SIZE];
+    int rowLength[GRID_SIZE];
+    int rowsRead;
+    bool endOfFile;
+} MapSource;
+
+extern MapSource* activeMapSource;
+
+MapSource* openMapSource(const char* path);
+void closeMapSource(MapSource* source);
+bool mapSourceReadChunk(MapSource* source, int chunkX, int chunkY, Chunk* chunk);
+
+void parseTerrainRow(const char* text, uint8_t* terrain, int count);
+void buildChunkFromTerrain(const uint8_t* terrain, int stride, Chunk* chunk);
+bool compileASCIIMap(const char* asciiPath, const char* outputPath);
+
+#endif // MAP_STREAM_H
@@ -0,0 +1,18 @@
+// mapc.c
+//
+// Map compiler: converts an ASCII map into the chunked binary format that
+// map_stream reads with one seek per chunk. Input files may be far larger
+// than memory allows to load whole; they are streamed a band at a time.
+//
+// usage: mapc input.txt output.cmap
+
+#include <stdio.h>
+#include "map_stream.h"
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s input.txt output.cmap\n", argv[0]);
+        return 1;
+    }
+    return compileASCIIMap(argv[1], argv[2]) ? 0 : 1;
+}
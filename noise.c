@@ -0,0 +1,482 @@
+// noise.c
+
+#include "noise.h"
+#include <math.h>
+
+#if NOISE_SIMD_WIDTH > 1
+#include <immintrin.h>
+#endif
+
+#define HASH_PRIME_X 0x27D4EB2Du
+#define HASH_PRIME_Y 0x165667B1u
+#define HASH_MIX_1   0x85EBCA6Bu
+#define HASH_MIX_2   0xC2B2AE35u
+#define UNIT_SCALE   (1.0f / 8388608.0f)  // 2^-23
+
+static inline uint32_t finalizeHash(uint32_t h) {
+    h ^= h >> 15;
+    h *= HASH_MIX_1;
+    h ^= h >> 13;
+    h *= HASH_MIX_2;
+    h ^= h >> 16;
+    return h;
+}
+
+static inline float hashToUnit(uint32_t h) {
+    return (float)(int32_t)(h >> 8) * UNIT_SCALE - 1.0f;
+}
+
+static inline float fade(float t) {
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+static inline float lerpf(float a, float b, float t) {
+    return a + t * (b - a);
+}
+
+static inline float grad(uint32_t h, float dx, float dy) {
+    return ((h & 1) ? -dx : dx) + ((h & 2) ? -dy : dy);
+}
+
+/*
+ * noiseHash2D
+ *
+ * Hashes an integer lattice point. Replaces the old rand()-salted hash in
+ * grid.c, so the same (seed, x, y) always yields the same value.
+ *
+ * @param[in] seed World / layer seed
+ * @param[in] x Lattice x-coordinate
+ * @param[in] y Lattice y-coordinate
+ * @return uint32_t Well-mixed 32-bit hash
+ */
+uint32_t noiseHash2D(uint32_t seed, int32_t x, int32_t y) {
+    return finalizeHash(seed ^ ((uint32_t)x * HASH_PRIME_X) ^ ((uint32_t)y * HASH_PRIME_Y));
+}
+
+/*
+ * noiseLattice
+ *
+ * Returns the raw lattice value at an integer point.
+ *
+ * @return float Value in [-1, 1)
+ */
+float noiseLattice(uint32_t seed, int32_t x, int32_t y) {
+    return hashToUnit(noiseHash2D(seed, x, y));
+}
+
+/*
+ * noiseValue2D
+ *
+ * Value noise: lattice values blended with a quintic fade curve.
+ *
+ * @param[in] seed Noise seed
+ * @param[in] x Sample x-coordinate in lattice units
+ * @param[in] y Sample y-coordinate in lattice units
+ * @return float Value in [-1, 1]
+ */
+float noiseValue2D(uint32_t seed, float x, float y) {
+    float fx = floorf(x);
+    float fy = floorf(y);
+    int32_t ix = (int32_t)fx;
+    int32_t iy = (int32_t)fy;
+    float sx = fade(x - fx);
+    float sy = fade(y - fy);
+
+    uint32_t hy0 = (uint32_t)iy * HASH_PRIME_Y;
+    uint32_t hy1 = hy0 + HASH_PRIME_Y;
+    uint32_t hx0 = seed ^ ((uint32_t)ix * HASH_PRIME_X);
+    uint32_t hx1 = seed ^ ((uint32_t)ix * HASH_PRIME_X + HASH_PRIME_X);
+
+    float v00 = hashToUnit(finalizeHash(hx0 ^ hy0));
+    float v10 = hashToUnit(finalizeHash(hx1 ^ hy0));
+    float v01 = hashToUnit(finalizeHash(hx0 ^ hy1));
+    float v11 = hashToUnit(finalizeHash(hx1 ^ hy1));
+
+    float a = lerpf(v00, v10, sx);
+    float b = lerpf(v01, v11, sx);
+    return lerpf(a, b, sy);
+}
+
+/*
+ * noiseGradient2D
+ *
+ * Perlin-style gradient noise using four diagonal gradients per lattice point.
+ *
+ * @param[in] seed Noise seed
+ * @param[in] x Sample x-coordinate in lattice units
+ * @param[in] y Sample y-coordinate in lattice units
+ * @return float Value in roughly [-1, 1]
+ */
+float noiseGradient2D(uint32_t seed, float x, float y) {
+    float fx = floorf(x);
+    float fy = floorf(y);
+    int32_t ix = (int32_t)fx;
+    int32_t iy = (int32_t)fy;
+    float tx = x - fx;
+    float ty = y - fy;
+    float sx = fade(tx);
+    float sy = fade(ty);
+
+    uint32_t hy0 = (uint32_t)iy * HASH_PRIME_Y;
+    uint32_t hy1 = hy0 + HASH_PRIME_Y;
+    uint32_t hx0 = seed ^ ((uint32_t)ix * HASH_PRIME_X);
+    uint32_t hx1 = seed ^ ((uint32_t)ix * HASH_PRIME_X + HASH_PRIME_X);
+
+    float g00 = grad(finalizeHash(hx0 ^ hy0), tx, ty);
+    float g10 = grad(finalizeHash(hx1 ^ hy0), tx - 1.0f, ty);
+    float g01 = grad(finalizeHash(hx0 ^ hy1), tx, ty - 1.0f);
+    float g11 = grad(finalizeHash(hx1 ^ hy1), tx - 1.0f, ty - 1.0f);
+
+    float a = lerpf(g00, g10, sx);
+    float b = lerpf(g01, g11, sx);
+    return lerpf(a, b, sy);
+}
+
+/*
+ * noiseFbm2D
+ *
+ * Fractal sum of gradient noise octaves, normalized like the old perlinNoise.
+ *
+ * @param[in] seed Noise seed; each octave uses its own sub-seed
+ * @param[in] x Sample x-coordinate
+ * @param[in] y Sample y-coordinate
+ * @param[in] persistence Amplitude falloff per octave
+ * @param[in] octaves Number of octaves (>= 1)
+ * @return float Value in roughly [-1, 1]
+ */
+float noiseFbm2D(uint32_t seed, float x, float y, float persistence, int octaves) {
+    float total = 0.0f;
+    float frequency = 1.0f;
+    float amplitude = 1.0f;
+    float maxValue = 0.0f;
+
+    for (int i = 0; i < octaves; i++) {
+        total += noiseGradient2D(NOISE_SUBSEED(seed, i), x * frequency, y * frequency) * amplitude;
+        maxValue += amplitude;
+        amplitude *= persistence;
+        frequency *= 2.0f;
+    }
+
+    return maxValue > 0.0f ? total / maxValue : 0.0f;
+}
+
+// Row kernels
+//
+// Sample i is taken at ((x0 + i * step) * freq, yScaled). Everything that only
+// depends on y (lattice row, fade weight, row hashes) is computed once per
+// call. With accumulate set, out[i] += noise * amplitude; otherwise
+// out[i] = noise.
+
+typedef struct {
+    uint32_t seed;
+    float x0, step, freq;
+    float ty, sy;
+    uint32_t hy0, hy1;
+    float amplitude;
+    int accumulate;
+} RowSetup;
+
+static RowSetup makeRowSetup(uint32_t seed, float x0, float step, float freq,
+                             float yScaled, float amplitude, int accumulate) {
+    RowSetup r;
+    float fy = floorf(yScaled);
+    r.seed = seed;
+    r.x0 = x0;
+    r.step = step;
+    r.freq = freq;
+    r.ty = yScaled - fy;
+    r.sy = fade(r.ty);
+    r.hy0 = (uint32_t)(int32_t)fy * HASH_PRIME_Y;
+    r.hy1 = r.hy0 + HASH_PRIME_Y;
+    r.amplitude = amplitude;
+    r.accumulate = accumulate;
+    return r;
+}
+
+static inline void storeSample(const RowSetup* r, float* out, int i, float n) {
+    if (r->accumulate) {
+        out[i] += n * r->amplitude;
+    } else {
+        out[i] = n;
+    }
+}
+
+static void valueRowScalar(const RowSetup* r, int start, int count, float* out) {
+    for (int i = start; i < count; i++) {
+        float x = (r->x0 + (float)i * r->step) * r->freq;
+        float fx = floorf(x);
+        int32_t ix = (int32_t)fx;
+        float sx = fade(x - fx);
+        uint32_t hx0 = r->seed ^ ((uint32_t)ix * HASH_PRIME_X);
+        uint32_t hx1 = r->seed ^ ((uint32_t)ix * HASH_PRIME_X + HASH_PRIME_X);
+
+        float a = lerpf(hashToUnit(finalizeHash(hx0 ^ r->hy0)),
+                        hashToUnit(finalizeHash(hx1 ^ r->hy0)), sx);
+        float b = lerpf(hashToUnit(finalizeHash(hx0 ^ r->hy1)),
+                        hashToUnit(finalizeHash(hx1 ^ r->hy1)), sx);
+        storeSample(r, out, i, lerpf(a, b, r->sy));
+    }
+}
+
+static void gradientRowScalar(const RowSetup* r, int start, int count, float* out) {
+    for (int i = start; i < count; i++) {
+        float x = (r->x0 + (float)i * r->step) * r->freq;
+        float fx = floorf(x);
+        int32_t ix = (int32_t)fx;
+        float tx = x - fx;
+        float sx = fade(tx);
+        uint32_t hx0 = r->seed ^ ((uint32_t)ix * HASH_PRIME_X);
+        uint32_t hx1 = r->seed ^ ((uint32_t)ix * HASH_PRIME_X + HASH_PRIME_X);
+
+        float a = lerpf(grad(finalizeHash(hx0 ^ r->hy0), tx, r->ty),
+                        grad(finalizeHash(hx1 ^ r->hy0), tx - 1.0f, r->ty), sx);
+        float b = lerpf(grad(finalizeHash(hx0 ^ r->hy1), tx, r->ty - 1.0f),
+                        grad(finalizeHash(hx1 ^ r->hy1), tx - 1.0f, r->ty - 1.0f), sx);
+        storeSample(r, out, i, lerpf(a, b, r->sy));
+    }
+}
+
+#if NOISE_SIMD_WIDTH == 8
+
+#define VF __m256
+#define VI __m256i
+#define VF_SET1 _mm256_set1_ps
+#define VI_SET1 _mm256_set1_epi32
+#define VF_ADD _mm256_add_ps
+#define VF_SUB _mm256_sub_ps
+#define VF_MUL _mm256_mul_ps
+#define VF_FLOOR _mm256_floor_ps
+#define VF_XOR _mm256_xor_ps
+#define VF_LOAD _mm256_loadu_ps
+#define VF_STORE _mm256_storeu_ps
+#define VI_ADD _mm256_add_epi32
+#define VI_MUL _mm256_mullo_epi32
+#define VI_XOR _mm256_xor_si256
+#define VI_SRL _mm256_srli_epi32
+#define VI_SLL _mm256_slli_epi32
+#define VI_TO_F _mm256_cvtepi32_ps
+#define VF_TO_I _mm256_cvttps_epi32
+#define VI_AS_F _mm256_castsi256_ps
+#define LANE_OFFSETS _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)
+
+#elif NOISE_SIMD_WIDTH == 4
+
+#define VF __m128
+#define VI __m128i
+#define VF_SET1 _mm_set1_ps
+#define VI_SET1 _mm_set1_epi32
+#define VF_ADD _mm_add_ps
+#define VF_SUB _mm_sub_ps
+#define VF_MUL _mm_mul_ps
+#define VF_FLOOR _mm_floor_ps
+#define VF_XOR _mm_xor_ps
+#define VF_LOAD _mm_loadu_ps
+#define VF_STORE _mm_storeu_ps
+#define VI_ADD _mm_add_epi32
+#define VI_MUL _mm_mullo_epi32
+#define VI_XOR _mm_xor_si128
+#define VI_SRL _mm_srli_epi32
+#define VI_SLL _mm_slli_epi32
+#define VI_TO_F _mm_cvtepi32_ps
+#define VF_TO_I _mm_cvttps_epi32
+#define VI_AS_F _mm_castsi128_ps
+#define LANE_OFFSETS _mm_setr_epi32(0, 1, 2, 3)
+
+#endif
+
+#if NOISE_SIMD_WIDTH > 1
+
+static inline VI finalizeHashV(VI h) {
+    h = VI_XOR(h, VI_SRL(h, 15));
+    h = VI_MUL(h, VI_SET1((int)HASH_MIX_1));
+    h = VI_XOR(h, VI_SRL(h, 13));
+    h = VI_MUL(h, VI_SET1((int)HASH_MIX_2));
+    h = VI_XOR(h, VI_SRL(h, 16));
+    return h;
+}
+
+static inline VF hashToUnitV(VI h) {
+    return VF_SUB(VF_MUL(VI_TO_F(VI_SRL(h, 8)), VF_SET1(UNIT_SCALE)), VF_SET1(1.0f));
+}
+
+static inline VF fadeV(VF t) {
+    VF inner = VF_ADD(VF_MUL(t, VF_SUB(VF_MUL(t, VF_SET1(6.0f)), VF_SET1(15.0f))), VF_SET1(10.0f));
+    return VF_MUL(VF_MUL(VF_MUL(t, t), t), inner);
+}
+
+static inline VF lerpV(VF a, VF b, VF t) {
+    return VF_ADD(a, VF_MUL(t, VF_SUB(b, a)));
+}
+
+// Flips the sign of dx / dy according to hash bits 0 / 1
+static inline VF gradV(VI h, VF dx, VF dy) {
+    VF signX = VI_AS_F(VI_SLL(h, 31));
+    VF signY = VI_AS_F(VI_SLL(VI_SRL(h, 1), 31));
+    return VF_ADD(VF_XOR(dx, signX), VF_XOR(dy, signY));
+}
+
+// Computes the sample positions and per-lane x hashes for lanes [i, i + W)
+static inline void rowLanes(const RowSetup* r, int i, VF* tx, VI* hx0, VI* hx1) {
+    VF idx = VI_TO_F(VI_ADD(VI_SET1(i), LANE_OFFSETS));
+    VF x = VF_MUL(VF_ADD(VF_SET1(r->x0), VF_MUL(idx, VF_SET1(r->step))), VF_SET1(r->freq));
+    VF fx = VF_FLOOR(x);
+    VI hx = VI_MUL(VF_TO_I(fx), VI_SET1((int)HASH_PRIME_X));
+    VI seed = VI_SET1((int)r->seed);
+    *tx = VF_SUB(x, fx);
+    *hx0 = VI_XOR(seed, hx);
+    *hx1 = VI_XOR(seed, VI_ADD(hx, VI_SET1((int)HASH_PRIME_X)));
+}
+
+static inline void storeSampleV(const RowSetup* r, float* out, int i, VF n) {
+    if (r->accumulate) {
+        VF_STORE(out + i, VF_ADD(VF_LOAD(out + i), VF_MUL(n, VF_SET1(r->amplitude))));
+    } else {
+        VF_STORE(out + i, n);
+    }
+}
+
+static int valueRowSimd(const RowSetup* r, int count, float* out) {
+    VI hy0 = VI_SET1((int)r->hy0);
+    VI hy1 = VI_SET1((int)r->hy1);
+    VF sy = VF_SET1(r->sy);
+    int i = 0;
+
+    for (; i + NOISE_SIMD_WIDTH <= count; i += NOISE_SIMD_WIDTH) {
+        VF tx;
+        VI hx0, hx1;
+        rowLanes(r, i, &tx, &hx0, &hx1);
+        VF sx = fadeV(tx);
+
+        VF a = lerpV(hashToUnitV(finalizeHashV(VI_XOR(hx0, hy0))),
+                     hashToUnitV(finalizeHashV(VI_XOR(hx1, hy0))), sx);
+        VF b = lerpV(hashToUnitV(finalizeHashV(VI_XOR(hx0, hy1))),
+                     hashToUnitV(finalizeHashV(VI_XOR(hx1, hy1))), sx);
+        storeSampleV(r, out, i, lerpV(a, b, sy));
+    }
+    return i;
+}
+
+static int gradientRowSimd(const RowSetup* r, int count, float* out) {
+    VI hy0 = VI_SET1((int)r->hy0);
+    VI hy1 = VI_SET1((int)r->hy1);
+    VF ty0 = VF_SET1(r->ty);
+    VF ty1 = VF_SET1(r->ty - 1.0f);
+    VF one = VF_SET1(1.0f);
+    VF sy = VF_SET1(r->sy);
+    int i = 0;
+
+    for (; i + NOISE_SIMD_WIDTH <= count; i += NOISE_SIMD_WIDTH) {
+        VF tx;
+        VI hx0, hx1;
+        rowLanes(r, i, &tx, &hx0, &hx1);
+        VF tx1 = VF_SUB(tx, one);
+        VF sx = fadeV(tx);
+
+        VF a = lerpV(gradV(finalizeHashV(VI_XOR(hx0, hy0)), tx, ty0),
+                     gradV(finalizeHashV(VI_XOR(hx1, hy0)), tx1, ty0), sx);
+        VF b = lerpV(gradV(finalizeHashV(VI_XOR(hx0, hy1)), tx, ty1),
+                     gradV(finalizeHashV(VI_XOR(hx1, hy1)), tx1, ty1), sx);
+        storeSampleV(r, out, i, lerpV(a, b, sy));
+    }
+    return i;
+}
+
+#endif // NOISE_SIMD_WIDTH > 1
+
+static void valueRow(const RowSetup* r, int count, float* out) {
+    int done = 0;
+#if NOISE_SIMD_WIDTH > 1
+    done = valueRowSimd(r, count, out);
+#endif
+    valueRowScalar(r, done, count, out);
+}
+
+static void gradientRow(const RowSetup* r, int count, float* out) {
+    int done = 0;
+#if NOISE_SIMD_WIDTH > 1
+    done = gradientRowSimd(r, count, out);
+#endif
+    gradientRowScalar(r, done, count, out);
+}
+
+/*
+ * noiseValueRow
+ *
+ * Evaluates noiseValue2D(seed, x0 + i * step, y) for a run of samples.
+ *
+ * @param[in] seed Noise seed
+ * @param[in] x0 X-coordinate of the first sample
+ * @param[in] y Shared y-coordinate of the row
+ * @param[in] step Distance between samples
+ * @param[in] count Number of samples
+ * @param[out] out Receives count values
+ */
+void noiseValueRow(uint32_t seed, float x0, float y, float step, int count, float* out) {
+    if (count <= 0 || !out) return;
+    RowSetup r = makeRowSetup(seed, x0, step, 1.0f, y, 1.0f, 0);
+    valueRow(&r, count, out);
+}
+
+/*
+ * noiseGradientRow
+ *
+ * Evaluates noiseGradient2D(seed, x0 + i * step, y) for a run of samples.
+ */
+void noiseGradientRow(uint32_t seed, float x0, float y, float step, int count, float* out) {
+    if (count <= 0 || !out) return;
+    RowSetup r = makeRowSetup(seed, x0, step, 1.0f, y, 1.0f, 0);
+    gradientRow(&r, count, out);
+}
+
+/*
+ * noiseFbmRow
+ *
+ * Evaluates noiseFbm2D for a run of samples, accumulating one octave row at a
+ * time so each octave's lattice row setup is shared by the whole run.
+ *
+ * @param[in] seed Noise seed
+ * @param[in] x0 X-coordinate of the first sample
+ * @param[in] y Shared y-coordinate of the row
+ * @param[in] step Distance between samples
+ * @param[in] count Number of samples
+ * @param[in] persistence Amplitude falloff per octave
+ * @param[in] octaves Number of octaves
+ * @param[out] out Receives count values
+ */
+void noiseFbmRow(uint32_t seed, float x0, float y, float step, int count,
+                 float persistence, int octaves, float* out) {
+    if (count <= 0 || !out) return;
+
+    for (int i = 0; i < count; i++) {
+        out[i] = 0.0f;
+    }
+
+    float frequency = 1.0f;
+    float amplitude = 1.0f;
+    float maxValue = 0.0f;
+
+    for (int o = 0; o < octaves; o++) {
+        RowSetup r = makeRowSetup(NOISE_SUBSEED(seed, o), x0, step, frequency,
+                                  y * frequency, amplitude, 1);
+        gradientRow(&r, count, out);
+        maxValue += amplitude;
+        amplitude *= persistence;
+        frequency *= 2.0f;
+    }
+
+    if (maxValue > 0.0f) {
+        for (int i = 0; i < count; i++) {
+            out[i] /= maxValue;
+        }
+    }
+}
+
+const char* noiseSimdName(void) {
+#if NOISE_SIMD_WIDTH == 8
+    return "AVX2";
+#elif NOISE_SIMD_WIDTH == 4
+    return "SSE4.1";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,39 @@
+#ifndef NOISE_H
+#define NOISE_H
+
+#include <stdint.h>
+
+// Seeded, stateless 2D noise. Every function is a pure function of
+// (seed, coordinates), so results are reproducible and safe to call from
+// any thread. The *Row kernels evaluate a horizontal run of samples at once
+// and use AVX2 / SSE4.1 when the translation unit is built with them; the
+// scalar and vector paths produce bit-identical results.
+
+#if defined(__AVX2__)
+#define NOISE_SIMD_WIDTH 8
+#elif defined(__SSE4_1__)
+#define NOISE_SIMD_WIDTH 4
+#else
+#define NOISE_SIMD_WIDTH 1
+#endif
+
+// Derives an independent seed for octave / layer `index` of `seed`
+#define NOISE_SUBSEED(seed, index) ((uint32_t)(seed) + (uint32_t)(index) * 0x9E3779B9u)
+
+uint32_t noiseHash2D(uint32_t seed, int32_t x, int32_t y);
+float noiseLattice(uint32_t seed, int32_t x, int32_t y);
+
+// Single-sample evaluation (reference path)
+float noiseValue2D(uint32_t seed, float x, float y);
+float noiseGradient2D(uint32_t seed, float x, float y);
+float noiseFbm2D(uint32_t seed, float x, float y, float persistence, int octaves);
+
+// Row kernels: out[i] = f(x0 + i * step, y) for i in [0, count)
+void noiseValueRow(uint32_t seed, float x0, float y, float step, int count, float* out);
+void noiseGradientRow(uint32_t seed, float x0, float y, float step, int count, float* out);
+void noiseFbmRow(uint32_t seed, float x0, float y, float step, int count,
+                 float persistence, int octaves, float* out);
+
+const char* noiseSimdName(void);
+
+#endif // NOISE_H
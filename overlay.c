@@ -7,6 +7,7 @@
 #include <GL/glew.h>
 #include "rendering.h"
 #include <stdio.h>
+#include "grid_summary.h"
 GLuint crateUIShaderProgram = 0;  // Shader program for crate UI
 GLint crateUIProjLoc = 0;     
 CrateUIRenderer gCrateUIRenderer = {0};
@@ -208,6 +209,7 @@ void RenderCrateUI(CrateInventory* crate, float screenX, float screenY) {
    glUseProgram(0);
 }
 void RenderCrateUIs(float cameraOffsetX, float cameraOffsetY, float zoomFactor) {
+    if (openCrateTotal() == 0) return;  // Nothing open anywhere
     printf("Starting RenderCrateUIs, storage count: %zu\n", globalStorageManager.count);
     for (size_t i = 0; i < globalStorageManager.count; i++) {
         CrateInventory* crate = &globalStorageManager.crates[i];
@@ -3,6 +3,7 @@
 #include "pathfinding.h"
 #include "entity.h"
 #include "grid.h"
+#include "grid_planes.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -169,6 +170,10 @@ float heuristic(int x1, int y1, int x2, int y2) {
  * @return bool True if there is a clear line of sight, false otherwise
  */
 bool lineOfSight(int x0, int y0, int x1, int y1) {
+    // With both ends on the grid every probe below, including the diagonal
+    // corner checks, lands on the grid or its zero border
+    if (!isValid(x0, y0) || !isValid(x1, y1)) return false;
+
     int dx = abs(x1 - x0);
     int dy = abs(y1 - y0);
     int x = x0;
@@ -181,7 +186,7 @@ bool lineOfSight(int x0, int y0, int x1, int y1) {
     dy *= 2;
 
     for (; n > 0; --n) {
-        if (!isWalkable(x, y)) return false;
+        if (!planeTest(walkablePlane, x, y)) return false;
         
         if (error > 0) {
             x += x_inc;
@@ -190,7 +195,7 @@ bool lineOfSight(int x0, int y0, int x1, int y1) {
             y += y_inc;
             error += dx;
         } else {
-            if (!isWalkable(x + x_inc, y) || !isWalkable(x, y + y_inc)) return false;
+            if (!planeTest(walkablePlane, x + x_inc, y) || !planeTest(walkablePlane, x, y + y_inc)) return false;
             x += x_inc;
             y += y_inc;
             error += dx - dy;
@@ -274,7 +279,8 @@ Node* findPath(int startX, int startY, int goalX, int goalY, int* pathLength) {
             int newX = current.x + dx[i];
             int newY = current.y + dy[i];
 
-            if (!isValid(newX, newY) || !isWalkable(newX, newY) || closedList[newY][newX]) {
+            // Border bits are never walkable, so this also rejects off-grid neighbours
+            if (!planeTest(walkablePlane, newX, newY) || closedList[newY][newX]) {
                 continue;
             }
 
@@ -6,6 +6,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "structures.h"
+#include "grid_edit.h"
+#include "world_commands.h"
+#include "grid_planes.h"
+#include "spatial_hash.h"
+#include "world_timers.h"
 /*
  * InitPlayer
  *
@@ -14,21 +19,19 @@
  * @param[out] player Pointer to the Player structure to initialize
  * @param[in] startGridX Starting X position on the grid
  * @param[in] startGridY Starting Y position on the grid
- * @param[in] speed Movement speed of the player
+ * @param[in] speed Movement speed of the player in tiles per physics tick
  *
  * @pre player is a valid pointer to a Player structure
  * @pre startGridX and startGridY are within valid grid bounds
  * @pre speed is a positive float value
  */
 void InitPlayer(Player* player, int startGridX, int startGridY, float speed) {
+    player->entity.id = PLAYER_ENTITY_ID;
     atomic_store(&player->entity.gridX, startGridX);
     atomic_store(&player->entity.gridY, startGridY);
-    player->entity.speed = speed;
-    
-    float tempPosX, tempPosY;
-    WorldToScreenCoords(atomic_load(&player->entity.gridX), atomic_load(&player->entity.gridY), 0, 0, 1, &tempPosX, &tempPosY);
-    atomic_store(&player->entity.posX, tempPosX);
-    atomic_store(&player->entity.posY, tempPosY);
+    entityStore.speed[player->entity.id] = worldFromTiles(speed);
+    atomic_store(&entityStore.posX[player->entity.id], worldFromTile(startGridX));
+    atomic_store(&entityStore.posY[player->entity.id], worldFromTile(startGridY));
 
     for (int i = 0; i < SKILL_COUNT; i++) {
         player->skills.levels[i] = 0;
@@ -36,15 +39,20 @@ void InitPlayer(Player* player, int startGridX, int startGridY, float speed) {
     }
     
     player->skills.lastUpdatedSkill = SKILL_CONSTRUCTION; 
-    atomic_store(&player->entity.targetGridX, startGridX);
-    atomic_store(&player->entity.targetGridY, startGridY);
+    atomic_store(&entityStore.targetGridX[player->entity.id], startGridX);
+    atomic_store(&entityStore.targetGridY[player->entity.id], startGridY);
     atomic_store(&player->entity.finalGoalX, startGridX);
     atomic_store(&player->entity.finalGoalY, startGridY);
     atomic_store(&player->entity.needsPathfinding, false);
     player->entity.cachedPath = NULL;
     player->entity.cachedPathLength = 0;
     player->entity.currentPathIndex = 0;
+    atomic_store(&player->entity.pathBounds, PATH_BOUNDS_NONE);
+    atomic_store(&player->entity.pathInvalidated, false);
     player->zoomFactor = 3.0f;
+    player->entity.reservedX = -1;
+    player->entity.reservedY = -1;
+    player->entity.waitTicks = 0;
     player->entity.isPlayer = true;
 
     // Initialize build-related fields
@@ -58,10 +66,6 @@ void InitPlayer(Player* player, int startGridX, int startGridY, float speed) {
     player->hasHarvestTarget = false;
     player->pendingHarvestType = 0;
 
-    atomic_store(&player->cameraTargetX, atomic_load(&player->entity.posX));
-    atomic_store(&player->cameraTargetY, atomic_load(&player->entity.posY));
-    atomic_store(&player->cameraCurrentX, atomic_load(&player->entity.posX));
-    atomic_store(&player->cameraCurrentY, atomic_load(&player->entity.posY));
     player->cameraSpeed = 0.1f;
 
     // Initialize inventory
@@ -72,26 +76,20 @@ void InitPlayer(Player* player, int startGridX, int startGridY, float speed) {
     }
 
     int tempNearestX, tempNearestY;
-    findNearestWalkableTile(atomic_load(&player->entity.posX), atomic_load(&player->entity.posY), &tempNearestX, &tempNearestY);
+    findNearestWalkableTile(startGridX, startGridY, &tempNearestX, &tempNearestY);
     atomic_store(&player->entity.gridX, tempNearestX);
     atomic_store(&player->entity.gridY, tempNearestY);
-
-    WorldToScreenCoords(atomic_load(&player->entity.gridX), atomic_load(&player->entity.gridY), 0, 0, 1, &tempPosX, &tempPosY);
-    atomic_store(&player->entity.posX, tempPosX);
-    atomic_store(&player->entity.posY, tempPosY);
-
-    atomic_store(&player->cameraTargetX, atomic_load(&player->entity.posX));
-    atomic_store(&player->cameraTargetY, atomic_load(&player->entity.posY));
-    atomic_store(&player->cameraCurrentX, atomic_load(&player->entity.posX));
-    atomic_store(&player->cameraCurrentY, atomic_load(&player->entity.posY));
-        player->animation = malloc(sizeof(PlayerAnimation));
-    if (!player->animation) {
-        fprintf(stderr, "Failed to allocate player animation\n");
-        return;
-    }
-    player->animation->currentFrame = 0;
-    player->animation->lastFrameUpdate = 0;
-    player->animation->isMoving = false;
+    occupancyEnter(tempNearestX, tempNearestY);
+    spatialHashPlace(player->entity.id, tempNearestX, tempNearestY);
+    atomic_store(&entityStore.posX[player->entity.id], worldFromTile(tempNearestX));
+    atomic_store(&entityStore.posY[player->entity.id], worldFromTile(tempNearestY));
+
+    player->cameraTargetX = player->cameraCurrentX = tempNearestX + 0.5f;
+    player->cameraTargetY = player->cameraCurrentY = tempNearestY + 0.5f;
+    entityStore.animFrame[player->entity.id] = 0;
+    entityStore.lastFrameUpdate[player->entity.id] = 0;
+    entityStore.isMoving[player->entity.id] = false;
+    entityStore.facing[player->entity.id] = DIRECTION_DOWN;
     
     printf("Player initialized at (%d, %d) with inventory\n", 
            atomic_load(&player->entity.gridX), 
@@ -101,7 +99,8 @@ void InitPlayer(Player* player, int startGridX, int startGridY, float speed) {
 /*
  * UpdatePlayer
  *
- * Updates the player's state, including position and camera.
+ * Moves the player one physics step and starts any build or harvest whose
+ * target came into range.
  *
  * @param[in,out] player Pointer to the Player structure to update
  * @param[in] allEntities Array of pointers to all entities in the game
@@ -116,125 +115,157 @@ void UpdatePlayer(Player* player, Entity** allEntities, int entityCount) {
         fprintf(stderr, "Error: NULL pointer passed to UpdatePlayer\n");
         return;
     }
+    (void)entityCount;
 
-    UpdateEntity(&player->entity, allEntities, entityCount);
+    // The path only changes when the goal or the world does
+    Entity* entity = &player->entity;
+    if (atomic_load(&entity->needsPathfinding)) {
+        updateEntityPath(entity);
+    }
+    moveEntities(&entity, 1);
 
     // Get current positions once
-    float playerPosX = atomic_load(&player->entity.posX);
-    float playerPosY = atomic_load(&player->entity.posY);
+    WorldCoord playerPosX = atomic_load(&entityStore.posX[player->entity.id]);
+    WorldCoord playerPosY = atomic_load(&entityStore.posY[player->entity.id]);
+
+    // Structure placement logic using continuous coordinates
+    if (player->hasBuildTarget) {
+        if (isWithinBuildRange(playerPosX, playerPosY, 
+                             player->targetBuildX, player->targetBuildY)) {
+            // Applied at the start of the next physics tick
+            queuePlaceStructure(player->pendingBuildType,
+                                player->targetBuildX,
+                                player->targetBuildY,
+                                player);
+            player->hasBuildTarget = false;
+        }
+    }
+
+    // Handle harvest target using the same coordinate system
+    if (player->hasHarvestTarget) {
+        if (isWithinBuildRange(playerPosX, playerPosY,
+                             player->targetHarvestX, player->targetHarvestY)) {
+            if (player->pendingHarvestType == MATERIAL_FERN) {
+                queueHarvest(player->targetHarvestX, player->targetHarvestY, player);
+            }
+            
+            player->hasHarvestTarget = false;
+            player->pendingHarvestType = 0;
+        }
+    }
+}
+/*
+ * animatePlayer
+ *
+ * Updates the player's facing and walk cycle from its movement.
+ *
+ * @param[in,out] player Pointer to the Player structure to update
+ * @param[in] currentTime SDL_GetTicks() of this update
+ */
+void animatePlayer(Player* player, Uint32 currentTime) {
+    WorldCoord playerPosX = atomic_load(&entityStore.posX[player->entity.id]);
+    WorldCoord playerPosY = atomic_load(&entityStore.posY[player->entity.id]);
 
     // Calculate distance to target tile center for animation
-    float targetWorldX, targetWorldY;
-    WorldToScreenCoords(
-        atomic_load(&player->entity.targetGridX), 
-        atomic_load(&player->entity.targetGridY), 
-        0, 0, 1, 
-        &targetWorldX, &targetWorldY
-    );
-
-    float dx = targetWorldX - playerPosX;
-    float dy = targetWorldY - playerPosY;
-    float distanceToTarget = sqrt(dx * dx + dy * dy);
-
-    #define POSITION_EPSILON 0.001f
-    player->animation->isMoving = distanceToTarget > POSITION_EPSILON;
+    float dx = worldToTiles(worldFromTile(atomic_load(&entityStore.targetGridX[player->entity.id])) - playerPosX);
+    float dy = worldToTiles(worldFromTile(atomic_load(&entityStore.targetGridY[player->entity.id])) - playerPosY);
+    float distanceToTarget = sqrtf(dx * dx + dy * dy);
+
+    #define POSITION_EPSILON 0.02f  // Tiles
+    entityStore.isMoving[player->entity.id] = distanceToTarget > POSITION_EPSILON;
     
-    if (player->animation->isMoving) {
-        // Animation logic remains unchanged
-        float angle = atan2f(dy, dx);
+    if (entityStore.isMoving[player->entity.id]) {
+        // Grid rows grow downwards, so flip y to get the on-screen angle
+        float angle = atan2f(-dy, dx);
         
         const float PI = 3.14159265358979323846f;
         if (distanceToTarget > POSITION_EPSILON * 2.0f) {
             if (angle < -3*PI/4 || angle > 3*PI/4) {
-                player->animation->facing = DIRECTION_LEFT;
+                entityStore.facing[player->entity.id] = DIRECTION_LEFT;
             } else if (angle < -PI/4) {
-                player->animation->facing = DIRECTION_DOWN;
+                entityStore.facing[player->entity.id] = DIRECTION_DOWN;
             } else if (angle < PI/4) {
-                player->animation->facing = DIRECTION_RIGHT;
+                entityStore.facing[player->entity.id] = DIRECTION_RIGHT;
             } else {
-                player->animation->facing = DIRECTION_UP;
+                entityStore.facing[player->entity.id] = DIRECTION_UP;
             }
         }
 
-        Uint32 currentTime = SDL_GetTicks();
-        if (currentTime - player->animation->lastFrameUpdate >= 70) {
-            player->animation->currentFrame = (player->animation->currentFrame + 1) % 4;
-            player->animation->lastFrameUpdate = currentTime;
+        if (currentTime - entityStore.lastFrameUpdate[player->entity.id] >= 70) {
+            entityStore.animFrame[player->entity.id] = (entityStore.animFrame[player->entity.id] + 1) % 4;
+            entityStore.lastFrameUpdate[player->entity.id] = currentTime;
         }
     } else {
-        player->animation->currentFrame = 0;
-    }
-
-    // Structure placement logic using continuous coordinates
-    if (player->hasBuildTarget) {
-        if (isWithinBuildRange(playerPosX, playerPosY, 
-                             player->targetBuildX, player->targetBuildY)) {
-bool placed = placeStructure(
-    player->pendingBuildType, 
-    player->targetBuildX, 
-    player->targetBuildY,
-    player
-);
-            
-            if (placed) {
-                printf("Structure placement succeeded at: %d, %d\n",
-                       player->targetBuildX, player->targetBuildY);
-            } else {
-                printf("Structure placement failed at: %d, %d\n",
-                       player->targetBuildX, player->targetBuildY);
-            }
-            player->hasBuildTarget = false;
-        }
+        entityStore.animFrame[player->entity.id] = 0;
     }
-
-    // Rest of the function (camera logic, etc.) remains unchanged
+}
+/*
+ * updateCamera
+ *
+ * Eases the camera towards the player, looking ahead in the direction it
+ * moves. The smoothing is per call, so call it at a fixed rate.
+ *
+ * @param[in,out] player Pointer to the Player structure owning the camera
+ */
+void updateCamera(Player* player) {
+    // Camera follows in world tiles; the renderer maps it to the screen
     float cameraSmoothFactor = 0.05f;
     float lookAheadFactor = 1.0f;
+    float playerTilesX = worldToTiles(atomic_load(&entityStore.posX[player->entity.id]));
+    float playerTilesY = worldToTiles(atomic_load(&entityStore.posY[player->entity.id]));
     
-    float cameraOffsetX = playerPosX - player->cameraCurrentX;
-    float cameraOffsetY = playerPosY - player->cameraCurrentY;
+    float cameraOffsetX = playerTilesX - player->cameraCurrentX;
+    float cameraOffsetY = playerTilesY - player->cameraCurrentY;
     
     player->lookAheadX = cameraOffsetX * lookAheadFactor;
     player->lookAheadY = cameraOffsetY * lookAheadFactor;
 
-    player->cameraTargetX = playerPosX + player->lookAheadX;
-    player->cameraTargetY = playerPosY + player->lookAheadY;
+    player->cameraTargetX = playerTilesX + player->lookAheadX;
+    player->cameraTargetY = playerTilesY + player->lookAheadY;
 
     player->cameraCurrentX += (player->cameraTargetX - player->cameraCurrentX) * cameraSmoothFactor;
     player->cameraCurrentY += (player->cameraTargetY - player->cameraCurrentY) * cameraSmoothFactor;
+}
+/*
+ * harvestPlant
+ *
+ * Harvests the fern at a tile into the player's inventory and clears the
+ * tile; the fern grows back after PLANT_REGROW_MS. The tile is re-checked
+ * here because the request may have been queued before someone else
+ * harvested it.
+ *
+ * @param[in,out] player The harvesting player
+ * @param[in] gridX Tile column
+ * @param[in] gridY Tile row
+ * @return bool True if the plant was harvested
+ */
+bool harvestPlant(Player* player, int gridX, int gridY) {
+    if (!isValid(gridX, gridY) ||
+        grid[gridY][gridX].structureType != STRUCTURE_PLANT ||
+        grid[gridY][gridX].materialType != MATERIAL_FERN) {
+        printf("Nothing to harvest at: %d, %d\n", gridX, gridY);
+        return false;
+    }
 
-    // Handle harvest target using the same coordinate system
-    if (player->hasHarvestTarget) {
-        if (isWithinBuildRange(playerPosX, playerPosY,
-                             player->targetHarvestX, player->targetHarvestY)) {
-            Item* harvestedItem = NULL;
-            switch(player->pendingHarvestType) {
-                case MATERIAL_FERN:
-                    harvestedItem = CreateItem(ITEM_FERN);
-                    break;
-            }
+    Item* harvestedItem = CreateItem(ITEM_FERN);
+    if (!harvestedItem) {
+        printf("Failed to create fern item\n");
+        return false;
+    }
 
-            if (harvestedItem) {
-                bool added = AddItem(player->inventory, harvestedItem);
-                if (added) {
-                    awardForagingExp(player, harvestedItem);
-                    
-                    grid[player->targetHarvestY][player->targetHarvestX].structureType = STRUCTURE_NONE;
-                    grid[player->targetHarvestY][player->targetHarvestX].materialType = MATERIAL_NONE;
-                    GRIDCELL_SET_WALKABLE(grid[player->targetHarvestY][player->targetHarvestX], true);
-                    printf("Successfully harvested at: %d, %d\n", 
-                           player->targetHarvestX, player->targetHarvestY);
-                } else {
-                    printf("Failed to add harvested item to inventory\n");
-                    DestroyItem(harvestedItem);
-                }
-            }
-            
-            player->hasHarvestTarget = false;
-            player->pendingHarvestType = 0;
-        }
+    if (!AddItem(player->inventory, harvestedItem)) {
+        printf("Failed to add harvested item to inventory\n");
+        DestroyItem(harvestedItem);
+        return false;
     }
+
+    awardForagingExp(player, harvestedItem);
+    gridClearStructure(gridX, gridY);
+    schedulePlantRegrowth(gridX, gridY, MATERIAL_FERN, PLANT_REGROW_MS);
+    printf("Successfully harvested at: %d, %d\n", gridX, gridY);
+    return true;
 }
+
 /*
  * CleanupPlayer
  *
@@ -249,15 +280,7 @@ void CleanupPlayer(Player* player) {
         fprintf(stderr, "Error: player pointer is NULL in CleanupPlayer\n");
         return;
     }
-    if (player->animation) {
-        free(player->animation);
-        player->animation = NULL;
-    }
-
-    if (player->entity.cachedPath) {
-        free(player->entity.cachedPath);
-        player->entity.cachedPath = NULL;
-    }
+    setEntityPath(&player->entity, NULL, 0);
 
     if (player->inventory) {
         DestroyInventory(player->inventory);
@@ -16,12 +16,6 @@ typedef enum {
     DIRECTION_RIGHT
 } PlayerDirection;
 
-typedef struct {
-    uint8_t currentFrame;    
-    Uint32 lastFrameUpdate;  
-    bool isMoving;     
-    PlayerDirection facing;     
-} PlayerAnimation;
 // Define available skills
 typedef enum {
     SKILL_CONSTRUCTION = 0,
@@ -38,7 +32,7 @@ typedef struct {
 
 typedef struct Player {
     Entity entity;
-    float cameraTargetX;
+    float cameraTargetX;      // Camera state is in world tiles
     float cameraTargetY;
     float cameraCurrentX;
     float cameraCurrentY;
@@ -56,7 +50,6 @@ typedef struct Player {
     StructureType pendingBuildType;
     Skills skills;
     Inventory* inventory;
-    PlayerAnimation* animation; 
 } Player;
 
 // Function declarations
@@ -64,8 +57,11 @@ void InitPlayerInventory(Player* player);
 void CleanupPlayerInventory(Player* player);
 void InitPlayer(Player* player, int startGridX, int startGridY, float speed);
 void UpdatePlayer(Player* player, Entity** allEntities, int entityCount);
+void animatePlayer(Player* player, Uint32 currentTime);
+void updateCamera(Player* player);
 void CleanupPlayer(Player* player);
 void awardForagingExp(Player* player, const Item* item);
+bool harvestPlant(Player* player, int gridX, int gridY);
 // Skill-related function declarations
 float getSkillExp(const Player* player, SkillType skill);
 uint32_t getSkillLevel(const Player* player, SkillType skill);
@@ -0,0 +1,194 @@
+// region_sat.c
+#include "region_sat.h"
+#include "grid_edit.h"
+#include "structure_types.h"
+#include <SDL2/SDL.h>
+
+#define SAT_SPAN (GRID_SIZE + 1)
+
+// sat[layer][y][x] counts matching cells in [0, x) x [0, y)
+static uint16_t sat[SAT_LAYER_COUNT][SAT_SPAN][SAT_SPAN];
+static uint32_t builtChunkVersion[NUM_CHUNKS][NUM_CHUNKS];
+static uint32_t builtGridVersion;
+static bool built;
+static SDL_SpinLock satLock;  // Guards everything above
+
+static uint32_t cellLayers(const GridCell* cell) {
+    uint32_t bits = 0;
+    bool walkable = GRIDCELL_IS_WALKABLE(*cell) != 0;
+
+    if (walkable) bits |= 1u << SAT_WALKABLE;
+    if (cell->structureType != STRUCTURE_NONE) {
+        bits |= 1u << SAT_STRUCTURE;
+        if (cell->structureType == STRUCTURE_PLANT && cell->materialType == MATERIAL_TREE) {
+            bits |= 1u << SAT_TREE;
+        }
+    } else if (walkable) {
+        bits |= 1u << SAT_CLEAR;
+    }
+    switch (cell->terrainType) {
+        case TERRAIN_WATER: bits |= 1u << SAT_WATER; break;
+        case TERRAIN_SAND:  bits |= 1u << SAT_SAND; break;
+        case TERRAIN_GRASS: bits |= 1u << SAT_GRASS; break;
+        case TERRAIN_STONE: bits |= 1u << SAT_STONE; break;
+        default: break;
+    }
+    return bits;
+}
+
+// Recomputes every entry covering cells at or right of minX and at or
+// below minY; entries above and to the left cannot have changed
+static void rebuildFrom(int minX, int minY) {
+    for (int y = minY; y < GRID_SIZE; y++) {
+        uint16_t rowSum[SAT_LAYER_COUNT];
+        for (int l = 0; l < SAT_LAYER_COUNT; l++) {
+            rowSum[l] = (uint16_t)(sat[l][y + 1][minX] - sat[l][y][minX]);
+        }
+        for (int x = minX; x < GRID_SIZE; x++) {
+            uint32_t bits = cellLayers(&grid[y][x]);
+            for (int l = 0; l < SAT_LAYER_COUNT; l++) {
+                rowSum[l] += (bits >> l) & 1;
+                sat[l][y + 1][x + 1] = (uint16_t)(sat[l][y][x + 1] + rowSum[l]);
+            }
+        }
+    }
+}
+
+// Caller holds satLock
+static void refreshTables(void) {
+    uint32_t version = gridVersion();
+    if (built && version == builtGridVersion) return;
+
+    int minX = GRID_SIZE;
+    int minY = GRID_SIZE;
+    for (int cy = 0; cy < NUM_CHUNKS; cy++) {
+        for (int cx = 0; cx < NUM_CHUNKS; cx++) {
+            uint32_t chunkVersion = gridChunkVersion(cx, cy);
+            if (!built || chunkVersion != builtChunkVersion[cy][cx]) {
+                builtChunkVersion[cy][cx] = chunkVersion;
+                if (cx * CHUNK_SIZE < minX) minX = cx * CHUNK_SIZE;
+                if (cy * CHUNK_SIZE < minY) minY = cy * CHUNK_SIZE;
+            }
+        }
+    }
+    if (minX < GRID_SIZE && minY < GRID_SIZE) {
+        rebuildFrom(minX, minY);
+    }
+    builtGridVersion = version;
+    built = true;
+}
+
+static inline int rectSum(SatLayer layer, int minX, int minY, int maxX, int maxY) {
+    return sat[layer][maxY + 1][maxX + 1] - sat[layer][minY][maxX + 1] -
+           sat[layer][maxY + 1][minX] + sat[layer][minY][minX];
+}
+
+static bool clipRect(int* minX, int* minY, int* maxX, int* maxY) {
+    if (*minX < 0) *minX = 0;
+    if (*minY < 0) *minY = 0;
+    if (*maxX >= GRID_SIZE) *maxX = GRID_SIZE - 1;
+    if (*maxY >= GRID_SIZE) *maxY = GRID_SIZE - 1;
+    return *minX <= *maxX && *minY <= *maxY;
+}
+
+/*
+ * regionCount
+ *
+ * Counts the cells of a rectangle that belong to a layer.
+ *
+ * @param[in] layer Which cells to count
+ * @param[in] minX Left tile (inclusive)
+ * @param[in] minY Top tile (inclusive)
+ * @param[in] maxX Right tile (inclusive)
+ * @param[in] maxY Bottom tile (inclusive)
+ * @return int The count; 0 for an empty rectangle
+ */
+int regionCount(SatLayer layer, int minX, int minY, int maxX, int maxY) {
+    if (layer < 0 || layer >= SAT_LAYER_COUNT) return 0;
+    if (!clipRect(&minX, &minY, &maxX, &maxY)) return 0;
+
+    SDL_AtomicLock(&satLock);
+    refreshTables();
+    int count = rectSum(layer, minX, minY, maxX, maxY);
+    SDL_AtomicUnlock(&satLock);
+    return count;
+}
+
+/*
+ * isFootprintClear
+ *
+ * Whether every tile of a width x height footprint is inside the grid,
+ * walkable and free of structures.
+ *
+ * @param[in] x Left tile
+ * @param[in] y Top tile
+ * @param[in] width Footprint width in tiles
+ * @param[in] height Footprint height in tiles
+ * @return bool True if the whole footprint is clear
+ */
+bool isFootprintClear(int x, int y, int width, int height) {
+    if (width <= 0 || height <= 0 || x < 0 || y < 0 ||
+        x + width > GRID_SIZE || y + height > GRID_SIZE) {
+        return false;
+    }
+    return regionCount(SAT_CLEAR, x, y, x + width - 1, y + height - 1) == width * height;
+}
+
+/*
+ * regionPickTile
+ *
+ * Picks one of the layer's cells inside a rectangle, uniformly given a
+ * uniform random number, by binary searching the table for the row and
+ * then the column. Replaces "try random tiles until one fits" loops.
+ *
+ * @param[in] layer Which cells to pick from
+ * @param[in] minX Left tile (inclusive)
+ * @param[in] minY Top tile (inclusive)
+ * @param[in] maxX Right tile (inclusive)
+ * @param[in] maxY Bottom tile (inclusive)
+ * @param[in] random Any random number; reduced modulo the cell count
+ * @param[out] tileX Picked column
+ * @param[out] tileY Picked row
+ * @return bool False if the rectangle holds no such cell
+ */
+bool regionPickTile(SatLayer layer, int minX, int minY, int maxX, int maxY,
+                    unsigned int random, int* tileX, int* tileY) {
+    if (layer < 0 || layer >= SAT_LAYER_COUNT) return false;
+    if (!clipRect(&minX, &minY, &maxX, &maxY)) return false;
+
+    SDL_AtomicLock(&satLock);
+    refreshTables();
+
+    int total = rectSum(layer, minX, minY, maxX, maxY);
+    if (total == 0) {
+        SDL_AtomicUnlock(&satLock);
+        return false;
+    }
+    int index = (int)(random % (unsigned int)total);
+
+    // First row whose running count passes index
+    int lo = minY, hi = maxY;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (rectSum(layer, minX, minY, maxX, mid) > index) hi = mid;
+        else lo = mid + 1;
+    }
+    int row = lo;
+    if (row > minY) {
+        index -= rectSum(layer, minX, minY, maxX, row - 1);
+    }
+
+    // Then the column within that row
+    lo = minX;
+    hi = maxX;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (rectSum(layer, minX, row, mid, row) > index) hi = mid;
+        else lo = mid + 1;
+    }
+    SDL_AtomicUnlock(&satLock);
+
+    *tileX = lo;
+    *tileY = row;
+    return true;
+}
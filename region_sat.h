@@ -0,0 +1,32 @@
+#ifndef REGION_SAT_H
+#define REGION_SAT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "grid.h"
+
+// Summed-area tables over grid[][]: for each layer, the number of matching
+// cells in any rectangle is four lookups. The tables are refreshed lazily
+// when queried: only the area right of and below the top-left-most chunk
+// whose gridChunkVersion moved is recomputed. Queries are safe from any
+// thread.
+
+typedef enum {
+    SAT_WALKABLE,    // Walkable flag set
+    SAT_CLEAR,       // Walkable and no structure: free to stand or build on
+    SAT_STRUCTURE,   // Any structure
+    SAT_TREE,        // Plant structure of tree material
+    SAT_WATER,       // Terrain classes
+    SAT_SAND,
+    SAT_GRASS,
+    SAT_STONE,
+    SAT_LAYER_COUNT
+} SatLayer;
+
+// Bounds are inclusive tiles and clipped to the grid
+int regionCount(SatLayer layer, int minX, int minY, int maxX, int maxY);
+bool isFootprintClear(int x, int y, int width, int height);
+bool regionPickTile(SatLayer layer, int minX, int minY, int maxX, int maxY,
+                    unsigned int random, int* tileX, int* tileY);
+
+#endif // REGION_SAT_H
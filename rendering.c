@@ -730,14 +730,16 @@ void initializeEnemyBatchVAO() {
 /**
  * @brief Updates the buffer data for rendering a batch of enemies.
  * 
- * @param enemies An array of enemy entities to render.
- * @param enemyCount The number of enemies in the array.
+ * @param frame Interpolated render frame to read the enemies from.
+ * @param enemyIds Entity ids of the enemies to render.
+ * @param enemyCount The number of ids in the array.
  * @param cameraOffsetX, cameraOffsetY The camera's X and Y offsets.
  * @param zoomFactor The zoom factor for rendering.
  * 
- * Populates the buffer with transformed vertex data for each enemy.
+ * Populates the buffer with transformed vertex data for each enemy, read
+ * from the render frame arrays.
  */
-void updateEnemyBatchVBO(Enemy* enemies, int enemyCount, float cameraOffsetX, float cameraOffsetY, float zoomFactor) {
+void updateEnemyBatchVBO(const RenderFrame* frame, const int* enemyIds, int enemyCount, float cameraOffsetX, float cameraOffsetY, float zoomFactor) {
     if (enemyCount == 0) return;
 
     float* vertices = (float*)malloc(enemyCount * 24 * sizeof(float));  // 6 vertices * 4 components
@@ -748,20 +750,17 @@ void updateEnemyBatchVBO(Enemy* enemies, int enemyCount, float cameraOffsetX, fl
 
     int vertexIndex = 0;
     for (int i = 0; i < enemyCount; i++) {
-        if (!isPositionInLoadedChunk(enemies[i].entity.posX, enemies[i].entity.posY)) {
-            continue;  // Skip rendering for enemies in unloaded chunks
-        }
-
-        float enemyScreenX = (enemies[i].entity.posX - cameraOffsetX) * zoomFactor;
-        float enemyScreenY = (enemies[i].entity.posY - cameraOffsetY) * zoomFactor;
+        int id = enemyIds[i];
+        float enemyScreenX = (tilesToViewX(frame->x[id]) - cameraOffsetX) * zoomFactor;
+        float enemyScreenY = (tilesToViewY(frame->y[id]) - cameraOffsetY) * zoomFactor;
         
         // Get enemy texture based on animation state and direction
         TextureCoords* enemyTex;
         char textureName[32];
 
-        if (!enemies[i].animation->isMoving) {
+        if (!frame->isMoving[id]) {
             // Use standing frame based on direction
-            switch(enemies[i].animation->facing) {
+            switch(frame->facing[id]) {
                 case ENEMY_DIR_UP:
                     enemyTex = getTextureCoords("enemy_run_up_0");
                     break;
@@ -780,7 +779,7 @@ void updateEnemyBatchVBO(Enemy* enemies, int enemyCount, float cameraOffsetX, fl
         } else {
             // Get running animation frame based on direction
             const char* dirStr;
-            switch(enemies[i].animation->facing) {
+            switch(frame->facing[id]) {
                 case ENEMY_DIR_UP:
                     dirStr = "up";
                     break;
@@ -797,7 +796,7 @@ void updateEnemyBatchVBO(Enemy* enemies, int enemyCount, float cameraOffsetX, fl
                     dirStr = "down";
             }
             snprintf(textureName, sizeof(textureName), "enemy_run_%s_%d", 
-                    dirStr, enemies[i].animation->currentFrame);
+                    dirStr, frame->animFrame[id]);
             enemyTex = getTextureCoords(textureName);
         }
 
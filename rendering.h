@@ -5,6 +5,7 @@
 #include <GL/glew.h>
 #include <stdlib.h>
 #include "enemy.h"
+#include "sim_snapshot.h"
 #include "gameloop.h"
 #include "structures.h"
 #include "inventory.h"
@@ -78,7 +79,7 @@ GLuint createSquareVAO(float size, float texX, float texY, float texWidth, float
 GLuint loadBMP(const char* filePath);
 GLuint createShader(GLenum type, const char* source);
 void initializeEnemyBatchVAO();
-void updateEnemyBatchVBO(Enemy* enemies, int enemyCount, float cameraOffsetX, float cameraOffsetY, float zoomFactor);
+void updateEnemyBatchVBO(const RenderFrame* frame, const int* enemyIds, int enemyCount, float cameraOffsetX, float cameraOffsetY, float zoomFactor);
 void renderStructurePreview(const PlacementMode* mode, float cameraOffsetX, float cameraOffsetY, float zoomFactor);
 
 #endif // RENDERING_H
\ No newline at end of file
@@ -7,15 +7,116 @@
 #include <time.h>
 #include <stdatomic.h>
 #include "structures.h"
+#include "texture_coords.h"
+#include "grid_edit.h"
+#include "grid_summary.h"
 #include <stdlib.h>
 #include "enemy.h" 
 #include "entity.h" 
 #include "gameloop.h"
+#include "world_timers.h"
 
 extern Player player;
 extern Enemy enemies[MAX_ENEMIES];
 extern void WorldToScreenCoords(int gridX, int gridY, float cameraOffsetX, float cameraOffsetY, float zoomFactor, float* screenX, float* screenY);
 
+// Where the terrain of the saved world comes from; see readSaveWorldSource
+typedef struct {
+    bool procedural;
+    uint32_t seed;
+    char mapPath[SAVE_MAX_MAP_PATH + 1];
+} SavedWorldSource;
+
+static char loadedMapPath[SAVE_MAX_MAP_PATH + 1];  // mapPath after readSaveWorldSource
+
+static bool writeWorldSource(FILE* file) {
+    uint8_t procedural = proceduralWorld ? 1 : 0;
+    uint32_t seed = worldSeed;
+    size_t length = procedural ? 0 : strlen(mapPath);
+    if (length > SAVE_MAX_MAP_PATH) {
+        printf("[ERROR] Map path too long to save: %s\n", mapPath);
+        return false;
+    }
+    uint16_t pathLength = (uint16_t)length;
+
+    return fwrite(&procedural, sizeof(procedural), 1, file) == 1 &&
+           fwrite(&seed, sizeof(seed), 1, file) == 1 &&
+           fwrite(&pathLength, sizeof(pathLength), 1, file) == 1 &&
+           fwrite(mapPath, 1, length, file) == length;
+}
+
+static bool readWorldSource(FILE* file, SavedWorldSource* source) {
+    uint8_t procedural;
+    uint16_t pathLength;
+    if (fread(&procedural, sizeof(procedural), 1, file) != 1 ||
+        fread(&source->seed, sizeof(source->seed), 1, file) != 1 ||
+        fread(&pathLength, sizeof(pathLength), 1, file) != 1 ||
+        pathLength > SAVE_MAX_MAP_PATH ||
+        fread(source->mapPath, 1, pathLength, file) != pathLength) {
+        printf("Save has a damaged world source\n");
+        return false;
+    }
+    source->procedural = procedural != 0;
+    source->mapPath[pathLength] = '\0';
+    return true;
+}
+
+// Reads and checks the magic number and version; leaves the file after the
+// timestamp
+static bool readSaveHeader(FILE* file, uint32_t* version) {
+    char magic[5] = {0};
+    uint32_t timestamp;
+
+    if (fread(magic, 1, 4, file) != 4 ||
+        fread(version, sizeof(*version), 1, file) != 1 ||
+        fread(&timestamp, sizeof(timestamp), 1, file) != 1 ||
+        strcmp(magic, MAGIC_NUMBER) != 0 ||
+        *version < SAVE_VERSION_UV_TEXTURES || *version > SAVE_VERSION) {
+        printf("Invalid or incompatible save file\n");
+        return false;
+    }
+    return true;
+}
+
+/*
+ * readSaveWorldSource
+ *
+ * Points terrain generation at the world a save was made in: procedural
+ * with its seed, or streamed from its map file. Must run before the game
+ * state is initialized, since that starts streaming chunks. Saves older
+ * than SAVE_VERSION_WORLD_SOURCE do not record it and keep the current
+ * command line's world.
+ *
+ * @param[in] filename Save file
+ * @return bool False if the save cannot be read
+ */
+bool readSaveWorldSource(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        printf("Failed to open save file\n");
+        return false;
+    }
+
+    uint32_t version;
+    SavedWorldSource source;
+    bool ok = readSaveHeader(file, &version);
+    if (ok && version >= SAVE_VERSION_WORLD_SOURCE) {
+        ok = readWorldSource(file, &source);
+        if (ok) {
+            proceduralWorld = source.procedural;
+            setWorldSeed(source.seed);
+            if (!source.procedural) {
+                memcpy(loadedMapPath, source.mapPath, sizeof(loadedMapPath));
+                mapPath = loadedMapPath;
+            }
+            printf("Save world: %s, seed 0x%08X\n",
+                   source.procedural ? "procedural" : mapPath, (unsigned int)source.seed);
+        }
+    }
+    fclose(file);
+    return ok;
+}
+
 bool saveGameState(const char* filename) {
     printf("[DEBUG] Starting saveGameState\n");
     FILE* file = fopen(filename, "wb");
@@ -30,17 +131,21 @@ bool saveGameState(const char* filename) {
     fwrite(&version, sizeof(uint32_t), 1, file);
     uint32_t timestamp = (uint32_t)time(NULL);
     fwrite(&timestamp, sizeof(uint32_t), 1, file);
+    if (!writeWorldSource(file)) {
+        fclose(file);
+        return false;
+    }
 
     printf("[DEBUG] Saving player position\n");
     int32_t gridX = atomic_load(&player.entity.gridX);
     int32_t gridY = atomic_load(&player.entity.gridY);
-    float posX = atomic_load(&player.entity.posX);
-    float posY = atomic_load(&player.entity.posY);
+    int32_t posX = atomic_load(&entityStore.posX[player.entity.id]);
+    int32_t posY = atomic_load(&entityStore.posY[player.entity.id]);
     
     fwrite(&gridX, sizeof(int32_t), 1, file);
     fwrite(&gridY, sizeof(int32_t), 1, file);
-    fwrite(&posX, sizeof(float), 1, file);
-    fwrite(&posY, sizeof(float), 1, file);
+    fwrite(&posX, sizeof(int32_t), 1, file);
+    fwrite(&posY, sizeof(int32_t), 1, file);
 
     printf("[DEBUG] Saving player skills\n");
     for (int i = 0; i < SKILL_COUNT; i++) {
@@ -49,40 +154,46 @@ bool saveGameState(const char* filename) {
     }
 
     printf("[DEBUG] Counting and saving structures\n");
+    // The count goes first but is only known once the records are written;
+    // leave room for it and patch it afterwards. Chunks without structures
+    // are skipped entirely.
     uint32_t structureCount = 0;
-    for (int y = 0; y < GRID_SIZE; y++) {
-        for (int x = 0; x < GRID_SIZE; x++) {
-            if (grid[y][x].structureType != STRUCTURE_NONE) {
-                structureCount++;
+    long countOffset = ftell(file);
+    fwrite(&structureCount, sizeof(uint32_t), 1, file);
+
+    for (int cy = 0; cy < NUM_CHUNKS; cy++) {
+        for (int cx = 0; cx < NUM_CHUNKS; cx++) {
+            if (getChunkSummary(cx, cy).structureCells == 0) continue;
+
+            for (int y = cy * CHUNK_SIZE; y < (cy + 1) * CHUNK_SIZE; y++) {
+                for (int x = cx * CHUNK_SIZE; x < (cx + 1) * CHUNK_SIZE; x++) {
+                    if (grid[y][x].structureType != STRUCTURE_NONE) {
+                        uint16_t structX = (uint16_t)x;
+                        uint16_t structY = (uint16_t)y;
+                        uint16_t flags = grid[y][x].flags;
+                        uint8_t structureType = grid[y][x].structureType;
+                        uint8_t materialType = grid[y][x].materialType;  // Save material type
+                        uint16_t texIndex = grid[y][x].texIndex;
+
+                        fwrite(&structX, sizeof(uint16_t), 1, file);
+                        fwrite(&structY, sizeof(uint16_t), 1, file);
+                        fwrite(&flags, sizeof(uint16_t), 1, file);
+                        fwrite(&structureType, sizeof(uint8_t), 1, file);
+                        fwrite(&materialType, sizeof(uint8_t), 1, file);  // Write material type
+                        fwrite(&texIndex, sizeof(uint16_t), 1, file);
+                        structureCount++;
+                    }
+                }
             }
         }
     }
 
+    long endOffset = ftell(file);
+    fseek(file, countOffset, SEEK_SET);
     fwrite(&structureCount, sizeof(uint32_t), 1, file);
+    fseek(file, endOffset, SEEK_SET);
     printf("[DEBUG] Total structures: %u\n", structureCount);
 
-    for (int y = 0; y < GRID_SIZE; y++) {
-        for (int x = 0; x < GRID_SIZE; x++) {
-            if (grid[y][x].structureType != STRUCTURE_NONE) {
-                uint16_t structX = (uint16_t)x;
-                uint16_t structY = (uint16_t)y;
-                uint8_t flags = grid[y][x].flags;
-                uint8_t structureType = grid[y][x].structureType;
-                uint8_t materialType = grid[y][x].materialType;  // Save material type
-                float texX = grid[y][x].wallTexX;
-                float texY = grid[y][x].wallTexY;
-
-                fwrite(&structX, sizeof(uint16_t), 1, file);
-                fwrite(&structY, sizeof(uint16_t), 1, file);
-                fwrite(&flags, sizeof(uint8_t), 1, file);
-                fwrite(&structureType, sizeof(uint8_t), 1, file);
-                fwrite(&materialType, sizeof(uint8_t), 1, file);  // Write material type
-                fwrite(&texX, sizeof(float), 1, file);
-                fwrite(&texY, sizeof(float), 1, file);
-            }
-        }
-    }
-
     printf("[DEBUG] Saving enclosures\n");
     uint32_t enclosureCount = (uint32_t)globalEnclosureManager.count;
     fwrite(&enclosureCount, sizeof(uint32_t), 1, file);
@@ -108,6 +219,12 @@ bool saveGameState(const char* filename) {
         }
     }
 
+    printf("[DEBUG] Saving world timers\n");
+    if (!writeWorldTimers(file)) {
+        fclose(file);
+        return false;
+    }
+
     fclose(file);
     printf("[DEBUG] Game saved successfully to: %s\n", filename);
     return true;
@@ -121,27 +238,34 @@ bool loadGameState(const char* filename) {
         return false;
     }
 
-    char magic[5] = {0};
     uint32_t version;
-    uint32_t timestamp;
-    
-    fread(magic, 1, 4, file);
-    fread(&version, sizeof(version), 1, file);
-    fread(&timestamp, sizeof(timestamp), 1, file);
-    
-    if (strcmp(magic, MAGIC_NUMBER) != 0 || version != SAVE_VERSION) {
-        printf("Invalid or incompatible save file\n");
+    if (!readSaveHeader(file, &version)) {
+        fclose(file);
+        return false;
+    }
+
+    // Already applied by readSaveWorldSource, before the chunks streamed
+    SavedWorldSource source;
+    if (version >= SAVE_VERSION_WORLD_SOURCE && !readWorldSource(file, &source)) {
         fclose(file);
         return false;
     }
 
     int32_t playerGridX, playerGridY;
-    float playerPosX, playerPosY;
+    WorldCoord playerPosX, playerPosY;
     
     fread(&playerGridX, sizeof(playerGridX), 1, file);
     fread(&playerGridY, sizeof(playerGridY), 1, file);
-    fread(&playerPosX, sizeof(playerPosX), 1, file);
-    fread(&playerPosY, sizeof(playerPosY), 1, file);
+    if (version <= SAVE_VERSION_VIEW_POSITIONS) {
+        float viewX, viewY;
+        fread(&viewX, sizeof(float), 1, file);
+        fread(&viewY, sizeof(float), 1, file);
+        playerPosX = worldFromTiles(viewToTilesX(viewX));
+        playerPosY = worldFromTiles(viewToTilesY(viewY));
+    } else {
+        fread(&playerPosX, sizeof(int32_t), 1, file);
+        fread(&playerPosY, sizeof(int32_t), 1, file);
+    }
 
     // Load player skills
     for (int i = 0; i < SKILL_COUNT; i++) {
@@ -152,33 +276,51 @@ bool loadGameState(const char* filename) {
     uint32_t structureCount;
     fread(&structureCount, sizeof(structureCount), 1, file);
     
+    gridBeginBatch();
     for (uint32_t i = 0; i < structureCount; i++) {
         uint16_t structX, structY;
-        uint8_t flags;
+        uint16_t flags = 0;
         uint8_t structureType;
         uint8_t materialType;  // Load material type
-        float texX, texY;
+        uint16_t texIndex;
 
         fread(&structX, sizeof(structX), 1, file);
         fread(&structY, sizeof(structY), 1, file);
-        fread(&flags, sizeof(flags), 1, file);
+        if (version == SAVE_VERSION_UV_TEXTURES) {
+            uint8_t legacyFlags;
+            fread(&legacyFlags, sizeof(legacyFlags), 1, file);
+            flags = legacyFlags;
+        } else {
+            fread(&flags, sizeof(flags), 1, file);
+        }
         fread(&structureType, sizeof(structureType), 1, file);
         fread(&materialType, sizeof(materialType), 1, file);  // Read material type
-        fread(&texX, sizeof(texX), 1, file);
-        fread(&texY, sizeof(texY), 1, file);
+        if (version == SAVE_VERSION_UV_TEXTURES) {
+            float texX, texY;
+            fread(&texX, sizeof(texX), 1, file);
+            fread(&texY, sizeof(texY), 1, file);
+            texIndex = textureIndexFromUV(texX, texY);
+            if (texIndex == TEXTURE_INDEX_INVALID) {
+                texIndex = 0;
+            }
+        } else {
+            fread(&texIndex, sizeof(texIndex), 1, file);
+        }
 
         if (structX < GRID_SIZE && structY < GRID_SIZE) {
-            grid[structY][structX].flags = flags;
-            grid[structY][structX].structureType = structureType;
-            grid[structY][structX].materialType = materialType;  // Set material type
-            grid[structY][structX].wallTexX = texX;
-            grid[structY][structX].wallTexY = texY;
+            GridCell cell = grid[structY][structX];
+            cell.flags = flags;
+            cell.structureType = structureType;
+            cell.materialType = materialType;  // Set material type
+            cell.texIndex = texIndex;
+            gridWriteCell(structX, structY, cell);
             
-            printf("Loaded structure at (%d,%d): structType=%d, material=%d, isWalkable=%d texY=%f\n", 
+            printf("Loaded structure at (%d,%d): structType=%d, material=%d, isWalkable=%d texIndex=%u\n", 
                 structX, structY, structureType, materialType,
-                GRIDCELL_IS_WALKABLE(grid[structY][structX]), texY);
+                GRIDCELL_IS_WALKABLE(grid[structY][structX]), texIndex);
         }
     }
+    gridEndBatch();
 
     uint32_t enclosureCount;
     fread(&enclosureCount, sizeof(enclosureCount), 1, file);
@@ -217,18 +359,24 @@ bool loadGameState(const char* filename) {
         free(enclosure.interiorTiles);
     }
 
-    atomic_store(&player.entity.gridX, playerGridX);
-    atomic_store(&player.entity.gridY, playerGridY);
-    atomic_store(&player.entity.posX, playerPosX);
-    atomic_store(&player.entity.posY, playerPosY);
+    // Pending regrowth and door timers replace the live ones; older saves
+    // start with none
+    clearWorldTimers();
+    if (version >= SAVE_VERSION_TIMERS && !readWorldTimers(file)) {
+        printf("Save has a damaged timer section; pending world events were dropped\n");
+    }
+
+    // Occupancy and the spatial hash were reset for the load, so register
+    // the player even when the saved tile is the one it stood on
+    placeEntity(&player.entity, playerGridX, playerGridY);
+    atomic_store(&entityStore.posX[player.entity.id], playerPosX);
+    atomic_store(&entityStore.posY[player.entity.id], playerPosY);
 
-    atomic_store(&player.cameraTargetX, playerPosX);
-    atomic_store(&player.cameraTargetY, playerPosY);
-    atomic_store(&player.cameraCurrentX, playerPosX);
-    atomic_store(&player.cameraCurrentY, playerPosY);
+    player.cameraTargetX = player.cameraCurrentX = worldToTiles(playerPosX);
+    player.cameraTargetY = player.cameraCurrentY = worldToTiles(playerPosY);
 
-    atomic_store(&player.entity.targetGridX, playerGridX);
-    atomic_store(&player.entity.targetGridY, playerGridY);
+    atomic_store(&entityStore.targetGridX[player.entity.id], playerGridX);
+    atomic_store(&entityStore.targetGridY[player.entity.id], playerGridY);
     atomic_store(&player.entity.finalGoalX, playerGridX);
     atomic_store(&player.entity.finalGoalY, playerGridY);
     atomic_store(&player.entity.needsPathfinding, false);
@@ -236,13 +384,16 @@ bool loadGameState(const char* filename) {
     player.hasBuildTarget = false;
     player.targetBuildX = 0;
     player.targetBuildY = 0;
+    player.hasHarvestTarget = false;
+    setEntityPath(&player.entity, NULL, 0);  // Planned through the old world
 
     fclose(file);
     return true;
 }
 void CleanupBeforeLoad(void) {
-    // Cleanup existing state before loading
-    CleanupEntities();
+    // Cleanup existing state before loading. The player stays: its
+    // inventory is not in the save, and loadGameState moves it.
+    CleanupEnemies();
     cleanupEnclosureManager(&globalEnclosureManager);
     if (globalChunkManager) {
         cleanupChunkManager(globalChunkManager);
@@ -253,6 +404,9 @@ void CleanupBeforeLoad(void) {
 
 bool InitializeFromSave(const char* filename) {
     CleanupBeforeLoad();
+    readSaveWorldSource(filename);
     InitializeGameState(false);  // false = loading save
-    return loadGameState(filename);
+    bool loaded = loadGameState(filename);
+    FinishGameLoad();
+    return loaded;
 }
\ No newline at end of file
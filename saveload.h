@@ -5,12 +5,24 @@
 #include <stdbool.h>
 #include <stdint.h>
 
-// Version 1 of save format
-#define SAVE_VERSION 1
+// Version 5 of save format: the header records where the terrain comes
+// from (procedural with its seed, or the map file), since terrain itself
+// is regenerated rather than stored. Version 4 added the pending world
+// timers after the enclosures. From version 3 on, the player position is
+// 16.16 fixed-point tiles. Version 2 stored it as view-space floats;
+// version 1 additionally stored structure UVs instead of an atlas index.
+// All are still readable.
+#define SAVE_VERSION 5
+#define SAVE_VERSION_WORLD_SOURCE 5
+#define SAVE_VERSION_TIMERS 4
+#define SAVE_VERSION_VIEW_POSITIONS 2
+#define SAVE_VERSION_UV_TEXTURES 1
 #define MAGIC_NUMBER "SAV1"
+#define SAVE_MAX_MAP_PATH 1024
 
 bool saveGameState(const char* filename);
 bool loadGameState(const char* filename);
+bool readSaveWorldSource(const char* filename);
 
 bool InitializeFromSave(const char* filename);
 void CleanupBeforeLoad(void);
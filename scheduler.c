@@ -0,0 +1,83 @@
+// scheduler.c
+#include "scheduler.h"
+#include <stdio.h>
+#include <string.h>
+
+void initScheduler(Scheduler* scheduler) {
+    memset(scheduler, 0, sizeof(*scheduler));
+}
+
+/*
+ * schedulerAddSystem
+ *
+ * Registers a system. Systems due on the same tick run in the order they
+ * were added.
+ *
+ * @param[in,out] scheduler The scheduler
+ * @param[in] name Name used in the statistics; must outlive the scheduler
+ * @param[in] run System function
+ * @param[in] context Opaque pointer passed to run
+ * @param[in] period Ticks between runs, at least 1
+ * @param[in] phase Tick within the period to run on, 0 to period - 1
+ * @return bool False if the system table is full or the rate is invalid
+ */
+bool schedulerAddSystem(Scheduler* scheduler, const char* name, SystemFn run, void* context,
+                        int period, int phase) {
+    if (!run || period < 1 || phase < 0 || phase >= period) {
+        fprintf(stderr, "Invalid rate for system %s: period %d, phase %d\n",
+                name ? name : "?", period, phase);
+        return false;
+    }
+    if (scheduler->systemCount >= SCHEDULER_MAX_SYSTEMS) {
+        fprintf(stderr, "Too many systems, cannot add %s\n", name ? name : "?");
+        return false;
+    }
+
+    System* system = &scheduler->systems[scheduler->systemCount++];
+    *system = (System){
+        .name = name,
+        .run = run,
+        .context = context,
+        .period = period,
+        .phase = phase
+    };
+    return true;
+}
+
+/*
+ * schedulerRunTick
+ *
+ * Runs every system due on the current tick, timing each, then advances
+ * to the next tick.
+ *
+ * @param[in,out] scheduler The scheduler
+ */
+void schedulerRunTick(Scheduler* scheduler) {
+    for (int i = 0; i < scheduler->systemCount; i++) {
+        System* system = &scheduler->systems[i];
+        if (scheduler->tick % (Uint32)system->period != (Uint32)system->phase) continue;
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        system->run(system->context);
+        system->lastTime = SDL_GetPerformanceCounter() - start;
+
+        system->totalTime += system->lastTime;
+        if (system->lastTime > system->maxTime) {
+            system->maxTime = system->lastTime;
+        }
+        system->runs++;
+    }
+    scheduler->tick++;
+}
+
+void schedulerPrintStats(const Scheduler* scheduler) {
+    double msPerCount = 1000.0 / (double)SDL_GetPerformanceFrequency();
+
+    printf("%-16s %7s %10s %10s %10s\n", "system", "period", "runs", "avg ms", "max ms");
+    for (int i = 0; i < scheduler->systemCount; i++) {
+        const System* system = &scheduler->systems[i];
+        double average = system->runs ? (double)system->totalTime / system->runs * msPerCount : 0.0;
+        printf("%-16s %7d %10u %10.3f %10.3f\n", system->name, system->period,
+               (unsigned)system->runs, average, (double)system->maxTime * msPerCount);
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdbool.h>
+#include <SDL2/SDL.h>
+
+// Fixed-rate system scheduler. Each system registers with a period and a
+// phase in scheduler ticks and runs exactly once on every tick where
+// tick % period == phase, in registration order. Slots are counted in
+// ticks rather than wall time, so a slow tick delays later slots instead of
+// skipping or doubling them. Spreading phases keeps slow systems that share
+// a period off the same tick.
+
+#define SCHEDULER_MAX_SYSTEMS 16
+
+// Called once per scheduled slot
+typedef void (*SystemFn)(void* context);
+
+typedef struct {
+    const char* name;
+    SystemFn run;
+    void* context;
+    int period;          // Ticks between runs
+    int phase;           // Tick within the period the system runs on
+
+    // Performance counter ticks
+    Uint64 lastTime;
+    Uint64 totalTime;
+    Uint64 maxTime;
+    Uint32 runs;
+} System;
+
+typedef struct {
+    System systems[SCHEDULER_MAX_SYSTEMS];
+    int systemCount;
+    Uint32 tick;         // Ticks run so far
+} Scheduler;
+
+void initScheduler(Scheduler* scheduler);
+bool schedulerAddSystem(Scheduler* scheduler, const char* name, SystemFn run, void* context,
+                        int period, int phase);
+void schedulerRunTick(Scheduler* scheduler);
+void schedulerPrintStats(const Scheduler* scheduler);
+
+#endif // SCHEDULER_H
@@ -0,0 +1,177 @@
+// sim_snapshot.c
+#include "sim_snapshot.h"
+#include "gameloop.h"
+#include "enemy_residency.h"
+#include "entity_pool.h"
+#include "grid_edit.h"
+#include "structure_types.h"
+#include <stdatomic.h>
+#include <string.h>
+
+extern Player player;
+
+#define SNAPSHOT_FRESH 4  // Set in middleSlot while it holds an unread snapshot
+
+static SimSnapshot slots[3];
+
+RenderFrame renderFrame = { .world = &slots[2].world };  // The front slot until the first frame
+
+static atomic_int middleSlot = 1;
+static int backSlot = 0;   // Physics thread only
+static int frontSlot = 2;  // Render thread only
+
+// What the physics thread last published, for the next snapshot's
+// previous positions
+static bool lastPresent[MAX_ENTITIES];
+static EntityHandle lastHandle[MAX_ENTITIES];  // Tells a reused id from the entity it replaced
+static WorldCoord lastX[MAX_ENTITIES];
+static WorldCoord lastY[MAX_ENTITIES];
+static float lastCameraX, lastCameraY;
+static atomic_bool resetPending;
+
+/*
+ * resetSimSnapshots
+ *
+ * Makes the next snapshot forget the previous positions, so entities placed
+ * by a new or loaded game appear in place instead of sliding there. Safe to
+ * call from any thread.
+ */
+void resetSimSnapshots(void) {
+    atomic_store(&resetPending, true);
+}
+
+static void captureEntity(SimSnapshot* snapshot, int id) {
+    WorldCoord x = atomic_load_explicit(&entityStore.posX[id], memory_order_relaxed);
+    WorldCoord y = atomic_load_explicit(&entityStore.posY[id], memory_order_relaxed);
+
+    EntityHandle handle = entityPoolHandle(id);
+    bool continued = lastPresent[id] && lastHandle[id] == handle;
+    lastHandle[id] = handle;
+
+    snapshot->present[id] = true;
+    snapshot->posX[id] = x;
+    snapshot->posY[id] = y;
+    snapshot->prevX[id] = continued ? lastX[id] : x;
+    snapshot->prevY[id] = continued ? lastY[id] : y;
+    snapshot->facing[id] = entityStore.facing[id];
+    snapshot->animFrame[id] = entityStore.animFrame[id];
+    snapshot->isMoving[id] = entityStore.isMoving[id];
+}
+
+// Brings a slot's copy of the grid up to date, chunk by chunk. Only the
+// physics thread writes the grid, so it can read it here without racing.
+static void captureWorld(WorldSnapshot* world) {
+    for (int cy = 0; cy < NUM_CHUNKS; cy++) {
+        for (int cx = 0; cx < NUM_CHUNKS; cx++) {
+            uint32_t version = gridChunkVersion(cx, cy);
+            if (world->copied && world->versions[cy][cx] == version) continue;
+
+            bool trees = false;
+            for (int y = cy * CHUNK_SIZE; y < (cy + 1) * CHUNK_SIZE; y++) {
+                memcpy(&world->cells[y][cx * CHUNK_SIZE], &grid[y][cx * CHUNK_SIZE],
+                       sizeof(GridCell) * CHUNK_SIZE);
+                for (int x = cx * CHUNK_SIZE; x < (cx + 1) * CHUNK_SIZE; x++) {
+                    trees |= grid[y][x].structureType == STRUCTURE_PLANT &&
+                             grid[y][x].materialType == MATERIAL_TREE;
+                }
+            }
+            world->versions[cy][cx] = version;
+            world->hasTrees[cy][cx] = trees;
+        }
+    }
+    world->copied = true;
+}
+
+/*
+ * publishSimSnapshot
+ *
+ * Captures the player, the active enemies, the camera and the grid cells
+ * and hands them to the renderer. Physics thread, once at the end of every
+ * tick.
+ *
+ * @param[in] tickMs Length of a physics tick in milliseconds
+ */
+void publishSimSnapshot(Uint32 tickMs) {
+    SimSnapshot* snapshot = &slots[backSlot];
+
+    if (atomic_exchange(&resetPending, false)) {
+        memset(lastPresent, 0, sizeof(lastPresent));
+        lastCameraX = player.cameraCurrentX;
+        lastCameraY = player.cameraCurrentY;
+    }
+
+    // Only ids below the pool's span can be present; clear what this slot
+    // held last time too, in case a reset shrank the span since
+    int span = entityPoolSpan();
+    int stale = snapshot->span > span ? snapshot->span : span;
+    memset(snapshot->present, 0, sizeof(bool) * (size_t)stale);
+    snapshot->span = span;
+
+    captureEntity(snapshot, player.entity.id);
+    int activeCount = activeEnemyCount();
+    for (int i = 0; i < activeCount; i++) {
+        captureEntity(snapshot, activeEnemy(i)->entity.id);
+    }
+
+    snapshot->cameraX = player.cameraCurrentX;
+    snapshot->cameraY = player.cameraCurrentY;
+    snapshot->prevCameraX = lastCameraX;
+    snapshot->prevCameraY = lastCameraY;
+    captureWorld(&snapshot->world);
+    snapshot->interval = SDL_GetPerformanceFrequency() * tickMs / 1000;
+    snapshot->time = SDL_GetPerformanceCounter();
+
+    memcpy(lastPresent, snapshot->present, sizeof(bool) * (size_t)span);
+    memcpy(lastX, snapshot->posX, sizeof(WorldCoord) * (size_t)span);
+    memcpy(lastY, snapshot->posY, sizeof(WorldCoord) * (size_t)span);
+    lastCameraX = snapshot->cameraX;
+    lastCameraY = snapshot->cameraY;
+
+    backSlot = atomic_exchange(&middleSlot, backSlot | SNAPSHOT_FRESH) & 3;
+}
+
+/*
+ * buildRenderFrame
+ *
+ * Takes the newest snapshot and interpolates it to the given time. Render
+ * thread only.
+ *
+ * @param[out] frame Frame to fill
+ * @param[in] now SDL_GetPerformanceCounter() of the frame
+ */
+void buildRenderFrame(RenderFrame* frame, Uint64 now) {
+    if (atomic_load(&middleSlot) & SNAPSHOT_FRESH) {
+        frontSlot = atomic_exchange(&middleSlot, frontSlot) & 3;
+    }
+    const SimSnapshot* snapshot = &slots[frontSlot];
+
+    // 0 at publication, reaching the newest positions one tick later
+    // (a snapshot published after the frame's timestamp counts as just now)
+    float alpha = 0.0f;
+    if (snapshot->interval == 0) {
+        alpha = 1.0f;
+    } else if (now > snapshot->time) {
+        Uint64 since = now - snapshot->time;
+        alpha = since >= snapshot->interval ? 1.0f : (float)since / (float)snapshot->interval;
+    }
+
+    for (int id = snapshot->span; id < frame->span; id++) {
+        frame->present[id] = false;
+    }
+    frame->span = snapshot->span;
+    for (int id = 0; id < snapshot->span; id++) {
+        frame->present[id] = snapshot->present[id];
+        if (!snapshot->present[id]) continue;
+
+        float prevX = worldToTiles(snapshot->prevX[id]);
+        float prevY = worldToTiles(snapshot->prevY[id]);
+        frame->x[id] = prevX + (worldToTiles(snapshot->posX[id]) - prevX) * alpha;
+        frame->y[id] = prevY + (worldToTiles(snapshot->posY[id]) - prevY) * alpha;
+        frame->facing[id] = snapshot->facing[id];
+        frame->animFrame[id] = snapshot->animFrame[id];
+        frame->isMoving[id] = snapshot->isMoving[id];
+    }
+    frame->cameraX = snapshot->prevCameraX + (snapshot->cameraX - snapshot->prevCameraX) * alpha;
+    frame->cameraY = snapshot->prevCameraY + (snapshot->cameraY - snapshot->prevCameraY) * alpha;
+    frame->world = &snapshot->world;
+}
@@ -0,0 +1,66 @@
+#ifndef SIM_SNAPSHOT_H
+#define SIM_SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <SDL2/SDL.h>
+#include "entity.h"
+
+// The physics thread publishes what the renderer needs at the end of every
+// tick as an immutable snapshot, handed over through a triple buffer: the
+// writer always has a free slot, the reader always holds a complete one,
+// and neither waits. Each snapshot carries the previous tick's positions
+// too, so the renderer can interpolate between the two by the time since
+// publication and draw smooth motion at any frame rate, one physics tick
+// behind the simulation.
+//
+// The render thread reads only its RenderFrame, built once per frame, and
+// never the live entity store or grid. Grid cells travel in the snapshot
+// too: each slot keeps a full copy of the grid and, when published,
+// re-copies only the chunks whose gridChunkVersion moved since that slot
+// last copied them.
+
+typedef struct {
+    GridCell cells[GRID_SIZE][GRID_SIZE];
+    uint32_t versions[NUM_CHUNKS][NUM_CHUNKS];  // gridChunkVersion of each chunk as copied
+    bool hasTrees[NUM_CHUNKS][NUM_CHUNKS];      // Chunk holds a tree (canopy pass)
+    bool copied;                                // False until the first full copy
+} WorldSnapshot;
+
+typedef struct {
+    Uint64 time;                       // SDL_GetPerformanceCounter() when published
+    Uint64 interval;                   // Performance counter ticks per physics tick
+    int span;                          // entityPoolSpan() when published; ids past it are absent
+    bool present[MAX_ENTITIES];        // The player and the active enemies
+    WorldCoord prevX[MAX_ENTITIES];    // Positions one tick earlier
+    WorldCoord prevY[MAX_ENTITIES];
+    WorldCoord posX[MAX_ENTITIES];
+    WorldCoord posY[MAX_ENTITIES];
+    uint8_t facing[MAX_ENTITIES];
+    uint8_t animFrame[MAX_ENTITIES];
+    bool isMoving[MAX_ENTITIES];
+    float prevCameraX, prevCameraY;    // World tiles
+    float cameraX, cameraY;
+    WorldSnapshot world;
+} SimSnapshot;
+
+// Interpolated state for one rendered frame; render thread only
+typedef struct {
+    int span;                          // Ids past it are absent
+    bool present[MAX_ENTITIES];
+    float x[MAX_ENTITIES];             // World tiles
+    float y[MAX_ENTITIES];
+    uint8_t facing[MAX_ENTITIES];
+    uint8_t animFrame[MAX_ENTITIES];
+    bool isMoving[MAX_ENTITIES];
+    float cameraX, cameraY;            // World tiles
+    const WorldSnapshot* world;        // Cells of the newest snapshot; valid until the next frame
+} RenderFrame;
+
+extern RenderFrame renderFrame;
+
+void resetSimSnapshots(void);
+void publishSimSnapshot(Uint32 tickMs);
+void buildRenderFrame(RenderFrame* frame, Uint64 now);
+
+#endif // SIM_SNAPSHOT_H
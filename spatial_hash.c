@@ -0,0 +1,173 @@
+// spatial_hash.c
+#include "spatial_hash.h"
+#include <SDL2/SDL.h>
+
+static int bucketHead[SPATIAL_CELLS][SPATIAL_CELLS];
+static int nextInBucket[MAX_ENTITIES];
+static int prevInBucket[MAX_ENTITIES];
+static int entityTileX[MAX_ENTITIES];
+static int entityTileY[MAX_ENTITIES];
+static bool inHash[MAX_ENTITIES];
+static bool hashReady;
+static SDL_SpinLock hashLock;  // Guards everything above
+
+static inline int bucketOf(int tile) {
+    return tile / SPATIAL_CELL_SIZE;
+}
+
+static void resetLocked(void) {
+    for (int by = 0; by < SPATIAL_CELLS; by++) {
+        for (int bx = 0; bx < SPATIAL_CELLS; bx++) {
+            bucketHead[by][bx] = -1;
+        }
+    }
+    for (int id = 0; id < MAX_ENTITIES; id++) {
+        inHash[id] = false;
+    }
+    hashReady = true;
+}
+
+static void unlinkLocked(int id) {
+    int prev = prevInBucket[id];
+    int next = nextInBucket[id];
+
+    if (prev >= 0) {
+        nextInBucket[prev] = next;
+    } else {
+        bucketHead[bucketOf(entityTileY[id])][bucketOf(entityTileX[id])] = next;
+    }
+    if (next >= 0) {
+        prevInBucket[next] = prev;
+    }
+    inHash[id] = false;
+}
+
+/*
+ * spatialHashReset
+ *
+ * Empties the hash. Called when a game starts, before entities spawn.
+ */
+void spatialHashReset(void) {
+    SDL_AtomicLock(&hashLock);
+    resetLocked();
+    SDL_AtomicUnlock(&hashLock);
+}
+
+/*
+ * spatialHashPlace
+ *
+ * Records that an entity is on a tile, inserting it if it is not in the
+ * hash yet. Moves within a bucket only update the stored tile.
+ *
+ * @param[in] id entityStore id
+ * @param[in] tileX Tile column
+ * @param[in] tileY Tile row
+ */
+void spatialHashPlace(int id, int tileX, int tileY) {
+    if (id < 0 || id >= MAX_ENTITIES) return;
+    if (!isValid(tileX, tileY)) {
+        spatialHashRemove(id);
+        return;
+    }
+
+    SDL_AtomicLock(&hashLock);
+    if (!hashReady) resetLocked();
+
+    int bx = bucketOf(tileX), by = bucketOf(tileY);
+    if (inHash[id] && bucketOf(entityTileX[id]) == bx && bucketOf(entityTileY[id]) == by) {
+        entityTileX[id] = tileX;
+        entityTileY[id] = tileY;
+        SDL_AtomicUnlock(&hashLock);
+        return;
+    }
+
+    if (inHash[id]) unlinkLocked(id);
+    entityTileX[id] = tileX;
+    entityTileY[id] = tileY;
+    prevInBucket[id] = -1;
+    nextInBucket[id] = bucketHead[by][bx];
+    if (nextInBucket[id] >= 0) prevInBucket[nextInBucket[id]] = id;
+    bucketHead[by][bx] = id;
+    inHash[id] = true;
+    SDL_AtomicUnlock(&hashLock);
+}
+
+void spatialHashRemove(int id) {
+    if (id < 0 || id >= MAX_ENTITIES) return;
+
+    SDL_AtomicLock(&hashLock);
+    if (hashReady && inHash[id]) unlinkLocked(id);
+    SDL_AtomicUnlock(&hashLock);
+}
+
+// Collects entities in the clipped rectangle; radius < 0 keeps them all,
+// otherwise only those within radius tiles of (centreX, centreY)
+static int query(int minX, int minY, int maxX, int maxY, int centreX, int centreY, int radius,
+                 int* ids, int maxIds) {
+    if (minX < 0) minX = 0;
+    if (minY < 0) minY = 0;
+    if (maxX > GRID_SIZE - 1) maxX = GRID_SIZE - 1;
+    if (maxY > GRID_SIZE - 1) maxY = GRID_SIZE - 1;
+    if (minX > maxX || minY > maxY) return 0;
+
+    int count = 0;
+    SDL_AtomicLock(&hashLock);
+    if (hashReady) {
+        for (int by = bucketOf(minY); by <= bucketOf(maxY); by++) {
+            for (int bx = bucketOf(minX); bx <= bucketOf(maxX); bx++) {
+                for (int id = bucketHead[by][bx]; id >= 0; id = nextInBucket[id]) {
+                    int x = entityTileX[id], y = entityTileY[id];
+                    if (x < minX || x > maxX || y < minY || y > maxY) continue;
+                    if (radius >= 0 &&
+                        (x - centreX) * (x - centreX) + (y - centreY) * (y - centreY) > radius * radius) {
+                        continue;
+                    }
+                    if (count < maxIds) ids[count] = id;
+                    count++;
+                }
+            }
+        }
+    }
+    SDL_AtomicUnlock(&hashLock);
+    return count;
+}
+
+/*
+ * spatialHashQueryRect
+ *
+ * Finds the entities standing on tiles inside a rectangle.
+ *
+ * @param[in] minX, minY, maxX, maxY Inclusive tile bounds; clipped to the grid
+ * @param[out] ids Receives up to maxIds entityStore ids
+ * @param[in] maxIds Capacity of ids
+ * @return int Number of matching entities
+ */
+int spatialHashQueryRect(int minX, int minY, int maxX, int maxY, int* ids, int maxIds) {
+    return query(minX, minY, maxX, maxY, 0, 0, -1, ids, maxIds);
+}
+
+int spatialHashQueryTile(int tileX, int tileY, int* ids, int maxIds) {
+    return query(tileX, tileY, tileX, tileY, 0, 0, -1, ids, maxIds);
+}
+
+/*
+ * spatialHashQueryRadius
+ *
+ * Finds the entities within a Euclidean tile distance of a tile.
+ *
+ * @param[in] tileX, tileY Centre tile
+ * @param[in] radius Distance in tiles, inclusive
+ * @param[out] ids Receives up to maxIds entityStore ids
+ * @param[in] maxIds Capacity of ids
+ * @return int Number of matching entities
+ */
+int spatialHashQueryRadius(int tileX, int tileY, int radius, int* ids, int maxIds) {
+    if (radius < 0) return 0;
+    return query(tileX - radius, tileY - radius, tileX + radius, tileY + radius,
+                 tileX, tileY, radius, ids, maxIds);
+}
+
+bool spatialHashTileOccupied(int tileX, int tileY) {
+    int id;
+    return spatialHashQueryTile(tileX, tileY, &id, 1) > 0;
+}
@@ -0,0 +1,30 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <stdbool.h>
+#include "entity.h"
+
+// Uniform-grid spatial hash of entities by tile. The world is cut into
+// SPATIAL_CELL_SIZE x SPATIAL_CELL_SIZE tile buckets, each an intrusive
+// list of entity ids, so "who is on / near this tile" only looks at the
+// buckets the query touches. An entity is in the hash while it occupies a
+// tile: it is placed wherever the occupancy plane is updated (setEntityTile,
+// spawning, resuming) and removed when its enemy is suspended. Any thread
+// may query; updates and queries are serialised by a spinlock.
+//
+// Queries write matching entityStore ids to `ids` and return how many
+// matched, which may exceed maxIds; only the first maxIds are written.
+
+#define SPATIAL_CELL_SIZE 4
+#define SPATIAL_CELLS ((GRID_SIZE + SPATIAL_CELL_SIZE - 1) / SPATIAL_CELL_SIZE)
+
+void spatialHashReset(void);
+void spatialHashPlace(int id, int tileX, int tileY);
+void spatialHashRemove(int id);
+
+int spatialHashQueryTile(int tileX, int tileY, int* ids, int maxIds);
+int spatialHashQueryRect(int minX, int minY, int maxX, int maxY, int* ids, int maxIds);
+int spatialHashQueryRadius(int tileX, int tileY, int radius, int* ids, int maxIds);
+bool spatialHashTileOccupied(int tileX, int tileY);
+
+#endif // SPATIAL_HASH_H
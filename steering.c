@@ -0,0 +1,168 @@
+// steering.c
+#include "steering.h"
+#include "grid_planes.h"
+#include "spatial_hash.h"
+#include <math.h>
+#include <immintrin.h>
+
+typedef struct {
+    float x, y;
+} Push;
+
+static const int stepX[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+static const int stepY[8] = { -1, -1, -1, 0, 0, 1, 1, 1 };
+
+// Sum of the pushes of the entities near this one. Entities on exactly
+// the same spot push apart along x, in a direction fixed by their ids.
+static Push separationPush(int id, int gridX, int gridY) {
+    int ids[STEER_MAX_NEIGHBOURS];
+    int count = spatialHashQueryRadius(gridX, gridY, STEER_RADIUS, ids, STEER_MAX_NEIGHBOURS);
+    if (count > STEER_MAX_NEIGHBOURS) count = STEER_MAX_NEIGHBOURS;
+
+    float selfX = worldToTiles(atomic_load_explicit(&entityStore.posX[id], memory_order_relaxed));
+    float selfY = worldToTiles(atomic_load_explicit(&entityStore.posY[id], memory_order_relaxed));
+
+    // Offsets to the neighbours, padded to whole groups of 4 with far away
+    // entries that push with (nearly) nothing
+    _Alignas(16) float dx[STEER_MAX_NEIGHBOURS + 3];
+    _Alignas(16) float dy[STEER_MAX_NEIGHBOURS + 3];
+    int n = 0;
+    for (int i = 0; i < count; i++) {
+        if (ids[i] == id) continue;
+        dx[n] = selfX - worldToTiles(atomic_load_explicit(&entityStore.posX[ids[i]], memory_order_relaxed));
+        dy[n] = selfY - worldToTiles(atomic_load_explicit(&entityStore.posY[ids[i]], memory_order_relaxed));
+        if (dx[n] == 0.0f && dy[n] == 0.0f) {
+            dx[n] = id > ids[i] ? 0.5f : -0.5f;
+        }
+        n++;
+    }
+    while (n & 3) {
+        dx[n] = 1e6f;
+        dy[n] = 0.0f;
+        n++;
+    }
+
+    __m128 pushX = _mm_setzero_ps();
+    __m128 pushY = _mm_setzero_ps();
+    for (int i = 0; i < n; i += 4) {
+        __m128 offX = _mm_load_ps(&dx[i]);
+        __m128 offY = _mm_load_ps(&dy[i]);
+        __m128 distanceSq = _mm_add_ps(_mm_mul_ps(offX, offX), _mm_mul_ps(offY, offY));
+        __m128 weight = _mm_div_ps(_mm_set1_ps(1.0f), distanceSq);  // Offset / distance^2
+        pushX = _mm_add_ps(pushX, _mm_mul_ps(offX, weight));
+        pushY = _mm_add_ps(pushY, _mm_mul_ps(offY, weight));
+    }
+
+    _Alignas(16) float sumX[4], sumY[4];
+    _mm_store_ps(sumX, pushX);
+    _mm_store_ps(sumY, pushY);
+    return (Push){ sumX[0] + sumX[1] + sumX[2] + sumX[3], sumY[0] + sumY[1] + sumY[2] + sumY[3] };
+}
+
+static bool isTileTaken(int x, int y, const Entity* entity) {
+    if (x == entity->reservedX && y == entity->reservedY) return false;
+    return planeTest(occupiedPlane, x, y) || tileReserved(x, y);
+}
+
+// A corridor or doorway tile: two or fewer walkable sides
+static bool isNarrow(int x, int y) {
+    uint32_t walkable = planeNeighbourhood(walkablePlane, x, y);
+    int sides = !!(walkable & NEIGHBOURHOOD_BIT(0, -1)) + !!(walkable & NEIGHBOURHOOD_BIT(-1, 0)) +
+                !!(walkable & NEIGHBOURHOOD_BIT(1, 0)) + !!(walkable & NEIGHBOURHOOD_BIT(0, 1));
+    return sides <= 2;
+}
+
+// Neighbouring tile to step onto, scored by how well it lines up with
+// `towards` (required to be positive when mustProgress) plus the weighted
+// push; -1 if no free neighbour qualifies
+static int pickStep(const Entity* entity, int gridX, int gridY, float towardsX, float towardsY,
+                    bool mustProgress, Push push, float pushWeight) {
+    uint32_t walkable = planeNeighbourhood(walkablePlane, gridX, gridY);
+    int best = -1;
+    float bestScore = 0.0f;
+
+    for (int d = 0; d < 8; d++) {
+        int x = gridX + stepX[d], y = gridY + stepY[d];
+        if (!(walkable & NEIGHBOURHOOD_BIT(stepX[d], stepY[d])) || isTileTaken(x, y, entity)) continue;
+
+        // Cutting a corner needs at least one of the two sides open, as in the move step
+        if (stepX[d] && stepY[d] &&
+            !(walkable & NEIGHBOURHOOD_BIT(stepX[d], 0)) && !(walkable & NEIGHBOURHOOD_BIT(0, stepY[d]))) {
+            continue;
+        }
+
+        float length = (stepX[d] && stepY[d]) ? 1.41421356f : 1.0f;
+        float progress = (stepX[d] * towardsX + stepY[d] * towardsY) / length;
+        if (mustProgress && progress <= 0.0f) continue;
+
+        float score = progress + pushWeight * (stepX[d] * push.x + stepY[d] * push.y) / length;
+        if (best < 0 || score > bestScore) {
+            best = d;
+            bestScore = score;
+        }
+    }
+    return best;
+}
+
+static void steerEntity(Entity* entity) {
+    int id = entity->id;
+    int gridX = atomic_load(&entity->gridX);
+    int gridY = atomic_load(&entity->gridY);
+    if (!isValid(gridX, gridY) || atomic_load(&entity->needsPathfinding)) return;
+
+    int targetGridX = atomic_load_explicit(&entityStore.targetGridX[id], memory_order_relaxed);
+    int targetGridY = atomic_load_explicit(&entityStore.targetGridY[id], memory_order_relaxed);
+
+    if (targetGridX == gridX && targetGridY == gridY) {
+        // Idle: only worth a look with someone on or right next to this tile
+        uint32_t around = planeNeighbourhood(occupiedPlane, gridX, gridY) & ~NEIGHBOURHOOD_BIT(0, 0);
+        if (!around && tileOccupants(gridX, gridY) < 2) return;
+
+        Push push = separationPush(id, gridX, gridY);
+        float strength = sqrtf(push.x * push.x + push.y * push.y);
+        if (strength < STEER_SEPARATION_MIN) return;
+
+        int d = pickStep(entity, gridX, gridY, push.x / strength, push.y / strength, true, push, 0.0f);
+        if (d < 0) return;
+        int x = gridX + stepX[d], y = gridY + stepY[d];
+        atomic_store(&entityStore.targetGridX[id], x);
+        atomic_store(&entityStore.targetGridY[id], y);
+        atomic_store(&entity->finalGoalX, x);
+        atomic_store(&entity->finalGoalY, y);
+        return;
+    }
+
+    // Moving: steer only when the next tile is taken, and queue where
+    // there is no room to pass
+    if (!isValid(targetGridX, targetGridY) || !isTileTaken(targetGridX, targetGridY, entity) ||
+        isNarrow(gridX, gridY) || isNarrow(targetGridX, targetGridY)) {
+        return;
+    }
+
+    Push push = separationPush(id, gridX, gridY);
+    int d = pickStep(entity, gridX, gridY, (float)(targetGridX - gridX), (float)(targetGridY - gridY),
+                     true, push, STEER_SEPARATION_WEIGHT);
+    if (d < 0) return;  // Boxed in: wait for the tile like before
+
+    // The path is picked up again from the sidestep tile on arrival
+    atomic_store(&entityStore.targetGridX[id], gridX + stepX[d]);
+    atomic_store(&entityStore.targetGridY[id], gridY + stepY[d]);
+}
+
+/*
+ * steerEntities
+ *
+ * Runs local steering for a batch of enemies before their move step.
+ * Touches only the given entities' targets and goals, so batches in
+ * different movement jobs can steer at the same time.
+ *
+ * @param[in,out] entities Entities to steer; the player is skipped
+ * @param[in] count Number of entities
+ */
+void steerEntities(Entity** entities, int count) {
+    for (int i = 0; i < count; i++) {
+        if (!entities[i]->isPlayer) {
+            steerEntity(entities[i]);
+        }
+    }
+}
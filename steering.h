@@ -0,0 +1,31 @@
+#ifndef STEERING_H
+#define STEERING_H
+
+#include "entity.h"
+
+// Local steering for enemies, between path following and the move step.
+// Paths are planned without regard for other entities; steering keeps
+// enemies from piling up along them:
+//
+//  - Separation: an idle enemy crowded by its neighbours steps onto the
+//    free neighbouring tile that the neighbours push it towards.
+//  - Avoidance: an enemy whose next tile is taken sidesteps onto a free
+//    neighbour that still brings it closer, rather than waiting for the
+//    tile or being blocked into a replan.
+//  - Queuing: at a corridor or door (a tile with two or fewer walkable
+//    sides) there is nothing to sidestep onto, so the enemy keeps its
+//    place and waits for the tile ahead to clear.
+//
+// Neighbours come from the spatial hash. Their push is an inverse-square
+// falloff of distance, accumulated four neighbours at a time. Steering only
+// rewrites an enemy's target tile (and, for separation, its goal), so it
+// runs in the movement jobs next to the enemy's move step.
+
+#define STEER_RADIUS 2              // Tiles around an enemy whose entities push it
+#define STEER_MAX_NEIGHBOURS 32
+#define STEER_SEPARATION_MIN 0.75f  // Push that makes an idle enemy move away
+#define STEER_SEPARATION_WEIGHT 0.5f  // Of the push against the path, when sidestepping
+
+void steerEntities(Entity** entities, int count);
+
+#endif // STEERING_H
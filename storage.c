@@ -4,6 +4,8 @@
 #include <stdlib.h>
 #include "structures.h"
 #include "grid.h"
+#include "grid_edit.h"
+#include "grid_summary.h"
 #include "player.h"
 #include "inventory.h"
 // Global storage manager (similar to enclosure manager pattern)
@@ -23,6 +25,7 @@ void initStorageManager(StorageManager* manager) {
     
     // Initialize the crates array
     memset(manager->crates, 0, manager->capacity * sizeof(CrateInventory));
+    chunkSummaryResetOpenCrates();  // Crates open in the previous game are gone
     
     printf("Storage manager initialized with capacity %zu\n", manager->capacity);
 }
@@ -120,7 +123,7 @@ void cleanupCrateContents(CrateInventory* crate) {
     // Reset crate state
     crate->totalItems = 0;
     crate->maxCapacity = 0;
-    crate->isOpen = false;
+    setCrateOpen(crate, false);
 }
 
 void removeCrateFromGrid(uint32_t crateId) {
@@ -129,9 +132,7 @@ void removeCrateFromGrid(uint32_t crateId) {
     
     if (gridX >= 0 && gridX < GRID_SIZE && 
         gridY >= 0 && gridY < GRID_SIZE) {
-        grid[gridY][gridX].structureType = STRUCTURE_NONE;
-        grid[gridY][gridX].materialType = MATERIAL_NONE;
-        GRIDCELL_SET_WALKABLE(grid[gridY][gridX], true);
+        gridClearStructure(gridX, gridY);
     }
 }
 
@@ -158,7 +159,7 @@ void cleanupStorageManager(StorageManager* manager) {
         // Close any open UI elements for this crate
         if (crate->isOpen) {
             // Clean up any UI resources
-            crate->isOpen = false;
+            setCrateOpen(crate, false);
         }
     }
     
@@ -171,6 +172,22 @@ void cleanupStorageManager(StorageManager* manager) {
     
     printf("Storage manager cleanup complete\n");
 }
+/*
+ * setCrateOpen
+ *
+ * Opens or closes a crate's UI, keeping the per-chunk open crate counts
+ * in step.
+ *
+ * @param[in,out] crate The crate
+ * @param[in] open New state
+ */
+void setCrateOpen(CrateInventory* crate, bool open) {
+    if (!crate || crate->isOpen == open) return;
+    crate->isOpen = open;
+    chunkSummaryAddOpenCrates((int)(crate->crateId % GRID_SIZE), (int)(crate->crateId / GRID_SIZE),
+                              open ? 1 : -1);
+}
+
 CrateInventory* findCrate(uint32_t crateId) {
     for (size_t i = 0; i < globalStorageManager.count; i++) {
         if (globalStorageManager.crates[i].crateId == crateId) {
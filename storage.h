@@ -37,6 +37,7 @@ bool isPlantMaterial(MaterialType type);
 // Crate operations
 CrateInventory* createCrate(int gridX, int gridY);
 CrateInventory* findCrate(uint32_t crateId);
+void setCrateOpen(CrateInventory* crate, bool open);
 bool canAddToCrate(CrateInventory* crate, MaterialType type, uint16_t amount);
 bool addToCrate(CrateInventory* crate, MaterialType type, uint16_t amount);
 uint16_t removeFromCrate(CrateInventory* crate, MaterialType type, uint16_t amount);
@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include <math.h>
 #include "grid.h"
+#include "grid_edit.h"
 #include "gameloop.h"
 #include "player.h"
 #include <stdint.h>
@@ -11,6 +12,8 @@
 #include "player.h"
 #include "inventory.h"
 #include "storage.h"
+#include "grid_planes.h"
+#include "world_timers.h"
 // Constants for texture coordinates from your existing system
 
 #define FNV_PRIME 1099511628211ULL
@@ -138,7 +141,7 @@ void updateWallTextures(int gridX, int gridY) {
     bool hasEast = (gridX < GRID_SIZE-1) && isWallOrDoor(gridX+1, gridY);
     bool hasWest = (gridX > 0) && isWallOrDoor(gridX-1, gridY);
 
-    TextureCoords* texCoords;
+    uint16_t texIndex;
     const char* textureId;
 
     if (hasEast && hasWest) {
@@ -170,25 +173,21 @@ void updateWallTextures(int gridX, int gridY) {
     printf("Wall at (%d,%d) - N:%d S:%d E:%d W:%d - Selected texture: %s\n",
            gridX, gridY, hasNorth, hasSouth, hasEast, hasWest, textureId);
 
-    texCoords = getTextureCoords(textureId);
-    if (!texCoords) {
+    texIndex = getTextureIndex(textureId);
+    if (texIndex == TEXTURE_INDEX_INVALID) {
         fprintf(stderr, "Failed to get texture coordinates for %s\n", textureId);
         return;
     }
 
-    grid[gridY][gridX].wallTexX = texCoords->u1;
-    grid[gridY][gridX].wallTexY = texCoords->v1;
+    gridSetTexIndex(gridX, gridY, texIndex);
 }
-bool isWithinBuildRange(float entityX, float entityY, int targetGridX, int targetGridY) {
-    float targetWorldX, targetWorldY;
-    WorldToScreenCoords(targetGridX, targetGridY, 0, 0, 1, &targetWorldX, &targetWorldY);
+bool isWithinBuildRange(WorldCoord entityX, WorldCoord entityY, int targetGridX, int targetGridY) {
+    int64_t dx = (int64_t)worldFromTile(targetGridX) - entityX;
+    int64_t dy = (int64_t)worldFromTile(targetGridY) - entityY;
 
-    float dx = targetWorldX - entityX;
-    float dy = targetWorldY - entityY;
-    float distance = sqrt(dx * dx + dy * dy);
-
-    // BUILD_RANGE is in world units, matching our continuous coordinate system
-    return distance <= (TILE_SIZE * 1.5f);  // 1.5 tiles reach
+    // Reach is measured from the target tile's centre
+    const int64_t reach = WORLD_ONE * 3 / 4;
+    return dx * dx + dy * dy <= reach * reach;
 }
 
 /**
@@ -215,6 +214,8 @@ void updateSurroundingStructures(int gridX, int gridY) {
     updateWallTextures(gridX, gridY);
 }
 
+static bool placeStructureCells(StructureType type, int gridX, int gridY, struct Player* player);
+
 /**
  * @brief Places a structure at the specified grid location.
  *
@@ -224,6 +225,14 @@ void updateSurroundingStructures(int gridX, int gridY) {
  * @return `true` if the structure was placed successfully; otherwise, `false`.
  */
 bool placeStructure(StructureType type, int gridX, int gridY, struct Player* player) {
+    // Placement also retextures neighbouring walls; publish it as one change
+    gridBeginBatch();
+    bool placed = placeStructureCells(type, gridX, gridY, player);
+    gridEndBatch();
+    return placed;
+}
+
+static bool placeStructureCells(StructureType type, int gridX, int gridY, struct Player* player) {
     if (!canPlaceStructure(type, gridX, gridY)) {
         return false;
     }
@@ -233,14 +242,13 @@ bool placeStructure(StructureType type, int gridX, int gridY, struct Player* pla
         return false;
     }
 
-    grid[gridY][gridX].structureType = type;
-    grid[gridY][gridX].materialType = MATERIAL_WOOD;
+    gridSetStructure(gridX, gridY, (uint8_t)type, MATERIAL_WOOD);
 
-    TextureCoords* texCoords;
+    uint16_t texIndex;
 
     switch(type) {
         case STRUCTURE_WALL: {
-            GRIDCELL_SET_WALKABLE(grid[gridY][gridX], false);
+            gridSetWalkable(gridX, gridY, false);
             
             // First update the placed wall based on its surroundings
             updateWallTextures(gridX, gridY);
@@ -272,26 +280,25 @@ bool placeStructure(StructureType type, int gridX, int gridY, struct Player* pla
         }
             
         case STRUCTURE_DOOR: {
-            GRIDCELL_SET_WALKABLE(grid[gridY][gridX], false);
+            gridSetWalkable(gridX, gridY, false);
             bool hasNorth = (gridY > 0) && isWallOrDoor(gridX, gridY-1);
             bool hasSouth = (gridY < GRID_SIZE-1) && isWallOrDoor(gridX, gridY+1);
 
             const char* textureId;
             if (hasNorth || hasSouth) {
-                GRIDCELL_SET_ORIENTATION(grid[gridY][gridX], 0);
+                gridSetOrientation(gridX, gridY, 0);
                 textureId = "door_vertical";
             } else {
-                GRIDCELL_SET_ORIENTATION(grid[gridY][gridX], 1);
+                gridSetOrientation(gridX, gridY, 1);
                 textureId = "door_horizontal";
             }
 
-            texCoords = getTextureCoords(textureId);
-            if (!texCoords) {
+            texIndex = getTextureIndex(textureId);
+            if (texIndex == TEXTURE_INDEX_INVALID) {
                 fprintf(stderr, "Failed to get door texture coordinates for %s\n", textureId);
                 return false;
             }
-            grid[gridY][gridX].wallTexX = texCoords->u1;
-            grid[gridY][gridX].wallTexY = texCoords->v1;
+            gridSetTexIndex(gridX, gridY, texIndex);
             
             // Update surrounding walls
             if (gridY > 0) updateWallTextures(gridX, gridY-1);
@@ -302,30 +309,29 @@ bool placeStructure(StructureType type, int gridX, int gridY, struct Player* pla
         }
 
         case STRUCTURE_PLANT:
-            GRIDCELL_SET_WALKABLE(grid[gridY][gridX], false);
+            gridSetWalkable(gridX, gridY, false);
             if ((float)rand() / RAND_MAX < 0.3f) {
-                grid[gridY][gridX].materialType = MATERIAL_TREE;
-                texCoords = getTextureCoords("tree_trunk");
+                gridSetMaterial(gridX, gridY, MATERIAL_TREE);
+                texIndex = getTextureIndex("tree_trunk");
             } else {
-                grid[gridY][gridX].materialType = MATERIAL_FERN;
-                texCoords = getTextureCoords("item_fern");
+                gridSetMaterial(gridX, gridY, MATERIAL_FERN);
+                texIndex = getTextureIndex("item_fern");
             }
 
-            if (!texCoords) {
+            if (texIndex == TEXTURE_INDEX_INVALID) {
                 fprintf(stderr, "Failed to get plant texture coordinates\n");
                 return false;
             }
-            grid[gridY][gridX].wallTexX = texCoords->u1;
-            grid[gridY][gridX].wallTexY = texCoords->v1;
+            gridSetTexIndex(gridX, gridY, texIndex);
             printf("Placed plant: structureType=%d, materialType=%d\n", 
                    grid[gridY][gridX].structureType, 
                    grid[gridY][gridX].materialType);
             return true;
 
         case STRUCTURE_CRATE:
-            GRIDCELL_SET_WALKABLE(grid[gridY][gridX], false);
-            texCoords = getTextureCoords("item_plant_crate");
-            if (!texCoords) {
+            gridSetWalkable(gridX, gridY, false);
+            texIndex = getTextureIndex("item_plant_crate");
+            if (texIndex == TEXTURE_INDEX_INVALID) {
                 fprintf(stderr, "Failed to get crate texture coordinates\n");
                 return false;
             }
@@ -336,8 +342,7 @@ bool placeStructure(StructureType type, int gridX, int gridY, struct Player* pla
                 return false;
             }
             
-            grid[gridY][gridX].wallTexX = texCoords->u1;
-            grid[gridY][gridX].wallTexY = texCoords->v1;
+            gridSetTexIndex(gridX, gridY, texIndex);
             printf("Placed storage crate at (%d, %d)\n", gridX, gridY);
             return true;
 
@@ -437,26 +442,18 @@ void cycleStructureType(PlacementMode* mode, bool forward) {
 }
 
 /**
- * @brief Checks if any entity is targeting a specific tile.
+ * @brief Checks if any entity is on a specific tile or about to step onto it.
+ *
+ * Entities reserve the tile of their next step before moving (see
+ * grid_planes.h), so this is two bit lookups rather than a neighbour scan.
  *
  * @param gridX The X-coordinate of the tile.
  * @param gridY The Y-coordinate of the tile.
  * @return `true` if an entity is targeting the tile; otherwise, `false`.
  */
 bool isEntityTargetingTile(int gridX, int gridY) {
-    for (int i = 0; i < MAX_ENTITIES; i++) {
-        if (allEntities[i]) {
-            // Check if entity is currently on the tile
-            if (allEntities[i]->gridX == gridX && allEntities[i]->gridY == gridY) {
-                return true;
-            }
-            // Check if entity's next movement target is the tile
-            if (allEntities[i]->targetGridX == gridX && allEntities[i]->targetGridY == gridY) {
-                return true;
-            }
-        }
-    }
-    return false;
+    if (!isValid(gridX, gridY)) return false;
+    return planeTest(occupiedPlane, gridX, gridY) || tileReserved(gridX, gridY);
 }
 
 /**
@@ -480,10 +477,11 @@ AdjacentTile findNearestAdjacentTile(int targetX, int targetY, int fromX, int fr
             int checkX = targetX + dx;
             int checkY = targetY + dy;
             
-            // Ensure tile is in bounds and meets walkability requirement
+            // Ensure tile is in bounds and meets walkability requirement; the
+            // walkable plane is safe to read from the input thread too
             if (checkX >= 0 && checkX < GRID_SIZE && 
                 checkY >= 0 && checkY < GRID_SIZE && 
-                (!requireWalkable || GRIDCELL_IS_WALKABLE(grid[checkY][checkX]))) {
+                (!requireWalkable || isWalkable(checkX, checkY))) {
                 
                 float dist = sqrtf(powf(fromX - checkX, 2) + 
                                  powf(fromY - checkY, 2));
@@ -500,9 +498,37 @@ AdjacentTile findNearestAdjacentTile(int targetX, int targetY, int fromX, int fr
     return result;
 }
 
+/**
+ * @brief Opens or closes a door.
+ *
+ * @param gridX The X-coordinate of the door.
+ * @param gridY The Y-coordinate of the door.
+ * @param open `true` to open the door, `false` to close it.
+ * @return `true` if the door is now in that state; otherwise, `false`.
+ */
+bool setDoorOpen(int gridX, int gridY, bool open) {
+    if (!isValid(gridX, gridY) || grid[gridY][gridX].structureType != STRUCTURE_DOOR) return false;
+
+    // Get appropriate texture coordinates based on new state
+    const char* textureId = open ? "door_horizontal_open" : "door_horizontal";
+    uint16_t texIndex = getTextureIndex(textureId);
+    if (texIndex == TEXTURE_INDEX_INVALID) {
+        fprintf(stderr, "Failed to get texture coordinates for %s\n", textureId);
+        return false;
+    }
+
+    gridBeginBatch();
+    gridSetWalkable(gridX, gridY, open);
+    gridSetTexIndex(gridX, gridY, texIndex);
+    gridEndBatch();
+    return true;
+}
+
 /**
  * @brief Toggles the open or closed state of a door.
  *
+ * A door opened here closes by itself after DOOR_CLOSE_MS.
+ *
  * @param gridX The X-coordinate of the door.
  * @param gridY The Y-coordinate of the door.
  * @param player A pointer to the player interacting with the door.
@@ -518,23 +544,14 @@ bool toggleDoor(int gridX, int gridY, Player* player) {
     );
 
     if (isNearby) {
-        // Toggle door walkability
-        bool currentlyOpen = GRIDCELL_IS_WALKABLE(grid[gridY][gridX]);
-        GRIDCELL_SET_WALKABLE(grid[gridY][gridX], !currentlyOpen);
-        
-        // Get appropriate texture coordinates based on new state
-        TextureCoords* texCoords;
-        const char* textureId = currentlyOpen ? "door_horizontal" : "door_horizontal_open";
+        bool open = !GRIDCELL_IS_WALKABLE(grid[gridY][gridX]);
+        if (!setDoorOpen(gridX, gridY, open)) return false;
 
-        texCoords = getTextureCoords(textureId);
-        if (!texCoords) {
-            fprintf(stderr, "Failed to get texture coordinates for %s\n", textureId);
-            return false;
+        if (open) {
+            scheduleDoorClose(gridX, gridY, DOOR_CLOSE_MS);
+        } else {
+            cancelDoorClose(gridX, gridY);
         }
-
-        grid[gridY][gridX].wallTexX = texCoords->u1;
-        grid[gridY][gridX].wallTexY = texCoords->v1;
-        
         return true;
     } else {
         // Path to nearest door-adjacent tile if not nearby
@@ -545,8 +562,8 @@ bool toggleDoor(int gridX, int gridY, Player* player) {
         if (nearest.x != -1) {
             player->entity.finalGoalX = nearest.x;
             player->entity.finalGoalY = nearest.y;
-            player->entity.targetGridX = player->entity.gridX;
-            player->entity.targetGridY = player->entity.gridY;
+            entityStore.targetGridX[player->entity.id] = player->entity.gridX;
+            entityStore.targetGridY[player->entity.id] = player->entity.gridY;
             player->entity.needsPathfinding = true;
             return true;
         }
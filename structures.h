@@ -55,7 +55,7 @@ EnclosureData* findEnclosure(EnclosureManager* manager, uint64_t hash);
 void removeEnclosure(EnclosureManager* manager, uint64_t hash);
 void cleanupEnclosureManager(EnclosureManager* manager);
 extern EnclosureManager globalEnclosureManager; 
-bool isWithinBuildRange(float entityX, float entityY, int targetGridX, int targetGridY);
+bool isWithinBuildRange(WorldCoord entityX, WorldCoord entityY, int targetGridX, int targetGridY);
 struct Player;  // Forward declaration
 void cycleStructureType(PlacementMode* mode, bool forward);
 void initializeStructureSystem(void);
@@ -66,6 +66,7 @@ const char* getStructureName(StructureType type);
 void cleanupStructureSystem(void);
 bool isEntityTargetingTile(int gridX, int gridY);
 AdjacentTile findNearestAdjacentTile(int targetX, int targetY, int fromX, int fromY, bool requireWalkable);
+bool setDoorOpen(int gridX, int gridY, bool open);
 bool toggleDoor(int gridX, int gridY, struct Player* player);
 bool isWallOrDoor(int x, int y);
 Enclosure detectEnclosure(int startX, int startY);
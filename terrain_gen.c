@@ -0,0 +1,152 @@
+// terrain_gen.c
+
+#include "terrain_gen.h"
+#include "noise.h"
+#include "worker_pool.h"
+
+// Feature sizes in tiles^-1; height varies slowest so biomes form regions
+#define HEIGHT_SCALE 0.045f
+#define MOISTURE_SCALE 0.06f
+#define DETAIL_SCALE 0.21f
+
+#define HEIGHT_OCTAVES 4
+#define MOISTURE_OCTAVES 3
+#define DETAIL_OCTAVES 2
+#define FIELD_PERSISTENCE 0.5f
+
+// fBm of gradient noise rarely leaves [-0.6, 0.6]; stretch it over [0, 1]
+#define FIELD_CONTRAST 1.6f
+
+// Layer ids; each field gets an independent seed
+enum {
+    LAYER_HEIGHT = 1,
+    LAYER_MOISTURE,
+    LAYER_DETAIL,
+    LAYER_VARIATION
+};
+
+static inline uint32_t layerSeed(uint32_t seed, uint32_t layer) {
+    return noiseHash2D(seed, (int32_t)layer, 0x4C41594E);
+}
+
+static inline float remapField(float n) {
+    float v = 0.5f + 0.5f * n * FIELD_CONTRAST;
+    if (v < 0.0f) return 0.0f;
+    if (v > 1.0f) return 1.0f;
+    return v;
+}
+
+/*
+ * classifyBiome
+ *
+ * Returns the first biome in biomeData whose height and moisture bands
+ * contain the sample.
+ *
+ * @param[in] height Normalized height (0-1)
+ * @param[in] moisture Normalized moisture (0-1)
+ * @return BiomeType The matching biome, BIOME_PLAINS if none match
+ */
+BiomeType classifyBiome(float height, float moisture) {
+    for (int b = 0; b < BIOME_COUNT; b++) {
+        const BiomeData* data = &biomeData[b];
+        if (height >= data->minHeight && height < data->maxHeight &&
+            moisture >= data->minMoisture && moisture < data->maxMoisture) {
+            return (BiomeType)b;
+        }
+    }
+    return BIOME_PLAINS;
+}
+
+/*
+ * biomeTerrainAt
+ *
+ * Picks one of the biome's three terrain types using its detail thresholds:
+ * terrainTypes[2] above heightThresholds[0], terrainTypes[1] above
+ * heightThresholds[1], terrainTypes[0] otherwise.
+ *
+ * @param[in] biome The biome
+ * @param[in] detail Normalized detail noise (0-1)
+ * @return TerrainType The terrain for this tile
+ */
+TerrainType biomeTerrainAt(BiomeType biome, float detail) {
+    const BiomeData* data = &biomeData[biome];
+    if (detail >= data->heightThresholds[0]) return data->terrainTypes[2];
+    if (detail >= data->heightThresholds[1]) return data->terrainTypes[1];
+    return data->terrainTypes[0];
+}
+
+/*
+ * generateChunkTerrain
+ *
+ * Fills a chunk from the world noise fields. Each row of each field is
+ * evaluated with one call to the vectorized fBm row kernel.
+ *
+ * @param[in] seed World seed
+ * @param[in] chunkX Chunk column
+ * @param[in] chunkY Chunk row
+ * @param[out] chunk The chunk to fill
+ */
+void generateChunkTerrain(uint32_t seed, int chunkX, int chunkY, Chunk* chunk) {
+    const uint32_t heightSeed = layerSeed(seed, LAYER_HEIGHT);
+    const uint32_t moistureSeed = layerSeed(seed, LAYER_MOISTURE);
+    const uint32_t detailSeed = layerSeed(seed, LAYER_DETAIL);
+    const uint32_t variationSeed = layerSeed(seed, LAYER_VARIATION);
+
+    float height[CHUNK_SIZE];
+    float moisture[CHUNK_SIZE];
+    float detail[CHUNK_SIZE];
+
+    chunk->chunkX = chunkX;
+    chunk->chunkY = chunkY;
+    chunk->isLoaded = true;
+
+    const int originX = chunkX * CHUNK_SIZE;
+    const int originY = chunkY * CHUNK_SIZE;
+
+    for (int y = 0; y < CHUNK_SIZE; y++) {
+        int mapY = originY + y;
+
+        noiseFbmRow(heightSeed, originX * HEIGHT_SCALE, mapY * HEIGHT_SCALE, HEIGHT_SCALE,
+                    CHUNK_SIZE, FIELD_PERSISTENCE, HEIGHT_OCTAVES, height);
+        noiseFbmRow(moistureSeed, originX * MOISTURE_SCALE, mapY * MOISTURE_SCALE, MOISTURE_SCALE,
+                    CHUNK_SIZE, FIELD_PERSISTENCE, MOISTURE_OCTAVES, moisture);
+        noiseFbmRow(detailSeed, originX * DETAIL_SCALE, mapY * DETAIL_SCALE, DETAIL_SCALE,
+                    CHUNK_SIZE, FIELD_PERSISTENCE, DETAIL_OCTAVES, detail);
+
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            int mapX = originX + x;
+            GridCell* cell = &CHUNK_CELL(chunk, x, y);
+
+            BiomeType biome = classifyBiome(remapField(height[x]), remapField(moisture[x]));
+            TerrainType terrain = biomeTerrainAt(biome, remapField(detail[x]));
+            uint32_t bits = noiseHash2D(variationSeed, mapX, mapY);
+
+            cell->flags = 0;
+            cell->terrainType = (uint8_t)terrain;
+            cell->biomeType = (uint8_t)biome;
+            cell->structureType = 0;
+            cell->materialType = 0;
+            cell->texIndex = 0;
+
+            GRIDCELL_SET_WALKABLE(*cell, terrain != TERRAIN_WATER);
+            GRIDCELL_SET_TERRAIN_VARIATION(*cell, (uint16_t)(bits & 3));
+            GRIDCELL_SET_TERRAIN_ROTATION(*cell, (uint16_t)((bits >> 2) & 3));
+        }
+    }
+}
+
+typedef struct {
+    uint32_t seed;
+    const ChunkCoord* coords;
+    Chunk** chunks;
+} ChunkGenJob;
+
+static void generateChunkJob(void* context, int index) {
+    ChunkGenJob* job = (ChunkGenJob*)context;
+    generateChunkTerrain(job->seed, job->coords[index].x, job->coords[index].y, job->chunks[index]);
+}
+
+void generateChunksParallel(uint32_t seed, const ChunkCoord* coords, Chunk** chunks, int count) {
+    ChunkGenJob job = { seed, coords, chunks };
+    workerPoolRun(&globalWorkerPool, generateChunkJob, &job, count);
+}
@@ -0,0 +1,22 @@
+#ifndef TERRAIN_GEN_H
+#define TERRAIN_GEN_H
+
+#include <stdint.h>
+#include "grid.h"
+
+// Procedural terrain. A chunk's contents are a pure function of
+// (seed, chunkX, chunkY): height and moisture fields pick a biome from
+// biomeData, a detail field picks the biome's terrain, and hashes of the
+// tile coordinates pick variation and rotation. Unmodified chunks can
+// therefore be regenerated on demand instead of being stored.
+
+// Height/moisture/detail are remapped to [0, 1]
+BiomeType classifyBiome(float height, float moisture);
+TerrainType biomeTerrainAt(BiomeType biome, float detail);
+
+void generateChunkTerrain(uint32_t seed, int chunkX, int chunkY, Chunk* chunk);
+
+// Generates chunks[i] for coords[i] on the global worker pool
+void generateChunksParallel(uint32_t seed, const ChunkCoord* coords, Chunk** chunks, int count);
+
+#endif // TERRAIN_GEN_H
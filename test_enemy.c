@@ -29,15 +29,15 @@ void CleanupEnemy(Enemy* enemy) {
 // Test functions
 void test_InitEnemy() {
     Enemy enemy;
-    InitEnemy(&enemy, 2, 2, 0.5f);
+    InitEnemy(&enemy, 1, 2, 2, 0.5f);
     
     assert(enemy.entity.gridX == 2);
     assert(enemy.entity.gridY == 2);
-    assert(enemy.entity.speed == 0.5f);
-    assert(enemy.entity.posX == (2.0f * 2 / GRID_SIZE) - 1.0f + (1.0f / GRID_SIZE));
-    assert(enemy.entity.posY == 1.0f - (2.0f * 2 / GRID_SIZE) - (1.0f / GRID_SIZE));
-    assert(enemy.entity.targetGridX == 2);
-    assert(enemy.entity.targetGridY == 2);
+    assert(entityStore.speed[enemy.entity.id] == WORLD_ONE / 2);
+    assert(entityStore.posX[enemy.entity.id] == 2 * WORLD_ONE + WORLD_HALF);
+    assert(entityStore.posY[enemy.entity.id] == 2 * WORLD_ONE + WORLD_HALF);
+    assert(entityStore.targetGridX[enemy.entity.id] == 2);
+    assert(entityStore.targetGridY[enemy.entity.id] == 2);
     assert(enemy.entity.finalGoalX == 2);
     assert(enemy.entity.finalGoalY == 2);
     assert(enemy.entity.needsPathfinding == false);
@@ -51,15 +51,15 @@ void test_InitEnemy() {
 
 void test_MovementAI() {
     Enemy enemy;
-    InitEnemy(&enemy, 2, 2, 0.5f);
+    InitEnemy(&enemy, 1, 2, 2, 0.5f);
     
     // Test that MovementAI changes the target occasionally
-    int initialTargetX = enemy.entity.targetGridX;
-    int initialTargetY = enemy.entity.targetGridY;
+    int initialTargetX = entityStore.targetGridX[enemy.entity.id];
+    int initialTargetY = entityStore.targetGridY[enemy.entity.id];
     
     for (int i = 0; i < 1000; i++) {
         MovementAI(&enemy);
-        if (enemy.entity.targetGridX != initialTargetX || enemy.entity.targetGridY != initialTargetY) {
+        if (entityStore.targetGridX[enemy.entity.id] != initialTargetX || entityStore.targetGridY[enemy.entity.id] != initialTargetY) {
             printf("test_MovementAI passed\n");
             return;
         }
@@ -70,17 +70,17 @@ void test_MovementAI() {
 
 void test_UpdateEnemy() {
     Enemy enemy;
-    InitEnemy(&enemy, 2, 2, 0.5f);
+    InitEnemy(&enemy, 1, 2, 2, 0.5f);
     
     Entity* allEntities[1] = {&enemy.entity};
     
     // Test that UpdateEnemy calls MovementAI and updates the enemy's position
-    float initialPosX = enemy.entity.posX;
-    float initialPosY = enemy.entity.posY;
+    WorldCoord initialPosX = entityStore.posX[enemy.entity.id];
+    WorldCoord initialPosY = entityStore.posY[enemy.entity.id];
     
     for (int i = 0; i < 100; i++) {
         UpdateEnemy(&enemy, allEntities, 1);
-        if (enemy.entity.posX != initialPosX || enemy.entity.posY != initialPosY) {
+        if (entityStore.posX[enemy.entity.id] != initialPosX || entityStore.posY[enemy.entity.id] != initialPosY) {
             printf("test_UpdateEnemy passed\n");
             return;
         }
@@ -91,7 +91,7 @@ void test_UpdateEnemy() {
 
 void test_CleanupEnemy() {
     Enemy enemy;
-    InitEnemy(&enemy, 2, 2, 0.5f);
+    InitEnemy(&enemy, 1, 2, 2, 0.5f);
     
     // Allocate some memory for cachedPath
     enemy.entity.cachedPath = malloc(sizeof(Node) * 10);
@@ -107,7 +107,7 @@ void test_CleanupEnemy() {
 
 void test_EnemyPathfinding() {
     Enemy enemy;
-    InitEnemy(&enemy, 2, 2, 0.5f);
+    InitEnemy(&enemy, 1, 2, 2, 0.5f);
     
     enemy.entity.finalGoalX = 4;
     enemy.entity.finalGoalY = 4;
@@ -117,8 +117,8 @@ void test_EnemyPathfinding() {
 
     assert(enemy.entity.cachedPath != NULL);
     assert(enemy.entity.cachedPathLength > 0);
-    assert(enemy.entity.targetGridX == 4);
-    assert(enemy.entity.targetGridY == 4);
+    assert(entityStore.targetGridX[enemy.entity.id] == 4);
+    assert(entityStore.targetGridY[enemy.entity.id] == 4);
 
     printf("test_EnemyPathfinding passed\n");
 }
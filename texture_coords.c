@@ -87,6 +87,7 @@ bool registerTexture(const char* id, int atlasX, int atlasY) {
 
     newEntry->key = strdup(id);
     newEntry->value = calculateUVs(atlasX, atlasY);
+    newEntry->index = TEXTURE_INDEX(atlasX, atlasY);
     newEntry->next = gTextureManager->table[hash];
     gTextureManager->table[hash] = newEntry;
 
@@ -119,6 +120,63 @@ TextureCoords* getTextureCoords(const char* id) {
     return NULL;
 }
 
+/*
+ * getTextureIndex
+ *
+ * Looks up the atlas tile index of a registered texture.
+ *
+ * @param[in] id Texture id
+ * @return uint16_t Atlas index, or TEXTURE_INDEX_INVALID if unknown
+ */
+uint16_t getTextureIndex(const char* id) {
+    if (!gTextureManager || !id) return TEXTURE_INDEX_INVALID;
+
+    unsigned int hash = hashString(id) % gTextureManager->size;
+    TextureHashEntry* entry = gTextureManager->table[hash];
+
+    while (entry) {
+        if (strcmp(entry->key, id) == 0) {
+            return entry->index;
+        }
+        entry = entry->next;
+    }
+
+    lastTextureError = TEXTURE_NOT_FOUND;
+    return TEXTURE_INDEX_INVALID;
+}
+
+/*
+ * textureCoordsFromIndex
+ *
+ * Expands an atlas tile index back into UVs.
+ *
+ * @param[in] index Atlas tile index
+ * @return TextureCoords UVs of the tile
+ */
+TextureCoords textureCoordsFromIndex(uint16_t index) {
+    return calculateUVs(TEXTURE_INDEX_COL(index), TEXTURE_INDEX_ROW(index));
+}
+
+/*
+ * textureIndexFromUV
+ *
+ * Converts a tile's top-left UV into its atlas index. Used to migrate data
+ * that stored UVs directly.
+ *
+ * @param[in] u Left edge
+ * @param[in] v Top edge
+ * @return uint16_t Atlas index, or TEXTURE_INDEX_INVALID if out of range
+ */
+uint16_t textureIndexFromUV(float u, float v) {
+    int col = (int)(u * ATLAS_COLS + 0.5f);
+    int row = (int)(v * ATLAS_ROWS + 0.5f);
+    if (col < 0 || col >= ATLAS_COLS || row < 0 || row >= ATLAS_ROWS) {
+        lastTextureError = TEXTURE_INVALID_COORDS;
+        return TEXTURE_INDEX_INVALID;
+    }
+    return TEXTURE_INDEX(col, row);
+}
+
 void resizeTextureManager(int newSize) {
     TextureHashEntry** newTable = calloc(newSize, sizeof(TextureHashEntry*));
     if (!newTable) {
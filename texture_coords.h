@@ -7,6 +7,12 @@
 #define ATLAS_COLS 64
 #define ATLAS_ROWS 64
 
+// Atlas tile index: row * ATLAS_COLS + col. Grid cells store this instead of UVs.
+#define TEXTURE_INDEX_INVALID 0xFFFF
+#define TEXTURE_INDEX(atlasX, atlasY) ((uint16_t)((atlasY) * ATLAS_COLS + (atlasX)))
+#define TEXTURE_INDEX_COL(index) ((index) % ATLAS_COLS)
+#define TEXTURE_INDEX_ROW(index) ((index) / ATLAS_COLS)
+
 // Basic UV coordinate structure
 typedef struct {
     float u1, v1;  // Top-left UV coordinates
@@ -24,6 +30,7 @@ typedef struct {
 typedef struct TextureHashEntry {
     const char* key;
     TextureCoords value;
+    uint16_t index;           // Atlas tile index of value
     struct TextureHashEntry* next;
 } TextureHashEntry;
 
@@ -42,6 +49,9 @@ void initTextureManager(int initialSize);
 void cleanupTextureManager(void);
 bool registerTexture(const char* id, int atlasX, int atlasY);
 TextureCoords* getTextureCoords(const char* id);
+uint16_t getTextureIndex(const char* id);
+TextureCoords textureCoordsFromIndex(uint16_t index);
+uint16_t textureIndexFromUV(float u, float v);
 
 // Utility functions
 void dumpTextureRegistry(void);  // For debugging
@@ -0,0 +1,184 @@
+// timer_wheel.c
+#include "timer_wheel.h"
+#include <stdio.h>
+
+#define SLOT_MASK (TIMER_WHEEL_SLOTS - 1)
+#define INDEX_MASK 0xFFFFu
+
+static inline TimerHandle makeHandle(int index, uint16_t generation) {
+    return (TimerHandle)generation << 16 | (TimerHandle)(index + 1);
+}
+
+static void linkTimer(TimerWheel* wheel, int index) {
+    Timer* timer = &wheel->timers[index];
+    uint64_t delta = timer->expires - wheel->now;
+
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= (uint64_t)1 << (TIMER_WHEEL_BITS * (level + 1))) {
+        level++;
+    }
+    int slot = (int)((timer->expires >> (TIMER_WHEEL_BITS * level)) & SLOT_MASK);
+
+    int* head = &wheel->slots[level][slot];
+    timer->level = (uint8_t)level;
+    timer->slot = (uint8_t)slot;
+    timer->prev = -1;
+    timer->next = *head;
+    if (*head >= 0) wheel->timers[*head].prev = index;
+    *head = index;
+}
+
+static void unlinkTimer(TimerWheel* wheel, int index) {
+    Timer* timer = &wheel->timers[index];
+    if (timer->prev >= 0) {
+        wheel->timers[timer->prev].next = timer->next;
+    } else {
+        wheel->slots[timer->level][timer->slot] = timer->next;
+    }
+    if (timer->next >= 0) wheel->timers[timer->next].prev = timer->prev;
+}
+
+static void freeTimer(TimerWheel* wheel, int index) {
+    Timer* timer = &wheel->timers[index];
+    timer->armed = false;
+    timer->generation = (uint16_t)(timer->generation + 1) ? (uint16_t)(timer->generation + 1) : 1;
+    timer->next = wheel->freeHead;
+    wheel->freeHead = index;
+    wheel->armedCount--;
+}
+
+/*
+ * initTimerWheel
+ *
+ * Empties the wheel and sets its clock to 0. Handles from before stop
+ * resolving.
+ *
+ * @param[out] wheel Wheel to initialize
+ */
+void initTimerWheel(TimerWheel* wheel) {
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (int slot = 0; slot < TIMER_WHEEL_SLOTS; slot++) {
+            wheel->slots[level][slot] = -1;
+        }
+    }
+    wheel->freeHead = -1;
+    for (int i = TIMER_CAPACITY - 1; i >= 0; i--) {
+        Timer* timer = &wheel->timers[i];
+        timer->generation = (uint16_t)(timer->generation + 1) ? (uint16_t)(timer->generation + 1) : 1;
+        timer->armed = false;
+        timer->next = wheel->freeHead;
+        wheel->freeHead = i;
+    }
+    wheel->armedCount = 0;
+    wheel->now = 0;
+}
+
+/*
+ * timerSchedule
+ *
+ * Arms a timer.
+ *
+ * @param[in,out] wheel The wheel
+ * @param[in] event Passed to the fire callback
+ * @param[in] delay Ticks from now, at least 1; clamped to TIMER_MAX_DELAY
+ * @return TimerHandle Handle for timerCancel, or TIMER_HANDLE_NONE if the
+ *                     pool is full
+ */
+TimerHandle timerSchedule(TimerWheel* wheel, const TimerEvent* event, uint32_t delay) {
+    int index = wheel->freeHead;
+    if (index < 0) {
+        fprintf(stderr, "Timer pool is full (%d timers)\n", TIMER_CAPACITY);
+        return TIMER_HANDLE_NONE;
+    }
+    if (delay < 1) delay = 1;
+    if (delay > TIMER_MAX_DELAY) delay = TIMER_MAX_DELAY;
+
+    Timer* timer = &wheel->timers[index];
+    wheel->freeHead = timer->next;
+    timer->event = *event;
+    timer->expires = wheel->now + delay;
+    timer->armed = true;
+    wheel->armedCount++;
+    linkTimer(wheel, index);
+    return makeHandle(index, timer->generation);
+}
+
+/*
+ * timerCancel
+ *
+ * Disarms a timer before it fires.
+ *
+ * @param[in,out] wheel The wheel
+ * @param[in] handle Timer to cancel
+ * @return bool False if it already fired or was cancelled
+ */
+bool timerCancel(TimerWheel* wheel, TimerHandle handle) {
+    int index = (int)(handle & INDEX_MASK) - 1;
+    if (index < 0 || index >= TIMER_CAPACITY) return false;
+
+    Timer* timer = &wheel->timers[index];
+    if (!timer->armed || makeHandle(index, timer->generation) != handle) return false;
+
+    unlinkTimer(wheel, index);
+    freeTimer(wheel, index);
+    return true;
+}
+
+// Handle of an armed pool entry, or TIMER_HANDLE_NONE, for walking the pool
+TimerHandle timerHandleAt(const TimerWheel* wheel, int index) {
+    const Timer* timer = &wheel->timers[index];
+    return timer->armed ? makeHandle(index, timer->generation) : TIMER_HANDLE_NONE;
+}
+
+// Ticks until an armed pool entry fires, for saving the wheel
+uint32_t timerRemaining(const TimerWheel* wheel, int index) {
+    const Timer* timer = &wheel->timers[index];
+    return timer->armed ? (uint32_t)(timer->expires - wheel->now) : 0;
+}
+
+// Re-files every timer of one slot against the current time; they all land
+// on lower levels
+static void cascade(TimerWheel* wheel, int level) {
+    int slot = (int)((wheel->now >> (TIMER_WHEEL_BITS * level)) & SLOT_MASK);
+    int index = wheel->slots[level][slot];
+    wheel->slots[level][slot] = -1;
+    while (index >= 0) {
+        int next = wheel->timers[index].next;
+        linkTimer(wheel, index);
+        index = next;
+    }
+}
+
+/*
+ * timerAdvance
+ *
+ * Advances the wheel by one tick and fires the timers due on it. The
+ * callback may schedule and cancel timers, including new ones for this
+ * same wheel; those fire on later ticks.
+ *
+ * @param[in,out] wheel The wheel
+ * @param[in] fire Called once per due timer, after it is disarmed
+ * @param[in] context Passed to fire
+ * @return int Number of timers fired
+ */
+int timerAdvance(TimerWheel* wheel, TimerFn fire, void* context) {
+    wheel->now++;
+    for (int level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+        if (wheel->now & (((uint64_t)1 << (TIMER_WHEEL_BITS * level)) - 1)) break;
+        cascade(wheel, level);
+    }
+
+    // Pop one timer at a time so the callback can cancel others due on this
+    // tick; timers it schedules land on later slots
+    int slot = (int)(wheel->now & SLOT_MASK);
+    int fired = 0;
+    int index;
+    while ((index = wheel->slots[0][slot]) >= 0) {
+        TimerEvent event = wheel->timers[index].event;
+        unlinkTimer(wheel, index);
+        freeTimer(wheel, index);
+        fire(&event, context);
+        fired++;
+    }
+    return fired;
+}
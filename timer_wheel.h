@@ -0,0 +1,67 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Hierarchical timing wheel. Time advances in whole ticks. Level 0 has one
+// slot per tick for the next TIMER_WHEEL_SLOTS ticks; each level above
+// covers TIMER_WHEEL_SLOTS times the span of the one below, one slot per
+// span of the level below. A timer is filed by how far away it is; when
+// level 0 wraps, the next slot of level 1 is cascaded down (and so on up),
+// so each timer is moved at most once per level before it fires.
+//
+// Timers live in a fixed pool and sit on intrusive doubly linked slot
+// lists, so scheduling, cancelling and firing one are O(1). Handles carry
+// a generation, like entity handles: cancelling a timer that already fired
+// does nothing.
+//
+// Not thread safe; a wheel belongs to one thread.
+
+#define TIMER_WHEEL_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_LEVELS 4
+#define TIMER_MAX_DELAY ((1u << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1)  // Ticks
+#define TIMER_CAPACITY 65535  // Largest pool the handles can index
+
+typedef uint32_t TimerHandle;
+
+#define TIMER_HANDLE_NONE 0u
+
+_Static_assert(TIMER_CAPACITY < (1 << 16), "Timer indices must fit the handle");
+
+// What happens when a timer fires; the meaning of the fields is up to the
+// wheel's owner
+typedef struct {
+    int type;
+    int x, y;
+    uint32_t arg;
+} TimerEvent;
+
+typedef struct {
+    TimerEvent event;
+    uint64_t expires;     // Tick the timer fires on
+    int next, prev;       // Slot list links; next also links the free list
+    uint16_t generation;
+    uint8_t level, slot;  // List the timer is on
+    bool armed;
+} Timer;
+
+typedef struct {
+    Timer timers[TIMER_CAPACITY];
+    int slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];  // List heads, -1 if empty
+    int freeHead;
+    int armedCount;
+    uint64_t now;         // Ticks advanced so far
+} TimerWheel;
+
+typedef void (*TimerFn)(const TimerEvent* event, void* context);
+
+void initTimerWheel(TimerWheel* wheel);
+TimerHandle timerSchedule(TimerWheel* wheel, const TimerEvent* event, uint32_t delay);
+bool timerCancel(TimerWheel* wheel, TimerHandle handle);
+TimerHandle timerHandleAt(const TimerWheel* wheel, int index);
+uint32_t timerRemaining(const TimerWheel* wheel, int index);
+int timerAdvance(TimerWheel* wheel, TimerFn fire, void* context);
+
+#endif // TIMER_WHEEL_H
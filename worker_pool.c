@@ -0,0 +1,195 @@
+// worker_pool.c
+#include "worker_pool.h"
+#include <stdio.h>
+#include <string.h>
+
+WorkerPool globalWorkerPool;
+
+// Pulls job indices until the run is exhausted
+static void drainJobs(WorkerPool* pool, WorkerJobFn job, void* context, int jobCount) {
+    int index;
+    while ((index = atomic_fetch_add(&pool->nextJob, 1)) < jobCount) {
+        job(context, index);
+        atomic_fetch_sub(&pool->jobsRemaining, 1);
+    }
+}
+
+static int workerThreadMain(void* arg) {
+    WorkerPool* pool = (WorkerPool*)arg;
+    unsigned int seenGeneration = 0;
+
+    SDL_LockMutex(pool->mutex);
+    for (;;) {
+        while (!pool->shuttingDown && pool->generation == seenGeneration) {
+            SDL_CondWait(pool->workReady, pool->mutex);
+        }
+        if (pool->shuttingDown) {
+            break;
+        }
+
+        seenGeneration = pool->generation;
+        WorkerJobFn job = pool->job;
+        void* context = pool->context;
+        int jobCount = pool->jobCount;
+        pool->activeWorkers++;
+        SDL_UnlockMutex(pool->mutex);
+
+        drainJobs(pool, job, context, jobCount);
+
+        SDL_LockMutex(pool->mutex);
+        pool->activeWorkers--;
+        SDL_CondBroadcast(pool->workDone);
+    }
+    SDL_UnlockMutex(pool->mutex);
+    return 0;
+}
+
+/*
+ * initWorkerPool
+ *
+ * Starts the worker threads. The thread calling workerPoolRun also executes
+ * jobs, so the pool only needs (cores - 1) threads.
+ *
+ * @param[out] pool Pool to initialize
+ * @param[in] threadCount Number of threads, or 0 to size from the CPU count
+ * @return bool True if at least the pool state was created
+ */
+bool initWorkerPool(WorkerPool* pool, int threadCount) {
+    if (pool->initialized) {
+        return true;
+    }
+
+    memset(pool, 0, sizeof(*pool));
+    if (threadCount <= 0) {
+        threadCount = SDL_GetCPUCount() - 1;
+    }
+    if (threadCount > WORKER_POOL_MAX_THREADS) {
+        threadCount = WORKER_POOL_MAX_THREADS;
+    }
+
+    pool->mutex = SDL_CreateMutex();
+    pool->runLock = SDL_CreateMutex();
+    pool->workReady = SDL_CreateCond();
+    pool->workDone = SDL_CreateCond();
+    if (!pool->mutex || !pool->runLock || !pool->workReady || !pool->workDone) {
+        fprintf(stderr, "Failed to create worker pool sync objects: %s\n", SDL_GetError());
+        cleanupWorkerPool(pool);
+        return false;
+    }
+    atomic_init(&pool->nextJob, 0);
+    atomic_init(&pool->jobsRemaining, 0);
+    pool->initialized = true;
+
+    for (int i = 0; i < threadCount; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "Worker%d", i);
+        pool->threads[i] = SDL_CreateThread(workerThreadMain, name, pool);
+        if (!pool->threads[i]) {
+            fprintf(stderr, "Failed to create worker thread %d: %s\n", i, SDL_GetError());
+            break;
+        }
+        pool->threadIds[i] = SDL_GetThreadID(pool->threads[i]);
+        pool->threadCount++;
+    }
+
+    printf("Worker pool initialized with %d threads\n", pool->threadCount);
+    return true;
+}
+
+/*
+ * workerPoolRun
+ *
+ * Runs job(context, i) for every i in [0, jobCount) and returns once all of
+ * them have finished. Falls back to running inline when the pool has no
+ * threads.
+ *
+ * @param[in,out] pool The worker pool
+ * @param[in] job Job function
+ * @param[in] context Opaque pointer passed to every job
+ * @param[in] jobCount Number of jobs
+ */
+void workerPoolRun(WorkerPool* pool, WorkerJobFn job, void* context, int jobCount) {
+    if (jobCount <= 0 || !job) return;
+
+    if (!pool || !pool->initialized || pool->threadCount == 0 || jobCount == 1) {
+        for (int i = 0; i < jobCount; i++) {
+            job(context, i);
+        }
+        return;
+    }
+
+    SDL_LockMutex(pool->runLock);
+
+    SDL_LockMutex(pool->mutex);
+    // Workers still finishing a previous run must not see the new counters
+    while (pool->activeWorkers > 0) {
+        SDL_CondWait(pool->workDone, pool->mutex);
+    }
+    pool->job = job;
+    pool->context = context;
+    pool->jobCount = jobCount;
+    atomic_store(&pool->nextJob, 0);
+    atomic_store(&pool->jobsRemaining, jobCount);
+    pool->generation++;
+    SDL_CondBroadcast(pool->workReady);
+    SDL_UnlockMutex(pool->mutex);
+
+    drainJobs(pool, job, context, jobCount);
+
+    SDL_LockMutex(pool->mutex);
+    while (atomic_load(&pool->jobsRemaining) > 0 || pool->activeWorkers > 0) {
+        SDL_CondWait(pool->workDone, pool->mutex);
+    }
+    SDL_UnlockMutex(pool->mutex);
+
+    SDL_UnlockMutex(pool->runLock);
+}
+
+int workerPoolSize(const WorkerPool* pool) {
+    return (pool && pool->initialized) ? pool->threadCount + 1 : 1;
+}
+
+/*
+ * workerPoolThreadIndex
+ *
+ * Identifies the calling thread, for jobs that keep per-thread statistics.
+ *
+ * @param[in] pool The worker pool
+ * @return int 0 to threadCount - 1 on a pool thread, threadCount on any
+ *             other thread (such as the one calling workerPoolRun)
+ */
+int workerPoolThreadIndex(const WorkerPool* pool) {
+    if (!pool || !pool->initialized) return 0;
+
+    SDL_threadID self = SDL_ThreadID();
+    for (int i = 0; i < pool->threadCount; i++) {
+        if (pool->threadIds[i] == self) return i;
+    }
+    return pool->threadCount;
+}
+
+void cleanupWorkerPool(WorkerPool* pool) {
+    if (!pool) return;
+
+    if (pool->mutex) {
+        SDL_LockMutex(pool->mutex);
+        pool->shuttingDown = true;
+        if (pool->workReady) {
+            SDL_CondBroadcast(pool->workReady);
+        }
+        SDL_UnlockMutex(pool->mutex);
+    }
+
+    for (int i = 0; i < pool->threadCount; i++) {
+        SDL_WaitThread(pool->threads[i], NULL);
+        pool->threads[i] = NULL;
+    }
+
+    if (pool->workReady) SDL_DestroyCond(pool->workReady);
+    if (pool->workDone) SDL_DestroyCond(pool->workDone);
+    if (pool->runLock) SDL_DestroyMutex(pool->runLock);
+    if (pool->mutex) SDL_DestroyMutex(pool->mutex);
+
+    memset(pool, 0, sizeof(*pool));
+    printf("Worker pool cleaned up\n");
+}
@@ -0,0 +1,40 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <SDL2/SDL.h>
+
+#define WORKER_POOL_MAX_THREADS 16
+
+// Called once per job index; jobs of one run may execute concurrently
+typedef void (*WorkerJobFn)(void* context, int jobIndex);
+
+typedef struct {
+    SDL_Thread* threads[WORKER_POOL_MAX_THREADS];
+    SDL_threadID threadIds[WORKER_POOL_MAX_THREADS];
+    int threadCount;
+    SDL_mutex* mutex;        // Guards the run description and counters below
+    SDL_cond* workReady;
+    SDL_cond* workDone;
+    SDL_mutex* runLock;      // Serializes callers of workerPoolRun
+    WorkerJobFn job;
+    void* context;
+    int jobCount;
+    atomic_int nextJob;
+    atomic_int jobsRemaining;
+    int activeWorkers;
+    unsigned int generation;
+    bool shuttingDown;
+    bool initialized;
+} WorkerPool;
+
+extern WorkerPool globalWorkerPool;
+
+bool initWorkerPool(WorkerPool* pool, int threadCount);
+void workerPoolRun(WorkerPool* pool, WorkerJobFn job, void* context, int jobCount);
+int workerPoolSize(const WorkerPool* pool);
+int workerPoolThreadIndex(const WorkerPool* pool);
+void cleanupWorkerPool(WorkerPool* pool);
+
+#endif // WORKER_POOL_H
@@ -0,0 +1,232 @@
+// world_commands.c
+
+#include "world_commands.h"
+#include <stdio.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "grid.h"
+#include "grid_edit.h"
+#include "gameloop.h"
+#include "player.h"
+#include "structures.h"
+#include "enemy_residency.h"
+
+_Static_assert((WORLD_COMMAND_CAPACITY & (WORLD_COMMAND_CAPACITY - 1)) == 0,
+               "WORLD_COMMAND_CAPACITY must be a power of two");
+
+#define COMMAND_INDEX_MASK (WORLD_COMMAND_CAPACITY - 1)
+
+// Bounded MPMC ring in the style of Vyukov's queue, used with a single
+// consumer. Each slot's sequence tells producers and the consumer whose
+// turn it is, so no locks are needed:
+//   sequence == pos       slot is free for the producer claiming pos
+//   sequence == pos + 1   slot holds the command for pos
+typedef struct {
+    atomic_size_t sequence;
+    WorldCommand command;
+} CommandSlot;
+
+static CommandSlot slots[WORLD_COMMAND_CAPACITY];
+static atomic_size_t enqueuePos;
+static size_t dequeuePos;  // Only touched by the applying thread
+static bool commandsInitialized = false;
+
+/*
+ * initWorldCommands
+ *
+ * Prepares the queue. Must run before any thread pushes commands; later
+ * calls are ignored.
+ */
+void initWorldCommands(void) {
+    if (commandsInitialized) return;
+
+    for (size_t i = 0; i < WORLD_COMMAND_CAPACITY; i++) {
+        atomic_init(&slots[i].sequence, i);
+    }
+    atomic_init(&enqueuePos, 0);
+    dequeuePos = 0;
+    commandsInitialized = true;
+}
+
+/*
+ * pushWorldCommand
+ *
+ * Enqueues a command. Safe to call from any thread.
+ *
+ * @param[in] command The command to copy into the queue
+ * @return bool False if the queue is full
+ */
+bool pushWorldCommand(const WorldCommand* command) {
+    size_t pos = atomic_load_explicit(&enqueuePos, memory_order_relaxed);
+    CommandSlot* slot;
+
+    for (;;) {
+        slot = &slots[pos & COMMAND_INDEX_MASK];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        ptrdiff_t diff = (ptrdiff_t)sequence - (ptrdiff_t)pos;
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&enqueuePos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            fprintf(stderr, "World command queue full, dropping command %d at (%d, %d)\n",
+                    command->type, command->x, command->y);
+            return false;
+        } else {
+            pos = atomic_load_explicit(&enqueuePos, memory_order_relaxed);
+        }
+    }
+
+    slot->command = *command;
+    atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+    return true;
+}
+
+static bool popWorldCommand(WorldCommand* out) {
+    CommandSlot* slot = &slots[dequeuePos & COMMAND_INDEX_MASK];
+    size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+
+    if (sequence != dequeuePos + 1) {
+        return false;
+    }
+
+    *out = slot->command;
+    atomic_store_explicit(&slot->sequence, dequeuePos + WORLD_COMMAND_CAPACITY, memory_order_release);
+    dequeuePos++;
+    return true;
+}
+
+/*
+ * resetWorldCommands
+ *
+ * Drops every queued command, for a world that is about to be replaced.
+ * Call on the applying thread or while it is paused.
+ *
+ * @return int Number of commands dropped
+ */
+int resetWorldCommands(void) {
+    WorldCommand command;
+    int dropped = 0;
+    while (popWorldCommand(&command)) {
+        dropped++;
+    }
+    return dropped;
+}
+
+// Walls next to a removed structure need their autotile recomputed
+static void retextureNeighbours(int gridX, int gridY) {
+    if (gridY > 0) updateWallTextures(gridX, gridY - 1);
+    if (gridY < GRID_SIZE - 1) updateWallTextures(gridX, gridY + 1);
+    if (gridX > 0) updateWallTextures(gridX - 1, gridY);
+    if (gridX < GRID_SIZE - 1) updateWallTextures(gridX + 1, gridY);
+}
+
+static void executeWorldCommand(const WorldCommand* command) {
+    switch (command->type) {
+        case WORLD_CMD_PLACE_STRUCTURE: {
+            bool placed = placeStructure((StructureType)command->arg, command->x, command->y, command->player);
+            printf("Structure placement %s at: %d, %d\n",
+                   placed ? "succeeded" : "failed", command->x, command->y);
+            break;
+        }
+
+        case WORLD_CMD_CLEAR_STRUCTURE:
+            gridBeginBatch();
+            if (gridClearStructure(command->x, command->y)) {
+                retextureNeighbours(command->x, command->y);
+            }
+            gridEndBatch();
+            break;
+
+        case WORLD_CMD_HARVEST:
+            if (command->player) {
+                harvestPlant(command->player, command->x, command->y);
+            }
+            break;
+
+        case WORLD_CMD_TOGGLE_DOOR:
+            if (command->player) {
+                toggleDoor(command->x, command->y, command->player);
+            }
+            break;
+
+        case WORLD_CMD_STREAM_CHUNKS:
+            if (globalChunkManager) {
+                loadChunksAroundPlayer(globalChunkManager);
+            }
+            break;
+
+        case WORLD_CMD_SPAWN_ENEMY:
+            if (spawnEnemy(command->x, command->y, MOVE_SPEED) == ENTITY_HANDLE_NONE) {
+                fprintf(stderr, "Failed to spawn enemy at: %d, %d\n", command->x, command->y);
+            }
+            break;
+
+        case WORLD_CMD_DESPAWN_ENEMY:
+            despawnEnemy((EntityHandle)(uint32_t)command->arg);
+            break;
+
+        default:
+            fprintf(stderr, "Unknown world command %d\n", command->type);
+            break;
+    }
+}
+
+/*
+ * applyWorldCommands
+ *
+ * Applies the commands queued so far, in order. Commands pushed while this
+ * runs wait for the next call. Must only be called from the physics thread
+ * (or before it starts).
+ *
+ * @return int Number of commands applied
+ */
+int applyWorldCommands(void) {
+    if (!commandsInitialized) return 0;
+
+    int applied = 0;
+    WorldCommand command;
+    while (applied < WORLD_COMMAND_CAPACITY && popWorldCommand(&command)) {
+        executeWorldCommand(&command);
+        applied++;
+    }
+    return applied;
+}
+
+bool queuePlaceStructure(StructureType type, int gridX, int gridY, struct Player* player) {
+    WorldCommand command = { WORLD_CMD_PLACE_STRUCTURE, gridX, gridY, (int)type, player };
+    return pushWorldCommand(&command);
+}
+
+bool queueClearStructure(int gridX, int gridY) {
+    WorldCommand command = { WORLD_CMD_CLEAR_STRUCTURE, gridX, gridY, 0, NULL };
+    return pushWorldCommand(&command);
+}
+
+bool queueHarvest(int gridX, int gridY, struct Player* player) {
+    WorldCommand command = { WORLD_CMD_HARVEST, gridX, gridY, 0, player };
+    return pushWorldCommand(&command);
+}
+
+bool queueToggleDoor(int gridX, int gridY, struct Player* player) {
+    WorldCommand command = { WORLD_CMD_TOGGLE_DOOR, gridX, gridY, 0, player };
+    return pushWorldCommand(&command);
+}
+
+bool queueStreamChunks(void) {
+    WorldCommand command = { WORLD_CMD_STREAM_CHUNKS, 0, 0, 0, NULL };
+    return pushWorldCommand(&command);
+}
+
+bool queueSpawnEnemy(int gridX, int gridY) {
+    WorldCommand command = { WORLD_CMD_SPAWN_ENEMY, gridX, gridY, 0, NULL };
+    return pushWorldCommand(&command);
+}
+
+// A stale handle (the enemy already despawned) is ignored when applied
+bool queueDespawnEnemy(uint32_t handle) {
+    WorldCommand command = { WORLD_CMD_DESPAWN_ENEMY, 0, 0, (int)handle, NULL };
+    return pushWorldCommand(&command);
+}
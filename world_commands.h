@@ -0,0 +1,58 @@
+#ifndef WORLD_COMMANDS_H
+#define WORLD_COMMANDS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "structure_types.h"
+
+// World edits are not applied where they are requested. Any thread pushes
+// a command into a bounded lock-free queue, and the physics thread applies
+// them all at the start of its tick via applyWorldCommands().
+//
+// What that guarantees:
+// - Grid cells are written only by the physics thread, while it runs a
+//   tick: commands, timers, chunk streaming and the other systems.
+// - No other thread reads grid[][] directly. The renderer and input read
+//   the copy published with each sim snapshot (renderFrame.world), which
+//   is at most one tick old; other threads use the atomic planes and
+//   gridChunkVersion().
+// - Saving and loading happen on the main thread between two ticks, with
+//   the physics thread held off (SaveGame, ReloadGame). ReloadGame drops
+//   the commands still queued (resetWorldCommands) before loading.
+
+#define WORLD_COMMAND_CAPACITY 256  // Must be a power of two
+
+struct Player;
+
+typedef enum {
+    WORLD_CMD_PLACE_STRUCTURE,
+    WORLD_CMD_CLEAR_STRUCTURE,
+    WORLD_CMD_HARVEST,
+    WORLD_CMD_TOGGLE_DOOR,
+    WORLD_CMD_STREAM_CHUNKS,
+    WORLD_CMD_SPAWN_ENEMY,
+    WORLD_CMD_DESPAWN_ENEMY
+} WorldCommandType;
+
+typedef struct {
+    WorldCommandType type;
+    int x, y;
+    int arg;                 // StructureType for WORLD_CMD_PLACE_STRUCTURE,
+                             // EntityHandle for WORLD_CMD_DESPAWN_ENEMY
+    struct Player* player;   // Acting player, if any
+} WorldCommand;
+
+void initWorldCommands(void);
+bool pushWorldCommand(const WorldCommand* command);
+int applyWorldCommands(void);
+int resetWorldCommands(void);
+
+bool queuePlaceStructure(StructureType type, int gridX, int gridY, struct Player* player);
+bool queueClearStructure(int gridX, int gridY);
+bool queueHarvest(int gridX, int gridY, struct Player* player);
+bool queueToggleDoor(int gridX, int gridY, struct Player* player);
+bool queueStreamChunks(void);
+bool queueSpawnEnemy(int gridX, int gridY);
+bool queueDespawnEnemy(uint32_t handle);
+
+#endif // WORLD_COMMANDS_H
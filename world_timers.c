@@ -0,0 +1,314 @@
+// world_timers.c
+#include "world_timers.h"
+#include <SDL2/SDL.h>
+#include "grid.h"
+#include "grid_edit.h"
+#include "gameloop.h"
+#include "structures.h"
+#include "enemy.h"
+
+extern Enemy enemies[MAX_ENEMIES];
+
+static TimerWheel wheel;
+static SDL_SpinLock wheelLock;  // Guards wheel and doorTimers
+static TimerHandle doorTimers[GRID_SIZE][GRID_SIZE];
+
+// Save record of one pending timer
+typedef struct {
+    uint8_t type;
+    uint8_t x, y;
+    uint32_t arg;
+    uint32_t remainingTicks;
+} SavedTimer;
+
+static uint32_t ticksFromMs(uint32_t ms) {
+    return (ms + PHYSICS_TICK_MS - 1) / PHYSICS_TICK_MS;
+}
+
+// Caller holds wheelLock
+static TimerHandle arm(int type, int x, int y, uint32_t arg, uint32_t ticks) {
+    TimerEvent event = { .type = type, .x = x, .y = y, .arg = arg };
+    bool door = type == WORLD_TIMER_DOOR_CLOSE && isValid(x, y);
+    if (door) {
+        // A door has at most one pending close
+        timerCancel(&wheel, doorTimers[y][x]);
+    }
+    TimerHandle handle = timerSchedule(&wheel, &event, ticks);
+    if (door) {
+        doorTimers[y][x] = handle;
+    }
+    return handle;
+}
+
+static bool isSaved(const Timer* timer) {
+    return timer->armed && timer->event.type != WORLD_TIMER_ENEMY_WAKE;
+}
+
+static bool tileFree(int x, int y) {
+    return !isEntityTargetingTile(x, y);
+}
+
+static void regrowPlant(const TimerEvent* event) {
+    int x = event->x, y = event->y;
+    const GridCell* cell = &grid[y][x];
+    if (cell->structureType != STRUCTURE_NONE || cell->terrainType != TERRAIN_GRASS) {
+        return;  // Built over, or the chunk was unloaded and keeps its own state
+    }
+    if (!tileFree(x, y)) {
+        arm(event->type, x, y, event->arg, ticksFromMs(WORLD_TIMER_RETRY_MS));
+        return;
+    }
+
+    gridBeginBatch();
+    gridSetStructure(x, y, STRUCTURE_PLANT, (uint8_t)event->arg);
+    gridSetWalkable(x, y, false);
+    gridEndBatch();
+}
+
+static void closeDoor(const TimerEvent* event) {
+    int x = event->x, y = event->y;
+    doorTimers[y][x] = TIMER_HANDLE_NONE;
+    if (grid[y][x].structureType != STRUCTURE_DOOR || !GRIDCELL_IS_WALKABLE(grid[y][x])) {
+        return;  // Removed or already closed
+    }
+    if (!tileFree(x, y)) {
+        arm(event->type, x, y, event->arg, ticksFromMs(WORLD_TIMER_RETRY_MS));
+        return;
+    }
+    setDoorOpen(x, y, false);
+}
+
+static void wakeEnemy(const TimerEvent* event) {
+    int id = entityPoolResolve(event->arg);
+    if (id <= PLAYER_ENTITY_ID) return;  // Despawned while resting
+
+    Enemy* enemy = &enemies[id - 1];
+    enemy->wakeTimer = TIMER_HANDLE_NONE;
+    if (enemy->rest == ENEMY_RESTING) {
+        enemy->rest = ENEMY_WOKEN;
+    }
+}
+
+static void fireWorldTimer(const TimerEvent* event, void* context) {
+    (void)context;
+    switch (event->type) {
+        case WORLD_TIMER_PLANT_REGROW:
+            if (isValid(event->x, event->y)) regrowPlant(event);
+            break;
+        case WORLD_TIMER_DOOR_CLOSE:
+            if (isValid(event->x, event->y)) closeDoor(event);
+            break;
+        case WORLD_TIMER_ENEMY_WAKE:
+            wakeEnemy(event);
+            break;
+        default:
+            fprintf(stderr, "Unknown world timer type %d\n", event->type);
+            break;
+    }
+}
+
+/*
+ * resetWorldTimers
+ *
+ * Drops every pending timer, for a new or loaded game.
+ */
+void resetWorldTimers(void) {
+    SDL_AtomicLock(&wheelLock);
+    initTimerWheel(&wheel);
+    for (int y = 0; y < GRID_SIZE; y++) {
+        for (int x = 0; x < GRID_SIZE; x++) {
+            doorTimers[y][x] = TIMER_HANDLE_NONE;
+        }
+    }
+    SDL_AtomicUnlock(&wheelLock);
+}
+
+/*
+ * clearWorldTimers
+ *
+ * Drops the pending plant and door timers, the ones that are saved, and
+ * keeps enemy wake-ups. Called when a save replaces the world.
+ */
+void clearWorldTimers(void) {
+    SDL_AtomicLock(&wheelLock);
+    for (int i = 0; i < TIMER_CAPACITY; i++) {
+        if (isSaved(&wheel.timers[i])) {
+            timerCancel(&wheel, timerHandleAt(&wheel, i));
+        }
+    }
+    for (int y = 0; y < GRID_SIZE; y++) {
+        for (int x = 0; x < GRID_SIZE; x++) {
+            doorTimers[y][x] = TIMER_HANDLE_NONE;
+        }
+    }
+    SDL_AtomicUnlock(&wheelLock);
+}
+
+/*
+ * advanceWorldTimers
+ *
+ * Advances the wheel by one physics tick and handles the events due.
+ * Physics thread only.
+ */
+void advanceWorldTimers(void) {
+    SDL_AtomicLock(&wheelLock);
+    timerAdvance(&wheel, fireWorldTimer, NULL);
+    SDL_AtomicUnlock(&wheelLock);
+}
+
+/*
+ * schedulePlantRegrowth
+ *
+ * Grows a plant back on a tile after a delay, if the tile is still empty
+ * grass by then. Waits for entities on or heading to the tile to leave.
+ *
+ * @param[in] gridX Tile column
+ * @param[in] gridY Tile row
+ * @param[in] materialType Plant to grow
+ * @param[in] delayMs Delay in milliseconds
+ * @return TimerHandle The timer, or TIMER_HANDLE_NONE if none is left
+ */
+TimerHandle schedulePlantRegrowth(int gridX, int gridY, int materialType, uint32_t delayMs) {
+    if (!isValid(gridX, gridY)) return TIMER_HANDLE_NONE;
+
+    SDL_AtomicLock(&wheelLock);
+    TimerHandle handle = arm(WORLD_TIMER_PLANT_REGROW, gridX, gridY, (uint32_t)materialType,
+                             ticksFromMs(delayMs));
+    SDL_AtomicUnlock(&wheelLock);
+    return handle;
+}
+
+/*
+ * scheduleDoorClose
+ *
+ * Closes an open door after a delay, replacing the door's pending close if
+ * it has one. A door with someone in its way waits for them.
+ *
+ * @param[in] gridX Door column
+ * @param[in] gridY Door row
+ * @param[in] delayMs Delay in milliseconds
+ * @return TimerHandle The timer, or TIMER_HANDLE_NONE if none is left
+ */
+TimerHandle scheduleDoorClose(int gridX, int gridY, uint32_t delayMs) {
+    if (!isValid(gridX, gridY)) return TIMER_HANDLE_NONE;
+
+    SDL_AtomicLock(&wheelLock);
+    TimerHandle handle = arm(WORLD_TIMER_DOOR_CLOSE, gridX, gridY, 0, ticksFromMs(delayMs));
+    SDL_AtomicUnlock(&wheelLock);
+    return handle;
+}
+
+void cancelDoorClose(int gridX, int gridY) {
+    if (!isValid(gridX, gridY)) return;
+
+    SDL_AtomicLock(&wheelLock);
+    timerCancel(&wheel, doorTimers[gridY][gridX]);
+    doorTimers[gridY][gridX] = TIMER_HANDLE_NONE;
+    SDL_AtomicUnlock(&wheelLock);
+}
+
+/*
+ * scheduleEnemyWake
+ *
+ * Ends an enemy's rest after a delay (see MovementAI). The timer goes
+ * quiet if the enemy is despawned first.
+ *
+ * @param[in] enemy Handle of the resting enemy
+ * @param[in] delayMs Delay in milliseconds
+ * @return TimerHandle The timer, or TIMER_HANDLE_NONE if none is left
+ */
+TimerHandle scheduleEnemyWake(EntityHandle enemy, uint32_t delayMs) {
+    SDL_AtomicLock(&wheelLock);
+    TimerHandle handle = arm(WORLD_TIMER_ENEMY_WAKE, 0, 0, enemy, ticksFromMs(delayMs));
+    SDL_AtomicUnlock(&wheelLock);
+    return handle;
+}
+
+bool cancelWorldTimer(TimerHandle handle) {
+    SDL_AtomicLock(&wheelLock);
+    bool cancelled = timerCancel(&wheel, handle);
+    SDL_AtomicUnlock(&wheelLock);
+    return cancelled;
+}
+
+/*
+ * writeWorldTimers
+ *
+ * Writes the pending plant and door timers, with the ticks each has left.
+ *
+ * @param[in] file Save file, positioned at the timer section
+ * @return bool False on a write error
+ */
+bool writeWorldTimers(FILE* file) {
+    SDL_AtomicLock(&wheelLock);
+    uint32_t count = 0;
+    for (int i = 0; i < TIMER_CAPACITY; i++) {
+        count += isSaved(&wheel.timers[i]);
+    }
+
+    bool ok = fwrite(&count, sizeof(count), 1, file) == 1;
+    for (int i = 0; ok && i < TIMER_CAPACITY; i++) {
+        const Timer* timer = &wheel.timers[i];
+        if (!isSaved(timer)) continue;
+
+        SavedTimer saved = {
+            .type = (uint8_t)timer->event.type,
+            .x = (uint8_t)timer->event.x,
+            .y = (uint8_t)timer->event.y,
+            .arg = timer->event.arg,
+            .remainingTicks = timerRemaining(&wheel, i)
+        };
+        ok = fwrite(&saved.type, sizeof(saved.type), 1, file) == 1 &&
+             fwrite(&saved.x, sizeof(saved.x), 1, file) == 1 &&
+             fwrite(&saved.y, sizeof(saved.y), 1, file) == 1 &&
+             fwrite(&saved.arg, sizeof(saved.arg), 1, file) == 1 &&
+             fwrite(&saved.remainingTicks, sizeof(saved.remainingTicks), 1, file) == 1;
+    }
+    SDL_AtomicUnlock(&wheelLock);
+
+    if (!ok) {
+        fprintf(stderr, "Failed to write world timers\n");
+    }
+    return ok;
+}
+
+/*
+ * readWorldTimers
+ *
+ * Re-arms the timers written by writeWorldTimers. Call after
+ * clearWorldTimers (or resetWorldTimers) and after the grid is loaded.
+ *
+ * @param[in] file Save file, positioned at the timer section
+ * @return bool False if the section is truncated or malformed
+ */
+bool readWorldTimers(FILE* file) {
+    uint32_t count;
+    if (fread(&count, sizeof(count), 1, file) != 1) {
+        fprintf(stderr, "Failed to read world timer count\n");
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        SavedTimer saved;
+        if (fread(&saved.type, sizeof(saved.type), 1, file) != 1 ||
+            fread(&saved.x, sizeof(saved.x), 1, file) != 1 ||
+            fread(&saved.y, sizeof(saved.y), 1, file) != 1 ||
+            fread(&saved.arg, sizeof(saved.arg), 1, file) != 1 ||
+            fread(&saved.remainingTicks, sizeof(saved.remainingTicks), 1, file) != 1) {
+            fprintf(stderr, "World timer section is truncated at timer %u of %u\n", i, count);
+            return false;
+        }
+        if (saved.type == WORLD_TIMER_ENEMY_WAKE || saved.type >= WORLD_TIMER_TYPE_COUNT ||
+            !isValid(saved.x, saved.y)) {
+            fprintf(stderr, "Skipping invalid saved timer (type %u at %u, %u)\n",
+                    saved.type, saved.x, saved.y);
+            continue;
+        }
+
+        SDL_AtomicLock(&wheelLock);
+        arm(saved.type, saved.x, saved.y, saved.arg, saved.remainingTicks);
+        SDL_AtomicUnlock(&wheelLock);
+    }
+    printf("Loaded %u world timers\n", count);
+    return true;
+}
@@ -0,0 +1,48 @@
+#ifndef WORLD_TIMERS_H
+#define WORLD_TIMERS_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include "timer_wheel.h"
+#include "entity_pool.h"
+
+// Deferred world and entity events on one timer wheel, advanced by the
+// physics thread once per physics tick (the "timers" system), so events
+// fire between world commands and the simulation and may edit the grid.
+// Instead of checking every tick whether something is due, a system
+// schedules an event and forgets about it until it fires.
+//
+// Plant and door timers are part of the world and go into saves. Enemy
+// wake-ups are not: enemies are spawned afresh on load.
+//
+// Scheduling and cancelling are meant for the physics thread; the lock
+// only keeps saveGameState, on the main thread, from reading the wheel
+// while it changes.
+
+#define PLANT_REGROW_MS 60000      // Harvested fern grows back
+#define DOOR_CLOSE_MS 5000         // Opened door swings shut
+#define WORLD_TIMER_RETRY_MS 500   // Event found its tile taken, try again
+#define ENEMY_REST_MIN_MS 32       // Idle time between an enemy's goals
+#define ENEMY_REST_SPREAD_MS 256
+
+typedef enum {
+    WORLD_TIMER_PLANT_REGROW,  // arg: MaterialType of the plant
+    WORLD_TIMER_DOOR_CLOSE,
+    WORLD_TIMER_ENEMY_WAKE,    // arg: EntityHandle of the enemy
+    WORLD_TIMER_TYPE_COUNT
+} WorldTimerType;
+
+void resetWorldTimers(void);
+void clearWorldTimers(void);
+void advanceWorldTimers(void);
+
+TimerHandle schedulePlantRegrowth(int gridX, int gridY, int materialType, uint32_t delayMs);
+TimerHandle scheduleDoorClose(int gridX, int gridY, uint32_t delayMs);
+void cancelDoorClose(int gridX, int gridY);
+TimerHandle scheduleEnemyWake(EntityHandle enemy, uint32_t delayMs);
+bool cancelWorldTimer(TimerHandle handle);
+
+bool writeWorldTimers(FILE* file);
+bool readWorldTimers(FILE* file);
+
+#endif // WORLD_TIMERS_H